@@ -20,11 +20,13 @@
 
 #include "network/Network.h"
 #include "threads/SystemClock.h"
+#include "threads/ThreadRoles.h"
 #include "system.h"
 #include "Application.h"
 #include "events/EventLog.h"
 #include "events/NotificationEvent.h"
 #include "interfaces/builtins/Builtins.h"
+#include "utils/InitGraph.h"
 #include "utils/JobManager.h"
 #include "utils/Variant.h"
 #include "utils/Splash.h"
@@ -44,6 +46,7 @@
 #include "video/Bookmark.h"
 #include "video/VideoLibraryQueue.h"
 #include "guilib/GUIControlProfiler.h"
+#include "guilib/GUIFrameProfiler.h"
 #include "utils/LangCodeExpander.h"
 #include "GUIInfoManager.h"
 #include "playlists/PlayListFactory.h"
@@ -1029,6 +1032,9 @@ void CApplication::CreateUserDirs() const
 
 bool CApplication::Initialize()
 {
+  // the application thread renders the GUI and the video
+  XbmcThreads::CThreadRoles::Enter(XbmcThreads::ThreadRole::RENDER);
+
 #if defined(HAS_DVD_DRIVE) && !defined(TARGET_WINDOWS) // somehow this throws an "unresolved external symbol" on win32
   // turn off cdio logging
   cdio_loglevel_default = CDIO_LOG_ERROR;
@@ -1052,8 +1058,6 @@ bool CApplication::Initialize()
     StringUtils::Format(g_localizeStrings.Get(178).c_str(), g_sysinfo.GetAppName().c_str()),
     "special://xbmc/media/icon256x256.png", EventLevel::Basic)));
 
-  getNetwork().WaitForNet();
-
   // Load curl so curl_global_init gets called before any service threads
   // are started. Unloading will have no effect as curl is never fully unloaded.
   // To quote man curl_global_init:
@@ -1066,12 +1070,30 @@ bool CApplication::Initialize()
   g_curlInterface.Load();
   g_curlInterface.Unload();
 
-  // initialize (and update as needed) our databases
-  CEvent event(true);
-  CJobManager::GetInstance().Submit([&event]() {
+  // initialize (and update as needed) our databases while waiting for the
+  // network, unless a database is on another host
+  bool remoteDatabases = false;
+  for (const DatabaseSettings *settings : { &g_advancedSettings.m_databaseMusic, &g_advancedSettings.m_databaseVideo,
+                                            &g_advancedSettings.m_databaseTV, &g_advancedSettings.m_databaseEpg,
+                                            &g_advancedSettings.m_databaseADSP })
+    remoteDatabases |= settings->type == "mysql";
+
+  KODI::UTILS::CInitGraph startup("startup");
+  startup.Add("network", [this]() {
+    getNetwork().WaitForNet();
+    return true;
+  });
+  startup.Add("databases", []() {
     CDatabaseManager::GetInstance().Initialize();
+    return true;
+  }, remoteDatabases ? std::vector<std::string>{ "network" } : std::vector<std::string>());
+
+  CEvent event(true);
+  // the splash screen waits for this, keep it out of the background role of low priority jobs
+  CJobManager::GetInstance().Submit([&event, &startup]() {
+    startup.Run();
     event.Set();
-  });
+  }, CJob::PRIORITY_HIGH);
   std::string localizedStr = g_localizeStrings.Get(24150);
   int iDots = 1;
   while (!event.WaitMSec(1000))
@@ -1858,6 +1880,8 @@ void CApplication::Render()
   if (m_bStop)
     return;
 
+  CGUIFrameProfilerScope profile("CApplication::Render");
+
   bool hasRendered = false;
 
   // Whether externalplayer is playing and we're unfocused
@@ -1899,12 +1923,15 @@ void CApplication::Render()
   // render video layer
   g_windowManager.RenderEx();
 
+  // upload the images loaded in the background, they are shown from the next frame
+  g_largeTextureManager.UploadImages();
+
   g_Windowing.EndRender();
 
-  // reset our info cache - we do this at the end of Render so that it is
-  // fresh for the next process(), or after a windowclose animation (where process()
-  // isn't called)
-  g_infoManager.ResetCache();
+  // mark the info cache dirty where its sources changed - we do this at the end of
+  // Render so that it is fresh for the next process(), or after a windowclose
+  // animation (where process() isn't called)
+  g_infoManager.NewFrame();
 
   if (hasRendered)
   {
@@ -2341,6 +2368,8 @@ bool CApplication::OnAction(const CAction &action)
   {
     CGUIControlProfiler::Instance().SetOutputFile(CSpecialProtocol::TranslatePath("special://home/guiprofiler.xml"));
     CGUIControlProfiler::Instance().Start();
+    CGUIFrameProfiler::GetInstance().SetMaxFrameCount(CGUIControlProfiler::Instance().GetMaxFrameCount());
+    CGUIFrameProfiler::GetInstance().Start(CSpecialProtocol::TranslatePath("special://home/guiprofiler.json"));
     return true;
   }
   if (action.GetID() == ACTION_SHOW_PLAYLIST)
@@ -2667,6 +2696,10 @@ void CApplication::FrameMove(bool processEvents, bool processGUI)
 {
   MEASURE_FUNCTION;
 
+  // a frame starts with FrameMove(), followed by Render()
+  CGUIFrameProfiler::GetInstance().EndFrame();
+  CGUIFrameProfilerScope profile("CApplication::FrameMove");
+
   if (processEvents)
   {
     // currently we calculate the repeat time (ie time from last similar keypress) just global as fps
@@ -23,12 +23,14 @@
 #include "cores/IPlayer.h"
 #include "cores/playercorefactory/PlayerCoreFactory.h"
 #include "cores/DataCacheCore.h"
+#include "guilib/GUITexture.h"
 #include "guilib/GUIWindowManager.h"
 #include "cores/DataCacheCore.h"
 #include "Application.h"
 #include "PlayListPlayer.h"
 #include "ServiceBroker.h"
 #include "settings/MediaSettings.h"
+#include "windowing/WindowingFactory.h"
 
 CApplicationPlayer::CApplicationPlayer()
 {
@@ -810,9 +812,15 @@ void CApplicationPlayer::FrameMove()
 
 void CApplicationPlayer::Render(bool clear, uint32_t alpha, bool gui)
 {
+  // the video is drawn outside the render system, draw the batched GUI below it first
+  CGUITexture::Flush();
+
   std::shared_ptr<IPlayer> player = GetInternal();
   if (player)
     player->Render(clear, alpha, gui);
+
+  // the players bind their textures and set blending directly
+  g_Windowing.ResetGUIState();
 }
 
 void CApplicationPlayer::FlushRenderer()
@@ -19,6 +19,7 @@
  */
 
 #include "DatabaseManager.h"
+#include "dbwrappers/sqlitedataset.h"
 #include "utils/log.h"
 #include "addons/AddonDatabase.h"
 #include "view/ViewDatabase.h"
@@ -29,8 +30,14 @@
 #include "pvr/epg/EpgDatabase.h"
 #include "games/addons/savestates/SavestateDatabase.h"
 #include "settings/AdvancedSettings.h"
+#include "utils/InitGraph.h"
 #include "cores/AudioEngine/Engines/ActiveAE/AudioDSPAddons/ActiveAEDSP.h"
 
+#include "system.h"
+#ifdef HAS_MYSQL
+#include "dbwrappers/mysqldataset.h"
+#endif
+
 using namespace PVR;
 using namespace ActiveAE;
 
@@ -54,23 +61,35 @@ void CDatabaseManager::Initialize(bool addonsOnly)
     return;
   CLog::Log(LOGDEBUG, "%s, updating databases...", __FUNCTION__);
 
-  // NOTE: Order here is important. In particular, CTextureDatabase has to be updated
-  //       before CVideoDatabase.
-  { CViewDatabase db; UpdateDatabase(db); }
-  { CTextureDatabase db; UpdateDatabase(db); }
-  { CMusicDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseMusic); }
-  { CVideoDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseVideo); }
-  { CPVRDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseTV); }
-  { CPVREpgDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseEpg); }
-  { CActiveAEDSPDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseADSP); }
+  // the databases are independent and updated in parallel, a failed update
+  // only marks that database as unusable
+  // NOTE: CTextureDatabase has to be updated before CVideoDatabase.
+#ifdef HAS_MYSQL
+  dbiplus::MysqlDatabase::InitLibrary();
+#endif
+  KODI::UTILS::CInitGraph databases("databases");
+  databases.Add("view", [this]() { CViewDatabase db; UpdateDatabase(db); return true; });
+  databases.Add("texture", [this]() { CTextureDatabase db; UpdateDatabase(db); return true; });
+  databases.Add("music", [this]() { CMusicDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseMusic); return true; });
+  databases.Add("video", [this]() { CVideoDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseVideo); return true; }, { "texture" });
+  databases.Add("tv", [this]() { CPVRDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseTV); return true; });
+  databases.Add("epg", [this]() { CPVREpgDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseEpg); return true; });
+  databases.Add("adsp", [this]() { CActiveAEDSPDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseADSP); return true; });
+  databases.Run();
   CLog::Log(LOGDEBUG, "%s, updating databases... DONE", __FUNCTION__);
   m_bIsUpgrading = false;
 }
 
 void CDatabaseManager::Deinitialize()
 {
-  CSingleLock lock(m_section);
-  m_dbStatus.clear();
+  {
+    CSingleLock lock(m_section);
+    m_dbStatus.clear();
+  }
+
+  // databases may be updated or replaced, don't hand out old connections
+  CSingleLock lock(m_connectionSection);
+  m_connections.clear();
 }
 
 bool CDatabaseManager::CanOpen(const std::string &name)
@@ -82,6 +101,43 @@ bool CDatabaseManager::CanOpen(const std::string &name)
   return false; // db isn't even attempted to update yet
 }
 
+std::unique_ptr<dbiplus::Database> CDatabaseManager::AcquireConnection(const std::string &key)
+{
+  CSingleLock lock(m_connectionSection);
+  auto it = m_connections.find(key);
+  if (it == m_connections.end() || it->second.empty())
+    return std::unique_ptr<dbiplus::Database>();
+
+  std::unique_ptr<dbiplus::Database> connection = std::move(it->second.back());
+  it->second.pop_back();
+  return connection;
+}
+
+void CDatabaseManager::ReleaseConnection(const std::string &key, std::unique_ptr<dbiplus::Database> connection)
+{
+  if (!connection || connection->in_transaction())
+    return;
+
+  CSingleLock lock(m_connectionSection);
+  std::vector<std::unique_ptr<dbiplus::Database>> &connections = m_connections[key];
+  if (connections.size() < static_cast<size_t>(g_advancedSettings.m_iSqliteConnectionPool))
+    connections.push_back(std::move(connection));
+  else
+  {
+    // close the connection outside of our lock
+    lock.Leave();
+    connection.reset();
+  }
+}
+
+void CDatabaseManager::GetLockWaits(unsigned int &waits, unsigned int &waitTime, unsigned int &maxWait) const
+{
+  dbiplus::sqlite_lock_stats stats = dbiplus::SqliteDatabase::getLockStats();
+  waits = stats.waits;
+  waitTime = stats.wait_time;
+  maxWait = stats.max_wait;
+}
+
 void CDatabaseManager::UpdateDatabase(CDatabase &db, DatabaseSettings *settings)
 {
   std::string name = db.GetBaseDBName();
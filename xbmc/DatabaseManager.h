@@ -22,12 +22,19 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 #include "threads/CriticalSection.h"
 
 class CDatabase;
 class DatabaseSettings;
 
+namespace dbiplus
+{
+  class Database;
+}
+
 /*!
  \ingroup database
  \brief Database manager class for handling database updating
@@ -64,6 +71,35 @@ public:
    \return true if the database can be opened, false otherwise.
    */ 
   bool CanOpen(const std::string &name);
+
+  /*! \brief Take an idle connection to a database out of the pool.
+
+   Only used for sqlite databases, opening those is comparatively expensive
+   (the schema has to be parsed for every new connection) and in WAL mode any
+   number of connections can read concurrently while one of them writes.
+
+   \param key identifies the database file the connection is opened on.
+   \return an open connection, or an empty pointer if no idle connection is available.
+   \sa ReleaseConnection
+   */
+  std::unique_ptr<dbiplus::Database> AcquireConnection(const std::string &key);
+
+  /*! \brief Return a connection that is no longer used to the pool.
+
+   The connection is closed if the pool of the database is full already.
+   \param key identifies the database file the connection is opened on.
+   \param connection the open connection, must not be in a transaction.
+   \sa AcquireConnection
+   */
+  void ReleaseConnection(const std::string &key, std::unique_ptr<dbiplus::Database> connection);
+
+  /*! \brief Get statistics about the time sqlite connections had to wait for database locks.
+   \param waits [out] the number of times a statement had to wait for a lock.
+   \param waitTime [out] the total time spent waiting in ms.
+   \param maxWait [out] the longest single wait in ms.
+   */
+  void GetLockWaits(unsigned int &waits, unsigned int &waitTime, unsigned int &maxWait) const;
+
   std::atomic<bool> m_bIsUpgrading;
 
 private:
@@ -81,4 +117,7 @@ private:
 
   CCriticalSection            m_section;     ///< Critical section protecting m_dbStatus.
   std::map<std::string, DB_STATUS> m_dbStatus;    ///< Our database status map.
+
+  CCriticalSection m_connectionSection; ///< Critical section protecting m_connections.
+  std::map<std::string, std::vector<std::unique_ptr<dbiplus::Database>>> m_connections; ///< Idle connections per database file.
 };
@@ -64,10 +64,13 @@
 #include "utils/log.h"
 #include "utils/Variant.h"
 #include "utils/Mime.h"
+#include "utils/ParallelAlgorithms.h"
 #include "utils/Random.h"
 #include "events/IEvent.h"
 
 #include <algorithm>
+#include <atomic>
+#include <set>
 
 using namespace KODI;
 using namespace XFILE;
@@ -76,6 +79,13 @@ using namespace MUSIC_INFO;
 using namespace PVR;
 using namespace GAME;
 
+// number of items each job converts to/from sortable items at once
+static const size_t SORT_GRAIN_SIZE = 512;
+// checking folders and parsing cue sheets is I/O bound, but not worth taking
+// workers from the thumbnail loaders for a handful of items
+static const size_t IO_PARALLEL_THRESHOLD = 64;
+static const size_t IO_GRAIN_SIZE = 8;
+
 CFileItem::CFileItem(const CSong& song)
 {
   Initialize();
@@ -2188,7 +2198,7 @@ void CFileItemList::Reserve(int iCount)
 void CFileItemList::Sort(FILEITEMLISTCOMPARISONFUNC func)
 {
   CSingleLock lock(m_lock);
-  std::stable_sort(m_items.begin(), m_items.end(), func);
+  KODI::UTILS::ParallelStableSort(m_items.begin(), m_items.end(), func);
 }
 
 void CFileItemList::FillSortFields(FILEITEMFILLFUNC func)
@@ -2235,27 +2245,33 @@ void CFileItemList::Sort(SortDescription sortDescription)
 
   const Fields fields = SortUtils::GetFieldsForSorting(sortDescription.sortBy);
   SortItems sortItems((size_t)Size());
-  for (int index = 0; index < Size(); index++)
+  KODI::UTILS::ParallelFor(sortItems.size(), SORT_GRAIN_SIZE, [&](size_t begin, size_t end)
   {
-    sortItems[index] = std::shared_ptr<SortItem>(new SortItem);
-    m_items[index]->ToSortable(*sortItems[index], fields);
-    (*sortItems[index])[FieldId] = index;
-  }
+    for (size_t index = begin; index < end; index++)
+    {
+      sortItems[index] = std::shared_ptr<SortItem>(new SortItem);
+      m_items[index]->ToSortable(*sortItems[index], fields);
+      (*sortItems[index])[FieldId] = static_cast<int>(index);
+    }
+  });
 
   // do the sorting
   SortUtils::Sort(sortDescription, sortItems);
 
   // apply the new order to the existing CFileItems
-  VECFILEITEMS sortedFileItems;
-  sortedFileItems.reserve(Size());
-  for (SortItems::const_iterator it = sortItems.begin(); it != sortItems.end(); it++)
+  VECFILEITEMS sortedFileItems(sortItems.size());
+  KODI::UTILS::ParallelFor(sortItems.size(), SORT_GRAIN_SIZE, [&](size_t begin, size_t end)
   {
-    CFileItemPtr item = m_items[(int)(*it)->at(FieldId).asInteger()];
-    // Set the sort label in the CFileItem
-    item->SetSortLabel((*it)->at(FieldSort).asWideString());
+    for (size_t index = begin; index < end; index++)
+    {
+      const SortItemPtr &sortItem = sortItems[index];
+      CFileItemPtr item = m_items[(int)sortItem->at(FieldId).asInteger()];
+      // Set the sort label in the CFileItem
+      item->SetSortLabel(sortItem->at(FieldSort).asWideString());
 
-    sortedFileItems.push_back(item);
-  }
+      sortedFileItems[index] = item;
+    }
+  });
 
   // replace the current list with the re-ordered one
   m_items = std::move(sortedFileItems);
@@ -2458,90 +2474,98 @@ void CFileItemList::FilterCueItems()
 {
   CSingleLock lock(m_lock);
   // Handle .CUE sheet files...
-  std::vector<std::string> itemstodelete;
-  for (int i = 0; i < (int)m_items.size(); i++)
+  std::vector<CFileItemPtr> cueItems;
+  for (const auto& item : m_items)
   {
-    CFileItemPtr pItem = m_items[i];
-    if (!pItem->m_bIsFolder)
-    { // see if it's a .CUE sheet
-      if (pItem->IsCUESheet())
+    if (!item->m_bIsFolder && item->IsCUESheet())
+      cueItems.push_back(item);
+  }
+  if (cueItems.empty())
+    return;
+
+  // parsing the cue sheets is I/O bound, so do it in parallel
+  std::vector<CCueDocumentPtr> cuesheets(cueItems.size());
+  KODI::UTILS::ParallelFor(cueItems.size(), IO_GRAIN_SIZE, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; i++)
+    {
+      CCueDocumentPtr cuesheet(new CCueDocument);
+      if (cuesheet->ParseFile(cueItems[i]->GetPath()))
+        cuesheets[i] = cuesheet;
+    }
+  }, IO_PARALLEL_THRESHOLD);
+
+  std::set<const CFileItem*> itemstodelete;
+  for (size_t i = 0; i < cueItems.size(); i++)
+  {
+    CFileItemPtr pItem = cueItems[i];
+    CCueDocumentPtr cuesheet = cuesheets[i];
+    if (cuesheet)
+    {
+      std::vector<std::string> MediaFileVec;
+      cuesheet->GetMediaFiles(MediaFileVec);
+
+      // queue the cue sheet and the underlying media file for deletion
+      for(std::vector<std::string>::iterator itMedia = MediaFileVec.begin(); itMedia != MediaFileVec.end(); itMedia++)
       {
-        CCueDocumentPtr cuesheet(new CCueDocument);
-        if (cuesheet->ParseFile(pItem->GetPath()))
+        std::string strMediaFile = *itMedia;
+        std::string fileFromCue = strMediaFile; // save the file from the cue we're matching against,
+                                               // as we're going to search for others here...
+        bool bFoundMediaFile = CFile::Exists(strMediaFile);
+        if (!bFoundMediaFile)
         {
-          std::vector<std::string> MediaFileVec;
-          cuesheet->GetMediaFiles(MediaFileVec);
-
-          // queue the cue sheet and the underlying media file for deletion
-          for(std::vector<std::string>::iterator itMedia = MediaFileVec.begin(); itMedia != MediaFileVec.end(); itMedia++)
+          // try file in same dir, not matching case...
+          if (Contains(strMediaFile))
+          {
+            bFoundMediaFile = true;
+          }
+          else
           {
-            std::string strMediaFile = *itMedia;
-            std::string fileFromCue = strMediaFile; // save the file from the cue we're matching against,
-                                                   // as we're going to search for others here...
-            bool bFoundMediaFile = CFile::Exists(strMediaFile);
-            if (!bFoundMediaFile)
+            // try removing the .cue extension...
+            strMediaFile = pItem->GetPath();
+            URIUtils::RemoveExtension(strMediaFile);
+            CFileItem item(strMediaFile, false);
+            if (item.IsAudio() && Contains(strMediaFile))
             {
-              // try file in same dir, not matching case...
-              if (Contains(strMediaFile))
-              {
-                bFoundMediaFile = true;
-              }
-              else
+              bFoundMediaFile = true;
+            }
+            else
+            { // try replacing the extension with one of our allowed ones.
+              std::vector<std::string> extensions = StringUtils::Split(CServiceBroker::GetFileExtensionProvider().GetMusicExtensions(), "|");
+              for (std::vector<std::string>::const_iterator i = extensions.begin(); i != extensions.end(); ++i)
               {
-                // try removing the .cue extension...
-                strMediaFile = pItem->GetPath();
-                URIUtils::RemoveExtension(strMediaFile);
+                strMediaFile = URIUtils::ReplaceExtension(pItem->GetPath(), *i);
                 CFileItem item(strMediaFile, false);
-                if (item.IsAudio() && Contains(strMediaFile))
+                if (!item.IsCUESheet() && !item.IsPlayList() && Contains(strMediaFile))
                 {
                   bFoundMediaFile = true;
+                  break;
                 }
-                else
-                { // try replacing the extension with one of our allowed ones.
-                  std::vector<std::string> extensions = StringUtils::Split(CServiceBroker::GetFileExtensionProvider().GetMusicExtensions(), "|");
-                  for (std::vector<std::string>::const_iterator i = extensions.begin(); i != extensions.end(); ++i)
-                  {
-                    strMediaFile = URIUtils::ReplaceExtension(pItem->GetPath(), *i);
-                    CFileItem item(strMediaFile, false);
-                    if (!item.IsCUESheet() && !item.IsPlayList() && Contains(strMediaFile))
-                    {
-                      bFoundMediaFile = true;
-                      break;
-                    }
-                  }
-                }
-              }
-            }
-            if (bFoundMediaFile)
-            {
-              cuesheet->UpdateMediaFile(fileFromCue, strMediaFile);
-              // apply CUE for later processing
-              for (int j = 0; j < (int)m_items.size(); j++)
-              {
-                CFileItemPtr pItem = m_items[j];
-                if (stricmp(pItem->GetPath().c_str(), strMediaFile.c_str()) == 0)
-                  pItem->SetCueDocument(cuesheet);
               }
             }
           }
         }
-        itemstodelete.push_back(pItem->GetPath());
+        if (bFoundMediaFile)
+        {
+          cuesheet->UpdateMediaFile(fileFromCue, strMediaFile);
+          // apply CUE for later processing
+          for (int j = 0; j < (int)m_items.size(); j++)
+          {
+            CFileItemPtr pItem = m_items[j];
+            if (stricmp(pItem->GetPath().c_str(), strMediaFile.c_str()) == 0)
+              pItem->SetCueDocument(cuesheet);
+          }
+        }
       }
     }
+    itemstodelete.insert(pItem.get());
   }
+
   // now delete the .CUE files.
-  for (int i = 0; i < (int)itemstodelete.size(); i++)
+  KODI::UTILS::ParallelRemoveIf(m_items, [&itemstodelete](const CFileItemPtr& item)
   {
-    for (int j = 0; j < (int)m_items.size(); j++)
-    {
-      CFileItemPtr pItem = m_items[j];
-      if (stricmp(pItem->GetPath().c_str(), itemstodelete[i].c_str()) == 0)
-      { // delete this item
-        m_items.erase(m_items.begin() + j);
-        break;
-      }
-    }
-  }
+    return itemstodelete.find(item.get()) != itemstodelete.end();
+  });
 }
 
 // Remove the extensions from the filenames
@@ -2598,77 +2622,94 @@ void CFileItemList::StackFolders()
     return;
   }
 
-  // stack folders
-  for (int i = 0; i < Size(); i++)
+  // stack folders. Every item is only modified by the chunk processing it, but
+  // regular expressions keep their match state and need to be private to each
+  // chunk. Checking the folders is I/O bound, so keep the chunks small.
+  std::atomic<bool> sortingBroken(false);
+  KODI::UTILS::ParallelFor(m_items.size(), IO_GRAIN_SIZE, [&](size_t begin, size_t end)
   {
-    CFileItemPtr item = Get(i);
-    // combined the folder checks
-    if (item->m_bIsFolder)
+    VECCREGEXP regExps(folderRegExps);
+    for (size_t i = begin; i < end; i++)
     {
-      // only check known fast sources?
-      // NOTES:
-      // 1. rars and zips may be on slow sources? is this supposed to be allowed?
-      if( !item->IsRemote()
-        || item->IsSmb()
-        || item->IsNfs()
-        || URIUtils::IsInRAR(item->GetPath())
-        || URIUtils::IsInZIP(item->GetPath())
-        || URIUtils::IsOnLAN(item->GetPath())
-        )
-      {
-        // stack cd# folders if contains only a single video file
+      CFileItemPtr item = m_items[i];
+      if (StackFolder(*item, regExps))
+        sortingBroken = true;
+    }
+  }, IO_PARALLEL_THRESHOLD);
 
-        bool bMatch(false);
+  if (sortingBroken)
+    m_sortDescription.sortBy = SortByNone; /* sorting is now broken */
+}
 
-        VECCREGEXP::iterator expr = folderRegExps.begin();
-        while (!bMatch && expr != folderRegExps.end())
-        {
-          //CLog::Log(LOGDEBUG,"%s: Running expression %s on %s", __FUNCTION__, expr->GetPattern().c_str(), item->GetLabel().c_str());
-          bMatch = (expr->RegFind(item->GetLabel().c_str()) != -1);
-          if (bMatch)
-          {
-            CFileItemList items;
-            CDirectory::GetDirectory(item->GetPath(), items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions());
-            // optimized to only traverse listing once by checking for filecount
-            // and recording last file item for later use
-            int nFiles = 0;
-            int index = -1;
-            for (int j = 0; j < items.Size(); j++)
-            {
-              if (!items[j]->m_bIsFolder)
-              {
-                nFiles++;
-                index = j;
-              }
+bool CFileItemList::StackFolder(CFileItem& item, VECCREGEXP& folderRegExps)
+{
+  // combined the folder checks
+  if (!item.m_bIsFolder)
+    return false;
 
-              if (nFiles > 1)
-                break;
-            }
+  // only check known fast sources?
+  // NOTES:
+  // 1. rars and zips may be on slow sources? is this supposed to be allowed?
+  if( item.IsRemote()
+    && !item.IsSmb()
+    && !item.IsNfs()
+    && !URIUtils::IsInRAR(item.GetPath())
+    && !URIUtils::IsInZIP(item.GetPath())
+    && !URIUtils::IsOnLAN(item.GetPath())
+    )
+    return false;
 
-            if (nFiles == 1)
-              *item = *items[index];
-          }
-          expr++;
-        }
+  // stack cd# folders if contains only a single video file
 
-        // check for dvd folders
-        if (!bMatch)
-        {
-          std::string dvdPath = item->GetOpticalMediaPath();
+  bool bMatch(false);
 
-          if (!dvdPath.empty())
-          {
-            // NOTE: should this be done for the CD# folders too?
-            item->m_bIsFolder = false;
-            item->SetPath(dvdPath);
-            item->SetLabel2("");
-            item->SetLabelPreformatted(true);
-            m_sortDescription.sortBy = SortByNone; /* sorting is now broken */
-          }
+  VECCREGEXP::iterator expr = folderRegExps.begin();
+  while (!bMatch && expr != folderRegExps.end())
+  {
+    //CLog::Log(LOGDEBUG,"%s: Running expression %s on %s", __FUNCTION__, expr->GetPattern().c_str(), item.GetLabel().c_str());
+    bMatch = (expr->RegFind(item.GetLabel().c_str()) != -1);
+    if (bMatch)
+    {
+      CFileItemList items;
+      CDirectory::GetDirectory(item.GetPath(), items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions());
+      // optimized to only traverse listing once by checking for filecount
+      // and recording last file item for later use
+      int nFiles = 0;
+      int index = -1;
+      for (int j = 0; j < items.Size(); j++)
+      {
+        if (!items[j]->m_bIsFolder)
+        {
+          nFiles++;
+          index = j;
         }
+
+        if (nFiles > 1)
+          break;
       }
+
+      if (nFiles == 1)
+        item = *items[index];
+    }
+    expr++;
+  }
+
+  // check for dvd folders
+  if (!bMatch)
+  {
+    std::string dvdPath = item.GetOpticalMediaPath();
+
+    if (!dvdPath.empty())
+    {
+      // NOTE: should this be done for the CD# folders too?
+      item.m_bIsFolder = false;
+      item.SetPath(dvdPath);
+      item.SetLabel2("");
+      item.SetLabelPreformatted(true);
+      return true;
     }
   }
+  return false;
 }
 
 void CFileItemList::StackFiles()
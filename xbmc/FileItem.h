@@ -66,6 +66,7 @@ class CVariant;
 
 class CFileItemList;
 class CCueDocument;
+class CRegExp;
 typedef std::shared_ptr<CCueDocument> CCueDocumentPtr;
 
 class IEvent;
@@ -797,6 +798,15 @@ private:
    */
   void StackFolders();
 
+  /*!
+   \brief stack a single folder item, used by StackFolders
+   \param item the folder item to stack
+   \param folderRegExps the compiled folder stacking expressions
+   \return true if the item was turned into a file, breaking the sort order
+   \sa StackFolders
+   */
+  static bool StackFolder(CFileItem& item, std::vector<CRegExp>& folderRegExps);
+
   VECFILEITEMS m_items;
   MAPFILEITEMS m_map;
   bool m_ignoreURLOptions;
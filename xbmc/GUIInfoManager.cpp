@@ -41,6 +41,7 @@
 #include "utils/SystemInfo.h"
 #include "guilib/GUITextBox.h"
 #include "guilib/GUIControlGroupList.h"
+#include "guilib/GUIFrameProfiler.h"
 #include "pictures/GUIWindowSlideShow.h"
 #include "pictures/PictureInfoTag.h"
 #include "music/tags/MusicInfoTag.h"
@@ -167,7 +168,8 @@ CGUIInfoManager::CGUIInfoManager(void) :
   m_playerShowTime = false;
   m_playerShowInfo = false;
   m_fps = 0.0f;
-  m_refreshCounter = 0;
+  m_wasPlaying = false;
+  m_lastTime = 0;
   ResetLibraryBools();
 }
 
@@ -5915,6 +5917,7 @@ TIME_FORMAT CGUIInfoManager::TranslateTimeFormat(const std::string &format)
 
 std::string CGUIInfoManager::GetLabel(int info, int contextWindow, std::string *fallback)
 {
+  CGUIFrameProfilerScope profile("CGUIInfoManager::GetLabel");
   if (info >= CONDITIONAL_LABEL_START && info <= CONDITIONAL_LABEL_END)
     return GetSkinVariableString(info, false);
 
@@ -6918,9 +6921,9 @@ INFO::InfoPtr CGUIInfoManager::Register(const std::string &expression, int conte
   std::pair<INFOBOOLTYPE::iterator, bool> res;
 
   if (condition.find_first_of("|+[]!") != condition.npos)
-    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_infoSources));
   else
-    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_infoSources));
 
   if (res.second)
     res.first->get()->Initialize();
@@ -8209,6 +8212,7 @@ std::string CGUIInfoManager::GetMultiInfoLabel(const GUIInfo &info, int contextW
 /// \brief Obtains the filename of the image to show from whichever subsystem is needed
 std::string CGUIInfoManager::GetImage(int info, int contextWindow, std::string *fallback)
 {
+  CGUIFrameProfilerScope profile("CGUIInfoManager::GetImage");
   if (info >= CONDITIONAL_LABEL_START && info <= CONDITIONAL_LABEL_END)
     return GetSkinVariableString(info, true);
 
@@ -10694,7 +10698,115 @@ void CGUIInfoManager::ResetCache()
   m_containerMoves.clear();
   // mark our infobools as dirty
   CSingleLock lock(m_critInfo);
-  ++m_refreshCounter;
+  m_infoSources.Reset();
+}
+
+void CGUIInfoManager::NewFrame()
+{
+  // reset any animation triggers as well
+  m_containerMoves.clear();
+
+  unsigned int changed = INFO::DEPENDENCY_FRAME;
+
+  // the player state can't be observed, so poll it while something is playing
+  bool playing = g_application.m_pPlayer->IsPlaying();
+  if (playing || playing != m_wasPlaying)
+    changed |= INFO::DEPENDENCY_PLAYER;
+  m_wasPlaying = playing;
+
+  time_t now = time(NULL);
+  if (now != m_lastTime)
+    changed |= INFO::DEPENDENCY_TIME;
+  m_lastTime = now;
+
+  std::vector<int> windowState;
+  g_windowManager.GetActiveWindowState(windowState);
+  windowState.push_back(m_nextWindowID);
+  windowState.push_back(m_prevWindowID);
+  if (windowState != m_windowState)
+  {
+    changed |= INFO::DEPENDENCY_WINDOW;
+    m_windowState.swap(windowState);
+  }
+
+  SourcesChanged(changed);
+}
+
+void CGUIInfoManager::SourcesChanged(unsigned int dependencies)
+{
+  CSingleLock lock(m_critInfo);
+  m_infoSources.Changed(dependencies);
+}
+
+unsigned int CGUIInfoManager::GetDependencies(int condition) const
+{
+  condition = abs(condition);
+
+  if (condition >= MULTI_INFO_START && condition <= MULTI_INFO_END)
+  {
+    switch (m_multiInfo[condition - MULTI_INFO_START].m_info)
+    {
+      case SYSTEM_HAS_CORE_ID:
+        return INFO::DEPENDENCY_NONE;
+      case SKIN_BOOL:
+      case SKIN_STRING:
+        return INFO::DEPENDENCY_SETTING;
+      case SYSTEM_DATE:
+      case SYSTEM_TIME:
+        return INFO::DEPENDENCY_TIME;
+      case WINDOW_IS:
+      case WINDOW_IS_ACTIVE:
+      case WINDOW_IS_VISIBLE:
+      case WINDOW_IS_TOPMOST:
+      case WINDOW_NEXT:
+      case WINDOW_PREVIOUS:
+        return INFO::DEPENDENCY_WINDOW;
+      default:
+        return INFO::DEPENDENCY_FRAME;
+    }
+  }
+
+  switch (condition)
+  {
+    case SYSTEM_ALWAYS_TRUE:
+    case SYSTEM_ALWAYS_FALSE:
+    case SYSTEM_ETHERNET_LINK_ACTIVE:
+    case SYSTEM_PLATFORM_LINUX:
+    case SYSTEM_PLATFORM_WINDOWS:
+    case SYSTEM_PLATFORM_DARWIN:
+    case SYSTEM_PLATFORM_DARWIN_OSX:
+    case SYSTEM_PLATFORM_DARWIN_IOS:
+    case SYSTEM_PLATFORM_ANDROID:
+    case SYSTEM_PLATFORM_LINUX_RASPBERRY_PI:
+    case SYSTEM_HAS_PVR:
+    case SYSTEM_HAS_ADSP:
+    case SYSTEM_HAS_CMS:
+    case SYSTEM_SHOW_EXIT_BUTTON:
+      return INFO::DEPENDENCY_NONE;
+    case WINDOW_IS_MEDIA:
+    case SYSTEM_LOGGEDON:
+    case SYSTEM_HAS_ACTIVE_MODAL_DIALOG:
+    case SYSTEM_HAS_VISIBLE_MODAL_DIALOG:
+      return INFO::DEPENDENCY_WINDOW;
+    case PLAYER_MUTED:
+    case PLAYER_SHOWINFO:
+    case PLAYER_IS_CHANNEL_PREVIEW_ACTIVE:
+    case VIDEOPLAYER_HAS_INFO:
+      return INFO::DEPENDENCY_FRAME;
+    case PLAYER_PROCESS_VIDEOHWDECODER:
+      return INFO::DEPENDENCY_PLAYER;
+  }
+
+  if (condition >= LIBRARY_HAS_MUSIC && condition <= LIBRARY_HAS_COMPILATIONS)
+    return INFO::DEPENDENCY_LIBRARY;
+
+  // only evaluated while playing, false otherwise
+  if ((condition >= PLAYER_HAS_MEDIA && condition <= PLAYER_HAS_GAME) ||
+      (condition >= MUSICPLAYER_TITLE && condition <= MUSICPLAYER_DBID) ||
+      (condition >= VIDEOPLAYER_AUDIO_BITRATE && condition <= VIDEOPLAYER_DBID))
+    return INFO::DEPENDENCY_PLAYER;
+
+  return INFO::DEPENDENCY_FRAME;
 }
 
 std::string CGUIInfoManager::GetPictureLabel(int info)
@@ -10864,6 +10976,7 @@ void CGUIInfoManager::SetLibraryBool(int condition, bool value)
     default:
       break;
   }
+  SourcesChanged(INFO::DEPENDENCY_LIBRARY);
 }
 
 void CGUIInfoManager::ResetLibraryBools()
@@ -10876,6 +10989,7 @@ void CGUIInfoManager::ResetLibraryBools()
   m_libraryHasSingles = -1;
   m_libraryHasCompilations = -1;
   m_libraryRoleCounts.clear();
+  SourcesChanged(INFO::DEPENDENCY_LIBRARY);
 }
 
 bool CGUIInfoManager::GetLibraryBool(int condition)
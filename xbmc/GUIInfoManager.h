@@ -204,7 +204,26 @@ public:
   void SetNextWindow(int windowID) { m_nextWindowID = windowID; };
   void SetPreviousWindow(int windowID) { m_prevWindowID = windowID; };
 
+  /*! \brief mark all info bools as dirty, so they are re-evaluated on next use
+   */
   void ResetCache();
+
+  /*! \brief called once per frame to mark the info bools depending on changed info sources as dirty
+   Info bools depending on no specific source (listitems, controls, ...) are marked dirty on every frame,
+   all others only once their player, window, time, skin setting or library source changed.
+   */
+  void NewFrame();
+
+  /*! \brief mark the info bools depending on one of the given sources as dirty
+   \param dependencies the changed sources, combination of INFO::InfoDependency values
+   */
+  void SourcesChanged(unsigned int dependencies);
+
+  /*! \brief get the info sources a condition depends on
+   \param condition the condition, as returned by TranslateSingleString
+   \return combination of INFO::InfoDependency values
+   */
+  unsigned int GetDependencies(int condition) const;
   bool GetItemInt(int &value, const CGUIListItem *item, int info) const;
   std::string GetItemLabel(const CFileItem *item, int info, std::string *fallback = NULL);
   std::string GetItemImage(const CFileItem *item, int info, std::string *fallback = NULL);
@@ -330,7 +349,10 @@ protected:
 
   typedef std::set<INFO::InfoPtr, bool(*)(const INFO::InfoPtr&, const INFO::InfoPtr&)> INFOBOOLTYPE;
   INFOBOOLTYPE m_bools;
-  unsigned int m_refreshCounter;
+  INFO::InfoSources m_infoSources;
+  bool m_wasPlaying;
+  time_t m_lastTime;
+  std::vector<int> m_windowState;
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   int m_libraryHasMusic;
@@ -20,6 +20,7 @@
 
 #include "threads/SystemClock.h"
 #include "GUILargeTextureManager.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "guilib/Texture.h"
 #include "threads/SingleLock.h"
@@ -61,7 +62,15 @@ bool CImageLoader::DoWork()
   {
     // direct route - load the image
     unsigned int start = XbmcThreads::SystemClockMillis();
-    m_texture = CBaseTexture::LoadFromFile(loadPath, g_graphicsContext.GetWidth(), g_graphicsContext.GetHeight());
+    if (m_use_cache)
+    {
+      // the compressed copy uploads without decoding
+      std::string compressedPath = CTextureCache::GetCompressedImage(loadPath);
+      if (!compressedPath.empty())
+        m_texture = CBaseTexture::LoadFromFile(compressedPath, g_graphicsContext.GetWidth(), g_graphicsContext.GetHeight());
+    }
+    if (!m_texture)
+      m_texture = CBaseTexture::LoadFromFile(loadPath, g_graphicsContext.GetWidth(), g_graphicsContext.GetHeight());
 
     if (XbmcThreads::SystemClockMillis() - start > 100)
       CLog::Log(LOGDEBUG, "%s - took %u ms to load %s", __FUNCTION__, XbmcThreads::SystemClockMillis() - start, loadPath.c_str());
@@ -136,6 +145,17 @@ void CGUILargeTextureManager::CLargeTexture::SetTexture(CBaseTexture* texture)
     m_texture.Set(texture, texture->GetWidth(), texture->GetHeight());
 }
 
+size_t CGUILargeTextureManager::CLargeTexture::Upload()
+{
+  if (!m_texture.size())
+    return 0;
+
+  CBaseTexture *texture = m_texture.m_textures[0];
+  size_t size = texture->GetPitch() * texture->GetRows();
+  texture->LoadToGPU();
+  return size;
+}
+
 CGUILargeTextureManager::CGUILargeTextureManager() = default;
 
 CGUILargeTextureManager::~CGUILargeTextureManager() = default;
@@ -191,6 +211,16 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
       return;
     }
   }
+  for (listIterator it = m_loaded.begin(); it != m_loaded.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->GetPath() == path)
+    {
+      if (image->DecrRef(true))
+        m_loaded.erase(it);
+      return;
+    }
+  }
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
     unsigned int id = it->first;
@@ -221,6 +251,15 @@ void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
       return; // already queued
     }
   }
+  for (listIterator it = m_loaded.begin(); it != m_loaded.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->GetPath() == path)
+    {
+      image->AddRef();
+      return; // already loaded, waiting for the upload
+    }
+  }
 
   // queue the item
   CLargeTexture *image = new CLargeTexture(path);
@@ -241,8 +280,31 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
       image->SetTexture(loader->m_texture);
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
       m_queued.erase(it);
-      m_allocated.push_back(image);
+      m_loaded.push_back(image);
       return;
     }
   }
 }
+
+void CGUILargeTextureManager::UploadImages()
+{
+  CSingleLock lock(m_listSection);
+  if (m_loaded.empty())
+    return;
+
+  int64_t start = CurrentHostCounter();
+  int64_t budget = CurrentHostFrequency() * g_advancedSettings.m_guiTextureUploadBudget / 1000;
+  size_t size = 0;
+  listIterator it = m_loaded.begin();
+  while (it != m_loaded.end())
+  {
+    CLargeTexture *image = *it;
+    size += image->Upload();
+    m_allocated.push_back(image);
+    ++it;
+
+    if (size >= UPLOAD_BUDGET_BYTES || CurrentHostCounter() - start >= budget)
+      break;
+  }
+  m_loaded.erase(m_loaded.begin(), it);
+}
@@ -115,6 +115,19 @@ public:
    */
   void CleanupUnusedImages(bool immediately = false);
 
+  /*!
+   \brief Upload images loaded in the background to the GPU.
+
+   Loaded images are only handed out once they are uploaded, so that the upload doesn't happen when
+   they are first rendered. To avoid stalling a frame when many images arrive at once, e.g. while
+   scrolling through a wall of posters, the uploads are spread over several frames: at least one image
+   is uploaded per call, more as long as the time and size budget of the frame allows.
+
+   Must be called from the rendering thread, once per frame.
+   \sa CAdvancedSettings::m_guiTextureUploadBudget
+   */
+  void UploadImages();
+
 private:
   class CLargeTexture
   {
@@ -126,6 +139,7 @@ private:
     bool DecrRef(bool deleteImmediately);
     bool DeleteIfRequired(bool deleteImmediately = false);
     void SetTexture(CBaseTexture* texture);
+    size_t Upload();
 
     const std::string &GetPath() const { return m_path; };
     const CTextureArray &GetTexture() const { return m_texture; };
@@ -141,7 +155,10 @@ private:
 
   void QueueImage(const std::string &path, bool useCache = true);
 
+  static const size_t UPLOAD_BUDGET_BYTES = 16 * 1024 * 1024; ///< maximal size of the images uploaded per frame
+
   std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
+  std::vector<CLargeTexture *> m_loaded; ///< loaded images waiting to be uploaded
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
   typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
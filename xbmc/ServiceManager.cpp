@@ -40,6 +40,7 @@
 #include "pvr/PVRManager.h"
 #include "settings/Settings.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/InitGraph.h"
 
 using namespace KODI;
 
@@ -69,50 +70,77 @@ bool CServiceManager::InitStageOne()
 
 bool CServiceManager::InitStageTwo(const CAppParamParser &params)
 {
+  // the platform init sets environment variables, which is not thread safe,
+  // it is quick and runs before the other services are started
   m_Platform.reset(CPlatform::CreateInstance());
   m_Platform->Init();
 
-  m_binaryAddonManager.reset(new ADDON::CBinaryAddonManager()); /* Need to constructed before, GetRunningInstance() of binary CAddonDll need to call them */
-  m_addonMgr.reset(new ADDON::CAddonMgr());
-  if (!m_addonMgr->Init())
-  {
-    CLog::Log(LOGFATAL, "CServiceManager::%s: Unable to start CAddonMgr", __FUNCTION__);
-    return false;
-  }
+  // the add-on scan takes most of the time, services that don't need the
+  // add-ons come up meanwhile
+  UTILS::CInitGraph services("services");
 
-  if (!m_binaryAddonManager->Init())
-  {
-    CLog::Log(LOGFATAL, "CServiceManager::%s: Unable to initialize CBinaryAddonManager", __FUNCTION__);
-    return false;
-  }
+  services.Add("addons", [this]() {
+    m_binaryAddonManager.reset(new ADDON::CBinaryAddonManager()); /* Need to constructed before, GetRunningInstance() of binary CAddonDll need to call them */
+    m_addonMgr.reset(new ADDON::CAddonMgr());
+    if (!m_addonMgr->Init())
+    {
+      CLog::Log(LOGFATAL, "CServiceManager::InitStageTwo: Unable to start CAddonMgr");
+      return false;
+    }
+
+    if (!m_binaryAddonManager->Init())
+    {
+      CLog::Log(LOGFATAL, "CServiceManager::InitStageTwo: Unable to initialize CBinaryAddonManager");
+      return false;
+    }
+    return true;
+  });
 
-  m_repositoryUpdater.reset(new ADDON::CRepositoryUpdater(*m_addonMgr));
+  services.Add("addoncaches", [this]() {
+    m_repositoryUpdater.reset(new ADDON::CRepositoryUpdater(*m_addonMgr));
 
-  m_vfsAddonCache.reset(new ADDON::CVFSAddonCache());
-  m_vfsAddonCache->Init();
+    m_vfsAddonCache.reset(new ADDON::CVFSAddonCache());
+    m_vfsAddonCache->Init();
 
-  m_PVRManager.reset(new PVR::CPVRManager());
+    m_binaryAddonCache.reset( new ADDON::CBinaryAddonCache());
+    m_binaryAddonCache->Init();
 
-  m_dataCacheCore.reset(new CDataCacheCore());
+    m_serviceAddons.reset(new ADDON::CServiceAddonManager(*m_addonMgr));
 
-  m_binaryAddonCache.reset( new ADDON::CBinaryAddonCache());
-  m_binaryAddonCache->Init();
+    m_contextMenuManager.reset(new CContextMenuManager(*m_addonMgr.get()));
 
-  m_favouritesService.reset(new CFavouritesService(CProfilesManager::GetInstance().GetProfileUserDataFolder()));
+    m_fileExtensionProvider.reset(new CFileExtensionProvider());
+    return true;
+  }, { "addons" });
 
-  m_serviceAddons.reset(new ADDON::CServiceAddonManager(*m_addonMgr));
+  services.Add("pvr", [this]() {
+    m_PVRManager.reset(new PVR::CPVRManager());
+    return true;
+  }, { "addons" });
 
-  m_contextMenuManager.reset(new CContextMenuManager(*m_addonMgr.get()));
+  services.Add("datacache", [this]() {
+    m_dataCacheCore.reset(new CDataCacheCore());
+    return true;
+  });
 
-  m_gameControllerManager.reset(new GAME::CControllerManager);
-  m_inputManager.reset(new CInputManager(params));
-  m_inputManager->InitializeInputs();
+  services.Add("favourites", [this]() {
+    m_favouritesService.reset(new CFavouritesService(CProfilesManager::GetInstance().GetProfileUserDataFolder()));
+    return true;
+  });
 
-  m_peripherals.reset(new PERIPHERALS::CPeripherals(*m_announcementManager));
+  services.Add("input", [this, &params]() {
+    m_gameControllerManager.reset(new GAME::CControllerManager);
+    m_inputManager.reset(new CInputManager(params));
+    m_inputManager->InitializeInputs();
 
-  m_gameRenderManager.reset(new RETRO::CGUIGameRenderManager);
+    m_peripherals.reset(new PERIPHERALS::CPeripherals(*m_announcementManager));
 
-  m_fileExtensionProvider.reset(new CFileExtensionProvider());
+    m_gameRenderManager.reset(new RETRO::CGUIGameRenderManager);
+    return true;
+  }, { "addons" });
+
+  if (!services.Run())
+    return false;
 
   init_level = 2;
   return true;
@@ -28,6 +28,7 @@
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
+#include "windowing/WindowingFactory.h"
 #include "URL.h"
 
 using namespace XFILE;
@@ -113,6 +114,24 @@ std::string CTextureCache::CheckCachedImage(const std::string &url, bool &needsR
   return "";
 }
 
+std::string CTextureCache::GetCompressedImage(const std::string &cachedImage)
+{
+  if (!g_advancedSettings.m_useDDSTextures || !g_Windowing.SupportsDXT())
+    return "";
+
+  std::string ddsPath = URIUtils::ReplaceExtension(cachedImage, ".dds");
+  if (CFile::Exists(ddsPath))
+    return ddsPath;
+  return "";
+}
+
+void CTextureCache::DeleteCompressedImage(const std::string &cachedImage)
+{
+  std::string ddsPath = URIUtils::ReplaceExtension(cachedImage, ".dds");
+  if (CFile::Exists(ddsPath))
+    CFile::Delete(ddsPath);
+}
+
 void CTextureCache::BackgroundCacheImage(const std::string &url)
 {
   if (url.empty())
@@ -186,9 +205,7 @@ void CTextureCache::ClearCachedImage(const std::string &url, bool deleteSource /
     path = GetCachedPath(cachedFile);
   if (CFile::Exists(path))
     CFile::Delete(path);
-  path = URIUtils::ReplaceExtension(path, ".dds");
-  if (CFile::Exists(path))
-    CFile::Delete(path);
+  DeleteCompressedImage(path);
 }
 
 bool CTextureCache::ClearCachedImage(int id)
@@ -199,9 +216,7 @@ bool CTextureCache::ClearCachedImage(int id)
     cachedFile = GetCachedPath(cachedFile);
     if (CFile::Exists(cachedFile))
       CFile::Delete(cachedFile);
-    cachedFile = URIUtils::ReplaceExtension(cachedFile, ".dds");
-    if (CFile::Exists(cachedFile))
-      CFile::Delete(cachedFile);
+    DeleteCompressedImage(cachedFile);
     return true;
   }
   return false;
@@ -69,6 +69,26 @@ public:
    */ 
   std::string CheckCachedImage(const std::string &image, bool &needsRecaching);
 
+  /*! \brief Get the DXT compressed copy of a cached image, for uploading it as a texture
+
+   Only the GUI texture loader should use this, everyone else expects the original image.
+
+   \param cachedImage path of the cached image, as returned by CheckCachedImage
+   \return path of the .dds copy, empty if there is none or the GPU can't use it
+   \sa CheckCachedImage
+   */
+  static std::string GetCompressedImage(const std::string &cachedImage);
+
+  /*! \brief Delete the DXT compressed copy of a cached image
+
+   Called whenever the cached image is replaced or cleared, so no outdated copy is
+   loaded once useddstextures is turned on again.
+
+   \param cachedImage path of the cached image
+   \sa GetCompressedImage
+   */
+  static void DeleteCompressedImage(const std::string &cachedImage);
+
   /*! \brief Cache image (if required) using a background job
 
    Checks firstly whether an image is already cached, and return URL if so [see CheckCacheImage]
@@ -20,6 +20,7 @@
 
 #include "TextureCacheJob.h"
 #include "TextureCache.h"
+#include "guilib/DDSImage.h"
 #include "guilib/Texture.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
@@ -28,6 +29,7 @@
 #include "pictures/Picture.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
+#include "windowing/WindowingFactory.h"
 #include "URL.h"
 #include "FileItem.h"
 #include "music/MusicThumbLoader.h"
@@ -88,6 +90,9 @@ bool CTextureCacheJob::CacheTexture(CBaseTexture **out_texture)
   else if (m_details.hash == m_oldHash)
     return true;
 
+  // the image is replaced, CacheDDS creates a new compressed copy if it's wanted
+  CTextureCache::DeleteCompressedImage(CTextureCache::GetCachedPath(m_cachePath + ".dds"));
+
 #if defined(TARGET_RASPBERRY_PI)
   if (COMXImage::CreateThumb(image, width, height, additional_info, CTextureCache::GetCachedPath(m_cachePath + ".jpg")))
   {
@@ -100,7 +105,13 @@ bool CTextureCacheJob::CacheTexture(CBaseTexture **out_texture)
     return true;
   }
 #endif
-  CBaseTexture *texture = LoadImage(image, width, height, additional_info, true);
+  // the cached image is never larger than the fanart or image resolution, letting the
+  // loader know allows it to decode large images at a reduced size
+  unsigned int maxHeight = std::max(g_advancedSettings.m_imageRes, g_advancedSettings.m_fanartRes);
+  unsigned int loadWidth = width ? std::min(width, maxHeight * 16 / 9) : maxHeight * 16 / 9;
+  unsigned int loadHeight = height ? std::min(height, maxHeight) : maxHeight;
+
+  CBaseTexture *texture = LoadImage(image, loadWidth, loadHeight, additional_info, true);
   if (texture)
   {
     if (texture->HasAlpha())
@@ -114,6 +125,8 @@ bool CTextureCacheJob::CacheTexture(CBaseTexture **out_texture)
     {
       m_details.width = width;
       m_details.height = height;
+      if (g_advancedSettings.m_useDDSTextures && g_Windowing.SupportsDXT())
+        CacheDDS(CTextureCache::GetCachedPath(m_details.file));
       if (out_texture) // caller wants the texture
         *out_texture = texture;
       else
@@ -125,6 +138,27 @@ bool CTextureCacheJob::CacheTexture(CBaseTexture **out_texture)
   return false;
 }
 
+bool CTextureCacheJob::CacheDDS(const std::string &cachedFile)
+{
+  std::string ddsFile = URIUtils::ReplaceExtension(cachedFile, ".dds");
+
+  // compress the scaled down version, not the original
+  std::unique_ptr<CBaseTexture> texture(CBaseTexture::LoadFromFile(cachedFile, 0, 0, true));
+  if (texture)
+  {
+    CDDSImage dds;
+    if (dds.Compress(texture->GetWidth(), texture->GetHeight(), texture->GetPitch(), texture->GetPixels(),
+                     texture->HasAlpha() ? XB_FMT_DXT5 : XB_FMT_DXT1) &&
+        dds.WriteFile(ddsFile))
+      return true;
+  }
+
+  CLog::Log(LOGWARNING, "%s - unable to create %s", __FUNCTION__, ddsFile.c_str());
+  // don't leave a partly written file behind
+  CTextureCache::DeleteCompressedImage(cachedFile);
+  return false;
+}
+
 bool CTextureCacheJob::ResizeTexture(const std::string &url, uint8_t* &result, size_t &result_size)
 {
   result = NULL;
@@ -101,6 +101,12 @@ private:
    */
   bool UpdateableURL(const std::string &url) const;
 
+  /*! \brief Store a DXT compressed copy of a cached image next to it, for faster loading
+   \param cachedFile full path of the cached image
+   \return true if the compressed copy was written, false otherwise
+   */
+  static bool CacheDDS(const std::string &cachedFile);
+
   /*! \brief Decode an image URL to the underlying image, width, height and orientation
    \param url wrapped URL of the image
    \param width width derived from URL
@@ -2590,6 +2590,7 @@ void CActiveAE::LoadSettings()
 
 bool CActiveAE::Initialize()
 {
+  SetRole(XbmcThreads::ThreadRole::AUDIO_REALTIME);
   Create();
   Message *reply;
   if (m_controlPort.SendOutMessageSync(CActiveAEControlProtocol::INIT,
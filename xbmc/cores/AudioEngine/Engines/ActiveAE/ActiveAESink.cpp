@@ -55,6 +55,7 @@ void CActiveAESink::Start()
 {
   if (!IsRunning())
   {
+    SetRole(XbmcThreads::ThreadRole::AUDIO_REALTIME);
     Create();
     SetPriority(THREAD_PRIORITY_ABOVE_NORMAL);
   }
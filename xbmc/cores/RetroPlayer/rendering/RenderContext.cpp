@@ -94,6 +94,25 @@ void CRenderContext::DisableGUIShader()
 #endif
 }
 
+void CRenderContext::EnableGUIBlending()
+{
+#if defined(HAS_GL)
+  CRenderSystemGL *renderingGL = dynamic_cast<CRenderSystemGL*>(m_rendering);
+  if (renderingGL != nullptr)
+  {
+    renderingGL->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    renderingGL->SetBlending(true);
+  }
+#elif HAS_GLES >= 2
+  CRenderSystemGLES *renderingGLES = dynamic_cast<CRenderSystemGLES*>(m_rendering);
+  if (renderingGLES != nullptr)
+  {
+    renderingGLES->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    renderingGLES->SetBlending(true);
+  }
+#endif
+}
+
 int CRenderContext::GUIShaderGetPos()
 {
 #if defined(HAS_GL)
@@ -59,6 +59,7 @@ namespace RETRO
     // OpenGL(ES) rendering functions
     void EnableGUIShader();
     void DisableGUIShader();
+    void EnableGUIBlending();
     int GUIShaderGetPos();
     int GUIShaderGetCoord0();
     int GUIShaderGetUniCol();
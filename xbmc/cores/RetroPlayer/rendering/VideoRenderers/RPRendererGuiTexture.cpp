@@ -140,8 +140,7 @@ void CRPRendererGuiTexture::RenderInternal(bool clear, uint8_t alpha)
 #elif defined(HAS_GL)
 
   renderBuffer->BindToUnit(0);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glEnable(GL_BLEND);
+  m_context.EnableGUIBlending();
 
   m_context.EnableGUIShader();
 
@@ -231,8 +230,7 @@ void CRPRendererGuiTexture::RenderInternal(bool clear, uint8_t alpha)
 
   renderBuffer->BindToUnit(0);
 
-  glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
-  glEnable(GL_BLEND); // Turn blending On
+  m_context.EnableGUIBlending();
 
   m_context.EnableGUIShader();
 
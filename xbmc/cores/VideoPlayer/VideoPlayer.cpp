@@ -712,6 +712,7 @@ bool CVideoPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options
   m_error = false;
   m_renderManager.PreInit();
 
+  SetRole(XbmcThreads::ThreadRole::VIDEO_DECODE);
   Create();
 
   return true;
@@ -2458,6 +2459,7 @@ void CVideoPlayer::OnExit()
   }
 
   CFFmpegLog::ClearLogLevel();
+  XbmcThreads::CThreadRoles::LogStatistics();
   m_bStop = true;
 
   IPlayerCallback *cb = &m_callback;
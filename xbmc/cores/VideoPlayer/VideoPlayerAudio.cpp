@@ -25,6 +25,7 @@
 #include "DVDCodecs/DVDFactoryCodec.h"
 #include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
 #include "settings/Settings.h"
+#include "threads/Trace.h"
 #include "utils/log.h"
 #include "utils/MathUtils.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
@@ -109,6 +110,7 @@ bool CVideoPlayerAudio::OpenStream(CDVDStreamInfo hints)
     OpenStream(hints, codec);
     m_messageQueue.Init();
     CLog::Log(LOGNOTICE, "Creating audio thread");
+    SetRole(XbmcThreads::ThreadRole::AUDIO_REALTIME);
     Create();
   }
   return true;
@@ -395,6 +397,7 @@ void CVideoPlayerAudio::Process()
     }
     else if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
     {
+      XbmcThreads::CTraceScope trace("audio", "CVideoPlayerAudio::DecodePacket");
       DemuxPacket* pPacket = static_cast<CDVDMsgDemuxerPacket*>(pMsg)->GetPacket();
       bool bPacketDrop  = static_cast<CDVDMsgDemuxerPacket*>(pMsg)->GetPacketDrop();
 
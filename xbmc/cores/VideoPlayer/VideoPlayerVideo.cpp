@@ -34,6 +34,7 @@
 #include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
 #include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
 #include "guilib/GraphicContext.h"
+#include "threads/Trace.h"
 #include <sstream>
 #include <iomanip>
 #include <numeric>
@@ -164,6 +165,7 @@ bool CVideoPlayerVideo::OpenStream(CDVDStreamInfo hint)
     CLog::Log(LOGNOTICE, "Creating video thread");
     m_messageQueue.Init();
     m_processInfo.SetLevelVQ(0);
+    SetRole(XbmcThreads::ThreadRole::VIDEO_DECODE);
     Create();
   }
   return true;
@@ -529,6 +531,7 @@ void CVideoPlayerVideo::Process()
     }
     else if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
     {
+      XbmcThreads::CTraceScope trace("video", "CVideoPlayerVideo::DecodePacket");
       DemuxPacket* pPacket = static_cast<CDVDMsgDemuxerPacket*>(pMsg)->GetPacket();
       bool bPacketDrop = static_cast<CDVDMsgDemuxerPacket*>(pMsg)->GetPacketDrop();
 
@@ -22,10 +22,13 @@
 #include "settings/AdvancedSettings.h"
 #include "filesystem/SpecialProtocol.h"
 #include "filesystem/File.h"
+#include "platform/Filesystem.h"
 #include "profiles/ProfilesManager.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
 #include "sqlitedataset.h"
 #include "DatabaseManager.h"
 #include "DbUrl.h"
@@ -34,10 +37,18 @@
 #include "mysqldataset.h"
 #endif
 
+#include <algorithm>
+
 #ifdef TARGET_POSIX
 #include "linux/ConvUtils.h"
 #endif
 
+// maximum time a batch transaction is kept open, so other writers aren't locked out for long
+#define BATCH_MAX_DURATION_MS 5000
+
+// maximum number of rows inserted by a single statement
+#define BULK_INSERT_MAX_ROWS 250
+
 using namespace dbiplus;
 
 #define MAX_COMPRESS_COUNT 20
@@ -155,6 +166,11 @@ CDatabase::CDatabase(void)
   m_sqlite = true;
   m_bMultiWrite = false;
   m_multipleExecute = false;
+  m_batchSize = 0;
+  m_batchItems = 0;
+  m_batchStart = 0;
+  m_savepointDepth = 0;
+  m_batchOpen = false;
 }
 
 CDatabase::~CDatabase(void)
@@ -348,6 +364,25 @@ bool CDatabase::CommitInsertQueries()
   return bReturn;
 }
 
+bool CDatabase::ExecuteBulkInsert(const std::string &strStatement, const std::vector<std::string> &rows)
+{
+  bool bReturn = true;
+  for (size_t start = 0; start < rows.size(); start += BULK_INSERT_MAX_ROWS)
+  {
+    const size_t end = std::min(rows.size(), start + BULK_INSERT_MAX_ROWS);
+    std::string strSQL = strStatement;
+    for (size_t i = start; i < end; i++)
+    {
+      if (i > start)
+        strSQL += ", ";
+      strSQL += rows[i];
+    }
+    if (!ExecuteQuery(strSQL))
+      bReturn = false;
+  }
+  return bReturn;
+}
+
 bool CDatabase::Open()
 {
   DatabaseSettings db_fallback;
@@ -371,7 +406,24 @@ bool CDatabase::Open(const DatabaseSettings &settings)
 
   std::string dbName = dbSettings.name;
   dbName += StringUtils::Format("%d", GetSchemaVersion());
-  return Connect(dbName, dbSettings, false);
+
+  if (!m_sqlite)
+    return Connect(dbName, dbSettings, false);
+
+  // reuse an idle connection if there is one, otherwise our connection will be pooled on Close()
+  std::string connectionKey = URIUtils::AddFileToFolder(dbSettings.host, dbName);
+  m_pDB = CDatabaseManager::GetInstance().AcquireConnection(connectionKey);
+  if (m_pDB)
+  {
+    m_pDS.reset(m_pDB->CreateDataset());
+    m_pDS2.reset(m_pDB->CreateDataset());
+    m_openCount = 1;
+  }
+  else if (!Connect(dbName, dbSettings, false))
+    return false;
+
+  m_connectionKey = connectionKey;
+  return true;
 }
 
 void CDatabase::InitSettings(DatabaseSettings &dbSettings)
@@ -489,6 +541,25 @@ bool CDatabase::Connect(const std::string &dbName, const DatabaseSettings &dbSet
       m_pDS->exec("PRAGMA cache_size=4096\n");
       m_pDS->exec("PRAGMA synchronous='NORMAL'\n");
       m_pDS->exec("PRAGMA count_changes='OFF'\n");
+
+      // with write-ahead logging readers don't block writers and vice versa,
+      // so browsing the library stays responsive during scans. It needs shared
+      // memory between connections, which network filesystems don't provide.
+      std::error_code ec;
+      bool wal = g_advancedSettings.m_bSqliteWal;
+      if (wal && KODI::PLATFORM::FILESYSTEM::is_network(dbSettings.host, ec))
+      {
+        CLog::Log(LOGDEBUG, "%s - %s is on a network filesystem, not using write-ahead logging", __FUNCTION__, dbSettings.host.c_str());
+        wal = false;
+      }
+
+      if (wal)
+      {
+        m_pDS->exec("PRAGMA journal_mode=WAL\n");
+        m_pDS->exec(PrepareSQL("PRAGMA wal_autocheckpoint=%i\n", g_advancedSettings.m_iSqliteWalAutoCheckpoint));
+      }
+      else
+        m_pDS->exec("PRAGMA journal_mode=DELETE\n");
     }
   }
   catch (DbErrors &error)
@@ -530,12 +601,25 @@ void CDatabase::Close()
   m_openCount = 0;
   m_multipleExecute = false;
 
+  // don't lose the items of an unfinished batch
+  EndBatch();
+
+  std::string connectionKey;
+  connectionKey.swap(m_connectionKey);
+
   if (NULL == m_pDB.get() ) return ;
   if (NULL != m_pDS.get()) m_pDS->close();
-  m_pDB->disconnect();
-  m_pDB.reset();
   m_pDS.reset();
   m_pDS2.reset();
+
+  if (!connectionKey.empty() && !m_pDB->in_transaction())
+  {
+    CDatabaseManager::GetInstance().ReleaseConnection(connectionKey, std::move(m_pDB));
+    return;
+  }
+
+  m_pDB->disconnect();
+  m_pDB.reset();
 }
 
 bool CDatabase::Compress(bool bForce /* =true */)
@@ -584,7 +668,23 @@ void CDatabase::BeginTransaction()
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->start_transaction();
+    {
+      if (m_batchSize > 0)
+      {
+        // the batch transaction is only opened by the first write, so
+        // nothing is locked while the caller is busy elsewhere
+        if (!m_batchOpen)
+        {
+          m_pDB->start_transaction();
+          m_batchOpen = true;
+          m_batchStart = XbmcThreads::SystemClockMillis();
+        }
+        m_pDB->start_savepoint(GetSavepointName(m_savepointDepth));
+        m_savepointDepth++;
+      }
+      else
+        m_pDB->start_transaction();
+    }
   }
   catch (...)
   {
@@ -597,7 +697,24 @@ bool CDatabase::CommitTransaction()
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->commit_transaction();
+    {
+      if (m_batchSize > 0 && m_savepointDepth > 0)
+      {
+        m_savepointDepth--;
+        m_pDB->release_savepoint(GetSavepointName(m_savepointDepth));
+      }
+      else if (m_batchSize > 0)
+      {
+        // committing a transaction that wasn't started within the batch,
+        // commit the batch so far
+        if (m_batchOpen)
+          m_pDB->commit_transaction();
+        m_batchOpen = false;
+        m_batchItems = 0;
+      }
+      else
+        m_pDB->commit_transaction();
+    }
   }
   catch (...)
   {
@@ -612,7 +729,23 @@ void CDatabase::RollbackTransaction()
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->rollback_transaction();
+    {
+      if (m_batchSize > 0 && m_savepointDepth > 0)
+      {
+        m_savepointDepth--;
+        m_pDB->rollback_savepoint(GetSavepointName(m_savepointDepth));
+      }
+      else if (m_batchSize > 0)
+      {
+        CLog::Log(LOGWARNING, "database:rollbacktransaction rolling back %u batched items", m_batchItems);
+        if (m_batchOpen)
+          m_pDB->rollback_transaction();
+        m_batchOpen = false;
+        m_batchItems = 0;
+      }
+      else
+        m_pDB->rollback_transaction();
+    }
   }
   catch (...)
   {
@@ -622,10 +755,118 @@ void CDatabase::RollbackTransaction()
 
 bool CDatabase::InTransaction()
 {
-  if (NULL != m_pDB.get()) return false;
+  if (NULL == m_pDB.get()) return false;
   return m_pDB->in_transaction();
 }
 
+bool CDatabase::Checkpoint(bool truncate /* = false */)
+{
+  if (NULL == m_pDB.get() || !m_sqlite || InTransaction())
+    return false;
+
+  try
+  {
+    m_pDB->checkpoint(truncate);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+bool CDatabase::BeginBatch(unsigned int itemsPerBatch)
+{
+  if (m_batchSize > 0 || itemsPerBatch < 2)
+    return false;
+
+  if (NULL == m_pDB.get() || InTransaction())
+    return false;
+
+  m_batchSize = itemsPerBatch;
+  m_batchItems = 0;
+  m_batchStart = XbmcThreads::SystemClockMillis();
+  m_savepointDepth = 0;
+  m_batchOpen = false;
+  return true;
+}
+
+bool CDatabase::BatchItemDone()
+{
+  // nothing to do if we aren't batching or are still within an item
+  if (m_batchSize == 0 || m_savepointDepth > 0)
+    return true;
+
+  m_batchItems++;
+  if (!m_batchOpen || (m_batchItems < m_batchSize &&
+      XbmcThreads::SystemClockMillis() - m_batchStart < BATCH_MAX_DURATION_MS))
+    return true;
+
+  return CommitBatch();
+}
+
+bool CDatabase::FlushBatch()
+{
+  if (m_batchSize == 0 || m_savepointDepth > 0 || !m_batchOpen)
+    return true;
+
+  return CommitBatch();
+}
+
+bool CDatabase::EndBatch(bool commit /* = true */)
+{
+  if (m_batchSize == 0)
+    return true;
+
+  if (m_savepointDepth > 0)
+    CLog::Log(LOGWARNING, "%s - ending batch with %u unfinished transactions", __FUNCTION__, m_savepointDepth);
+
+  bool bReturn = true;
+  if (commit)
+    bReturn = CommitBatch();
+  else if (m_batchOpen)
+  {
+    m_batchSize = 0;
+    RollbackTransaction();
+  }
+
+  m_batchSize = 0;
+  m_savepointDepth = 0;
+  m_batchOpen = false;
+  return bReturn;
+}
+
+bool CDatabase::CommitBatch()
+{
+  if (!m_batchOpen)
+    return true;
+
+  // commit as a regular transaction so derived classes get to see it
+  const unsigned int batchSize = m_batchSize;
+  const unsigned int batchItems = m_batchItems;
+  m_batchSize = 0;
+  m_savepointDepth = 0;
+  m_batchOpen = false;
+
+  bool bReturn = CommitTransaction();
+  if (!bReturn)
+  {
+    CLog::Log(LOGERROR, "%s - failed to commit %u batched items, rolling back", __FUNCTION__, batchItems);
+    RollbackTransaction();
+  }
+
+  // the next write opens a new batch transaction
+  m_batchSize = batchSize;
+  m_batchItems = 0;
+  return bReturn;
+}
+
+std::string CDatabase::GetSavepointName(unsigned int depth) const
+{
+  return StringUtils::Format("kodi_sp%u", depth);
+}
+
 bool CDatabase::CreateDatabase()
 {
   BeginTransaction();
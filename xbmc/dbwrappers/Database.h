@@ -86,6 +86,62 @@ public:
   virtual bool CommitTransaction();
   void RollbackTransaction();
   bool InTransaction();
+
+  /*!
+   * @brief Transfer the content of the write-ahead log into the database file.
+   *        SQLite does this automatically every few commits, an explicit
+   *        checkpoint is only needed after large writes to keep the log small.
+   *        Does nothing for other database types.
+   * @param truncate Whether to truncate the log afterwards. Waits for
+   *        concurrent readers and writers to finish.
+   * @return True if the checkpoint was done, false otherwise.
+   */
+  bool Checkpoint(bool truncate = false);
+
+  /*!
+   * @brief Start grouping writes of multiple items into batch transactions.
+   *        While a batch is active, transactions started by the database
+   *        functions become savepoints within the batch transaction, so a
+   *        failing item is still rolled back on its own. The batch transaction
+   *        is opened by the first write and committed once itemsPerBatch items
+   *        are done (or the batch has been open for too long), on FlushBatch()
+   *        and when EndBatch() is called.
+   * @param itemsPerBatch The number of items to group into one transaction.
+   *        Batching is disabled for values smaller than 2.
+   * @return True if a batch was started, false otherwise.
+   * @sa BatchItemDone, EndBatch
+   */
+  bool BeginBatch(unsigned int itemsPerBatch);
+
+  /*!
+   * @brief Mark an item of the current batch as done, committing the batch
+   *        transaction if it is full. Does nothing if no batch is active.
+   * @return False if committing the batch transaction failed, true otherwise.
+   * @sa BeginBatch, EndBatch
+   */
+  bool BatchItemDone();
+
+  /*!
+   * @brief Commit the items written so far within the current batch, so no
+   *        lock is held while the caller does something slow like an online
+   *        lookup. Does nothing if no batch is active or nothing was written.
+   * @return False if committing the batch transaction failed, true otherwise.
+   * @sa BeginBatch, BatchItemDone
+   */
+  bool FlushBatch();
+
+  /*!
+   * @brief Finish the current batch. Does nothing if no batch is active.
+   * @param commit Whether the pending items should be committed or rolled back.
+   * @return False if committing the batch transaction failed, true otherwise.
+   * @sa BeginBatch, BatchItemDone
+   */
+  bool EndBatch(bool commit = true);
+
+  /*!
+   * @brief Whether writes are currently grouped into batch transactions.
+   */
+  bool InBatch() const { return m_batchSize > 0; }
   void CopyDB(const std::string& latestDb);
   void DropAnalytics();
 
@@ -169,6 +225,18 @@ public:
    */
   bool CommitInsertQueries();
 
+  /*!
+   * @brief Insert multiple rows with as few statements as possible.
+   *        Note that if BeginMultipleExecute() has been called, the
+   *        queries will be queued until CommitMultipleExecute() is called.
+   * @param strStatement The INSERT or REPLACE statement up to and including
+   *        VALUES, e.g. "INSERT INTO tag_link (tag_id, media_id, media_type) VALUES ".
+   * @param rows The PrepareSQL'ed value tuples to insert, e.g. "(1, 2, 'movie')".
+   * @return True if all rows were inserted successfully, false otherwise.
+   * @sa ExecuteQuery
+   */
+  bool ExecuteBulkInsert(const std::string &strStatement, const std::vector<std::string> &rows);
+
   virtual bool GetFilter(CDbUrl &dbUrl, Filter &filter, SortDescription &sorting) { return true; }
   virtual bool BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl);
   virtual bool BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl, SortDescription &sorting);
@@ -225,10 +293,19 @@ protected:
 private:
   void InitSettings(DatabaseSettings &dbSettings);
   void UpdateVersionNumber();
+  bool CommitBatch();
+  std::string GetSavepointName(unsigned int depth) const;
 
   bool m_bMultiWrite; /*!< True if there are any queries in the queue, false otherwise */
   unsigned int m_openCount;
+  std::string m_connectionKey; /*!< Database file of our connection if it's returned to the connection pool on Close() */
 
   bool m_multipleExecute;
   std::vector<std::string> m_multipleQueries;
+
+  unsigned int m_batchSize; /*!< Number of items per batch transaction, 0 if not batching */
+  unsigned int m_batchItems; /*!< Number of items done in the current batch transaction */
+  unsigned int m_batchStart; /*!< Time the current batch transaction was started */
+  unsigned int m_savepointDepth; /*!< Number of open savepoints within the batch transaction */
+  bool m_batchOpen; /*!< True if the batch transaction has been opened by a write */
 };
@@ -63,6 +63,13 @@ MysqlDatabase::~MysqlDatabase() {
   disconnect();
 }
 
+void MysqlDatabase::InitLibrary() {
+  // mysql_init() calls it too, but that isn't thread-safe
+  static const int result = mysql_library_init(0, NULL, NULL);
+  if (result != 0)
+    CLog::Log(LOGERROR, "Unable to initialize the MySQL client library (%d)", result);
+}
+
 Dataset* MysqlDatabase::CreateDataset() const {
    return new MysqlDataset(const_cast<MysqlDatabase*>(this));
 }
@@ -528,6 +535,42 @@ void MysqlDatabase::rollback_transaction() {
   }
 }
 
+void MysqlDatabase::start_savepoint(const std::string &name) {
+  if (active)
+  {
+    std::string sql = "SAVEPOINT " + name;
+    int ret = query_with_reconnect(sql.c_str());
+    if (ret != MYSQL_OK)
+      throw DbErrors("Can't start savepoint '%s' (%d)", name.c_str(), ret);
+  }
+}
+
+void MysqlDatabase::release_savepoint(const std::string &name) {
+  if (active)
+  {
+    std::string sql = "RELEASE SAVEPOINT " + name;
+    int ret = query_with_reconnect(sql.c_str());
+    if (ret != MYSQL_OK)
+      throw DbErrors("Can't release savepoint '%s' (%d)", name.c_str(), ret);
+  }
+}
+
+void MysqlDatabase::rollback_savepoint(const std::string &name) {
+  if (active)
+  {
+    std::string sql = "ROLLBACK TO SAVEPOINT " + name;
+    int ret = query_with_reconnect(sql.c_str());
+    if (ret == MYSQL_OK)
+    {
+      // rolling back to a savepoint keeps it on the stack, so release it as well
+      sql = "RELEASE SAVEPOINT " + name;
+      ret = query_with_reconnect(sql.c_str());
+    }
+    if (ret != MYSQL_OK)
+      throw DbErrors("Can't rollback to savepoint '%s' (%d)", name.c_str(), ret);
+  }
+}
+
 bool MysqlDatabase::exists(void) {
   bool ret = false;
 
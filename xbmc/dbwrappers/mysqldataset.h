@@ -44,6 +44,9 @@ public:
 /* destructor */
   ~MysqlDatabase() override;
 
+/* func. initializes the client library, must be done once before connecting from several threads */
+  static void InitLibrary();
+
   Dataset *CreateDataset() const override;
 
 /* func. returns connection handle with MySQL-server */
@@ -79,6 +82,12 @@ public:
   void commit_transaction() override;
   void rollback_transaction() override;
 
+/* virtual methods for savepoints (nested transactions) */
+
+  void start_savepoint(const std::string &name) override;
+  void release_savepoint(const std::string &name) override;
+  void rollback_savepoint(const std::string &name) override;
+
 /* virtual methods for formatting */
   std::string vprepare(const char *format, va_list args) override;
 
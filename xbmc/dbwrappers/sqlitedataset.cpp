@@ -26,6 +26,8 @@
  *
  **********************************************************************/
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <string>
 
@@ -77,18 +79,59 @@ int callback(void* res_ptr,int ncol, char** result,char** cols)
   return 0;  
 }
 
-static int busy_callback(void*, int busyCount)
+//************* Lock waits ***************************
+
+// back off quickly at first, so short writes don't stall readers for long
+static const unsigned int busy_delays[] = { 1, 2, 5, 10, 15, 20, 25, 25, 25, 50, 50, 100 };
+static const int busy_delay_count = sizeof(busy_delays) / sizeof(busy_delays[0]);
+
+// waits longer than this are logged
+static const unsigned int busy_warn_time = 2000;
+
+static std::atomic<unsigned int> lock_waits(0);
+static std::atomic<unsigned int> lock_wait_time(0);
+static std::atomic<unsigned int> lock_max_wait(0);
+
+int SqliteDatabase::busy_callback(void *db, int busyCount)
 {
-  Sleep(100);
+  SqliteDatabase *sqlite = static_cast<SqliteDatabase*>(db);
+  if (busyCount == 0)
+  {
+    sqlite->busy_wait = 0;
+    lock_waits++;
+  }
+
+  unsigned int delay = busy_delays[std::min(busyCount, busy_delay_count - 1)];
+  Sleep(delay);
+
+  unsigned int waited = sqlite->busy_wait;
+  sqlite->busy_wait += delay;
+  lock_wait_time += delay;
+
+  unsigned int max_wait = lock_max_wait;
+  while (sqlite->busy_wait > max_wait && !lock_max_wait.compare_exchange_weak(max_wait, sqlite->busy_wait)) {}
+
+  if (waited < busy_warn_time && sqlite->busy_wait >= busy_warn_time)
+    CLog::Log(LOGWARNING, "SqliteDatabase: waiting for a lock on %s for more than %u ms", sqlite->db.c_str(), busy_warn_time);
+
   return 1;
 }
 
+sqlite_lock_stats SqliteDatabase::getLockStats() {
+  sqlite_lock_stats stats;
+  stats.waits = lock_waits;
+  stats.wait_time = lock_wait_time;
+  stats.max_wait = lock_max_wait;
+  return stats;
+}
+
 //************* SqliteDatabase implementation ***************
 
 SqliteDatabase::SqliteDatabase() {
 
   active = false;  
   _in_transaction = false;    // for transaction
+  busy_wait = 0;
 
   error = "Unknown database error";//S_NO_CONNECTION;
   host = "localhost";
@@ -219,7 +262,7 @@ int SqliteDatabase::connect(bool create) {
       flags |= SQLITE_OPEN_CREATE;
     if (sqlite3_open_v2(db_fullpath.c_str(), &conn, flags, NULL)==SQLITE_OK)
     {
-      sqlite3_busy_handler(conn, busy_callback, NULL);
+      sqlite3_busy_handler(conn, busy_callback, this);
       char* err=NULL;
       if (setErr(sqlite3_exec(getHandle(),"PRAGMA empty_result_callbacks=ON",NULL,NULL,&err),"PRAGMA empty_result_callbacks=ON") != SQLITE_OK)
       {
@@ -411,6 +454,45 @@ void SqliteDatabase::rollback_transaction() {
   }  
 }
 
+void SqliteDatabase::start_savepoint(const std::string &name) {
+  if (active) {
+    std::string sql = "SAVEPOINT " + name;
+    int rc = sqlite3_exec(conn, sql.c_str(), NULL, NULL, NULL);
+    if (rc != SQLITE_OK)
+      throw DbErrors("Can't start savepoint '%s' (%d)", name.c_str(), rc);
+  }
+}
+
+void SqliteDatabase::release_savepoint(const std::string &name) {
+  if (active) {
+    std::string sql = "RELEASE SAVEPOINT " + name;
+    int rc = sqlite3_exec(conn, sql.c_str(), NULL, NULL, NULL);
+    if (rc != SQLITE_OK)
+      throw DbErrors("Can't release savepoint '%s' (%d)", name.c_str(), rc);
+  }
+}
+
+void SqliteDatabase::rollback_savepoint(const std::string &name) {
+  if (active) {
+    // rolling back to a savepoint keeps it on the stack, so release it as well
+    std::string sql = "ROLLBACK TO SAVEPOINT " + name + "; RELEASE SAVEPOINT " + name;
+    int rc = sqlite3_exec(conn, sql.c_str(), NULL, NULL, NULL);
+    if (rc != SQLITE_OK)
+      throw DbErrors("Can't rollback to savepoint '%s' (%d)", name.c_str(), rc);
+  }
+}
+
+void SqliteDatabase::checkpoint(bool truncate) {
+  if (active) {
+    int log = 0;
+    int checkpointed = 0;
+    int rc = sqlite3_wal_checkpoint_v2(conn, NULL, truncate ? SQLITE_CHECKPOINT_TRUNCATE : SQLITE_CHECKPOINT_PASSIVE, &log, &checkpointed);
+    if (rc != SQLITE_OK && rc != SQLITE_BUSY)
+      throw DbErrors("Can't checkpoint database '%s' (%d)", db.c_str(), rc);
+    CLog::Log(LOGDEBUG, "SqliteDatabase: checkpointed %d of %d WAL frames of %s", checkpointed, log, db.c_str());
+  }
+}
+
 
 // methods for formatting
 // ---------------------------------------------
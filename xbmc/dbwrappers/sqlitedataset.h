@@ -33,6 +33,13 @@
 #include <sqlite3.h>
 
 namespace dbiplus {
+/* statistics about lock waits, collected over all connections */
+struct sqlite_lock_stats {
+  unsigned int waits;     // number of times a statement had to wait for a lock
+  unsigned int wait_time; // total time spent waiting in ms
+  unsigned int max_wait;  // longest single wait in ms
+};
+
 /***************** Class SqliteDatabase definition ******************
 
        class 'SqliteDatabase' connects with Sqlite-server
@@ -44,6 +51,10 @@ protected:
   sqlite3 *conn;
   bool _in_transaction;
   int last_err;
+/* time the current lock wait has taken so far */
+  unsigned int busy_wait;
+
+  static int busy_callback(void *db, int busyCount);
 
 public:
 /* default constructor */
@@ -91,6 +102,18 @@ public:
   void commit_transaction() override;
   void rollback_transaction() override;
 
+/* virtual methods for savepoints (nested transactions) */
+
+  void start_savepoint(const std::string &name) override;
+  void release_savepoint(const std::string &name) override;
+  void rollback_savepoint(const std::string &name) override;
+
+/* transfers the write-ahead log into the database, optionally truncating the log */
+  void checkpoint(bool truncate) override;
+
+/* returns the lock wait statistics of all connections */
+  static sqlite_lock_stats getLockStats();
+
 /* virtual methods for formatting */
   std::string vprepare(const char *format, va_list args) override;
 
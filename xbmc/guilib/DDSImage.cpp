@@ -19,6 +19,8 @@
  */
 
 #include <algorithm>
+#include <climits>
+#include <cstdlib>
 #include "DDSImage.h"
 #include "XBTF.h"
 #include "utils/log.h"
@@ -115,6 +117,184 @@ bool CDDSImage::ReadFile(const std::string &inputFile)
   return true;
 }
 
+bool CDDSImage::WriteFile(const std::string &outputFile) const
+{
+  if (!m_data)
+    return false;
+
+  // open the file
+  CFile file;
+  if (!file.OpenForWrite(outputFile, true))
+    return false;
+
+  // write the header
+  file.Write("DDS ", 4);
+  file.Write(&m_desc, sizeof(m_desc));
+  // now the data
+  bool success = file.Write(m_data, m_desc.linearSize) == static_cast<ssize_t>(m_desc.linearSize);
+  file.Close();
+  return success;
+}
+
+bool CDDSImage::Compress(unsigned int width, unsigned int height, unsigned int pitch, const unsigned char *brga, unsigned int format)
+{
+  if (!brga || !width || !height || (format != XB_FMT_DXT1 && format != XB_FMT_DXT5))
+    return false;
+
+  Allocate(width, height, format);
+
+  unsigned char *dest = m_data;
+  unsigned char block[16 * 4];
+  for (unsigned int y = 0; y < height; y += 4)
+  {
+    for (unsigned int x = 0; x < width; x += 4)
+    {
+      // gather the 4x4 block, repeating the last row and column at the edges
+      for (unsigned int by = 0; by < 4; by++)
+      {
+        const unsigned char *src = brga + std::min(y + by, height - 1) * pitch;
+        for (unsigned int bx = 0; bx < 4; bx++)
+          memcpy(block + (by * 4 + bx) * 4, src + std::min(x + bx, width - 1) * 4, 4);
+      }
+
+      if (format == XB_FMT_DXT5)
+      {
+        CompressAlphaBlock(block, dest);
+        dest += 8;
+      }
+      CompressColorBlock(block, dest);
+      dest += 8;
+    }
+  }
+  return true;
+}
+
+static uint16_t ToRGB565(const unsigned char *bgr)
+{
+  return ((bgr[2] >> 3) << 11) | ((bgr[1] >> 2) << 5) | (bgr[0] >> 3);
+}
+
+static void FromRGB565(uint16_t color, int *bgr)
+{
+  int r = (color >> 11) & 0x1f;
+  int g = (color >> 5) & 0x3f;
+  int b = color & 0x1f;
+  bgr[0] = (b << 3) | (b >> 2);
+  bgr[1] = (g << 2) | (g >> 4);
+  bgr[2] = (r << 3) | (r >> 2);
+}
+
+void CDDSImage::CompressColorBlock(const unsigned char *block, unsigned char *dest)
+{
+  // use the bounding box of the colors, inset a little to reduce the error of the interpolated colors
+  unsigned char minColor[3] = { 255, 255, 255 };
+  unsigned char maxColor[3] = { 0, 0, 0 };
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    for (unsigned int c = 0; c < 3; c++)
+    {
+      minColor[c] = std::min(minColor[c], block[i * 4 + c]);
+      maxColor[c] = std::max(maxColor[c], block[i * 4 + c]);
+    }
+  }
+  for (unsigned int c = 0; c < 3; c++)
+  {
+    int inset = (maxColor[c] - minColor[c]) >> 4;
+    minColor[c] += inset;
+    maxColor[c] -= inset;
+  }
+
+  uint16_t color0 = ToRGB565(maxColor);
+  uint16_t color1 = ToRGB565(minColor);
+  // color0 > color1 selects the four color mode
+  if (color0 < color1)
+    std::swap(color0, color1);
+
+  uint32_t indices = 0;
+  if (color0 != color1)
+  {
+    int palette[4][3];
+    FromRGB565(color0, palette[0]);
+    FromRGB565(color1, palette[1]);
+    for (unsigned int c = 0; c < 3; c++)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for (unsigned int i = 0; i < 16; i++)
+    {
+      int best = 0;
+      int bestError = INT_MAX;
+      for (int p = 0; p < 4; p++)
+      {
+        int error = 0;
+        for (unsigned int c = 0; c < 3; c++)
+        {
+          int d = block[i * 4 + c] - palette[p][c];
+          error += d * d;
+        }
+        if (error < bestError)
+        {
+          best = p;
+          bestError = error;
+        }
+      }
+      indices |= best << (i * 2);
+    }
+  }
+
+  dest[0] = color0 & 0xff;
+  dest[1] = color0 >> 8;
+  dest[2] = color1 & 0xff;
+  dest[3] = color1 >> 8;
+  for (unsigned int i = 0; i < 4; i++)
+    dest[4 + i] = (indices >> (i * 8)) & 0xff;
+}
+
+void CDDSImage::CompressAlphaBlock(const unsigned char *block, unsigned char *dest)
+{
+  int minAlpha = 255;
+  int maxAlpha = 0;
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    minAlpha = std::min(minAlpha, static_cast<int>(block[i * 4 + 3]));
+    maxAlpha = std::max(maxAlpha, static_cast<int>(block[i * 4 + 3]));
+  }
+
+  // alpha0 > alpha1 selects the eight value mode
+  uint64_t indices = 0;
+  if (maxAlpha != minAlpha)
+  {
+    int palette[8];
+    palette[0] = maxAlpha;
+    palette[1] = minAlpha;
+    for (int p = 1; p < 7; p++)
+      palette[p + 1] = ((7 - p) * maxAlpha + p * minAlpha) / 7;
+
+    for (unsigned int i = 0; i < 16; i++)
+    {
+      int best = 0;
+      int bestError = INT_MAX;
+      for (int p = 0; p < 8; p++)
+      {
+        int error = std::abs(block[i * 4 + 3] - palette[p]);
+        if (error < bestError)
+        {
+          best = p;
+          bestError = error;
+        }
+      }
+      indices |= static_cast<uint64_t>(best) << (i * 3);
+    }
+  }
+
+  dest[0] = maxAlpha;
+  dest[1] = minAlpha;
+  for (unsigned int i = 0; i < 6; i++)
+    dest[2 + i] = (indices >> (i * 8)) & 0xff;
+}
+
 unsigned int CDDSImage::GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format)
 {
   switch (format)
@@ -37,11 +37,24 @@ public:
   unsigned char *GetData() const;
 
   bool ReadFile(const std::string &file);
+  bool WriteFile(const std::string &file) const;
+
+  /*! \brief Compress an image to a DXT format
+   \param width, height the size of the image
+   \param pitch the row size of the image in bytes
+   \param brga the image, 4 bytes per pixel in BGRA order
+   \param format the format to compress to, XB_FMT_DXT1 (no alpha) or XB_FMT_DXT5
+   \return true if the image was compressed, false otherwise.
+   */
+  bool Compress(unsigned int width, unsigned int height, unsigned int pitch, const unsigned char *brga, unsigned int format);
 
 private:
   void Allocate(unsigned int width, unsigned int height, unsigned int format);
   static const char *GetFourCC(unsigned int format);
 
+  static void CompressColorBlock(const unsigned char *block, unsigned char *dest);
+  static void CompressAlphaBlock(const unsigned char *block, unsigned char *dest);
+
   static unsigned int GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format);
   enum {
     ddsd_caps        = 0x00000001,
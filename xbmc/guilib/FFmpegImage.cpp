@@ -24,6 +24,7 @@
 #include "guilib/Texture.h"
 
 #include <algorithm>
+#include <cstring>
 
 extern "C"
 {
@@ -133,6 +134,103 @@ static int64_t mem_file_seek(void *h, int64_t pos, int whence)
   return mbuf->pos;
 }
 
+// the EXIF orientation (1-8) stored in an APP1 segment, 0 if there is none
+static unsigned int GetExifOrientation(const unsigned char* segment, size_t size)
+{
+  // "Exif\0\0", then a TIFF header pointing to the first IFD
+  if (size < 14 || memcmp(segment, "Exif\0\0", 6) != 0)
+    return 0;
+
+  const unsigned char* tiff = segment + 6;
+  size_t tiffSize = size - 6;
+  bool motorola = tiff[0] == 'M';
+  if (!motorola && tiff[0] != 'I')
+    return 0;
+
+  auto get16 = [tiff, motorola](size_t offset) -> unsigned int
+  {
+    return motorola ? (tiff[offset] << 8) | tiff[offset + 1] : tiff[offset] | (tiff[offset + 1] << 8);
+  };
+  auto get32 = [get16, motorola](size_t offset) -> size_t
+  {
+    return motorola ? ((size_t)get16(offset) << 16) | get16(offset + 2) : get16(offset) | ((size_t)get16(offset + 2) << 16);
+  };
+
+  size_t ifd = get32(4);
+  if (ifd + 2 > tiffSize)
+    return 0;
+
+  unsigned int entries = get16(ifd);
+  for (unsigned int i = 0; i < entries; i++)
+  {
+    size_t entry = ifd + 2 + i * 12;
+    if (entry + 12 > tiffSize)
+      return 0;
+    if (get16(entry) == 0x0112) // orientation, a short stored in the entry itself
+    {
+      unsigned int orientation = get16(entry + 8);
+      return orientation <= 8 ? orientation : 0;
+    }
+  }
+  return 0;
+}
+
+// get the size of a baseline or extended sequential jpeg from its frame header,
+// and its EXIF orientation if that comes first as usual
+static bool GetJpegSize(const unsigned char* buffer, unsigned int bufSize, unsigned int &width, unsigned int &height,
+                        unsigned int &orientation)
+{
+  orientation = 0;
+  size_t pos = 2; // skip SOI
+  while (pos + 4 <= bufSize)
+  {
+    if (buffer[pos] != 0xFF)
+      return false;
+
+    uint8_t marker = buffer[pos + 1];
+    if (marker == 0xFF)
+    { // fill byte
+      pos++;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD9))
+    { // markers without a segment
+      pos += 2;
+      continue;
+    }
+    if (marker == 0xE1 && orientation == 0)
+    {
+      size_t length = (buffer[pos + 2] << 8) | buffer[pos + 3];
+      if (length >= 2 && pos + 2 + length <= bufSize)
+        orientation = GetExifOrientation(buffer + pos + 4, length - 2);
+    }
+    if (marker == 0xC0 || marker == 0xC1)
+    {
+      if (pos + 9 > bufSize)
+        return false;
+      height = (buffer[pos + 5] << 8) | buffer[pos + 6];
+      width = (buffer[pos + 7] << 8) | buffer[pos + 8];
+      return width > 0 && height > 0;
+    }
+    // progressive, lossless or arithmetic coded frames, or the scan started without a frame header
+    if ((marker >= 0xC2 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) || marker == 0xDA)
+      return false;
+
+    pos += 2 + ((buffer[pos + 2] << 8) | buffer[pos + 3]);
+  }
+  return false;
+}
+
+// the largest DCT scaling (as a power of 2) that keeps the image at least as large as the target size
+static int GetLowres(unsigned int imageWidth, unsigned int imageHeight, unsigned int width, unsigned int height, int maxLowres)
+{
+  double scale = std::min(1.0, std::min((double)width / imageWidth, (double)height / imageHeight));
+  int lowres = 0;
+  while (lowres < maxLowres && (1 << (lowres + 1)) * scale <= 1.0)
+    lowres++;
+  return lowres;
+}
+
 CFFmpegImage::CFFmpegImage(const std::string& strMimeType) : m_strMimeType(strMimeType)
 {
   m_hasAlpha = false;
@@ -162,7 +260,7 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
                                       unsigned int width, unsigned int height)
 {
 
-  if (!Initialize(buffer, bufSize))
+  if (!Initialize(buffer, bufSize, width, height))
   {
     //log
     return false;
@@ -174,7 +272,7 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
   return !(m_pFrame == nullptr);
 }
 
-bool CFFmpegImage::Initialize(unsigned char* buffer, unsigned int bufSize)
+bool CFFmpegImage::Initialize(unsigned char* buffer, unsigned int bufSize, unsigned int width, unsigned int height)
 {
   int bufferSize = 4096;
   uint8_t* fbuffer = (uint8_t*)av_malloc(bufferSize + FF_INPUT_BUFFER_PADDING_SIZE);
@@ -269,6 +367,22 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, unsigned int bufSize)
     return false;
   }
 
+  // decoding a thumbnail from a large jpeg at full size is a waste of time and memory,
+  // the decoder can skip the high frequencies and produce a 1/2, 1/4 or 1/8 sized image
+  unsigned int imageWidth, imageHeight, orientation;
+  if (is_jpeg && width > 0 && height > 0 && codec->id == AV_CODEC_ID_MJPEG &&
+      GetJpegSize(buffer, bufSize, imageWidth, imageHeight, orientation))
+  {
+    // the target size is given upright, the image is turned by 90 or 270 degrees
+    // (orientations 5 to 8) after decoding
+    if (orientation >= 5)
+      m_codec_ctx->lowres = GetLowres(imageHeight, imageWidth, width, height, codec->max_lowres);
+    else
+      m_codec_ctx->lowres = GetLowres(imageWidth, imageHeight, width, height, codec->max_lowres);
+    m_originalWidth = imageWidth;
+    m_originalHeight = imageHeight;
+  }
+
   if (avcodec_open2(m_codec_ctx, codec, NULL) < 0)
   {
     avformat_close_input(&m_fctx);
@@ -313,8 +427,11 @@ AVFrame* CFFmpegImage::ExtractFrame()
   av_frame_set_pkt_duration(frame, av_rescale_q(frame->pkt_duration, m_fctx->streams[0]->time_base, AVRational{ 1, 1000 }));
   m_height = frame->height;
   m_width = frame->width;
-  m_originalWidth = m_width;
-  m_originalHeight = m_height;
+  if (!m_codec_ctx->lowres)
+  {
+    m_originalWidth = m_width;
+    m_originalHeight = m_height;
+  }
 
   const AVPixFmtDescriptor* pixDescriptor = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
   if (pixDescriptor && ((pixDescriptor->flags & (AV_PIX_FMT_FLAG_ALPHA | AV_PIX_FMT_FLAG_PAL)) != 0))
@@ -488,8 +605,8 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
 
   // assumption quadratic maximums e.g. 2048x2048
   float ratio = m_width / (float)m_height;
-  unsigned int nHeight = m_originalHeight;
-  unsigned int nWidth = m_originalWidth;
+  unsigned int nHeight = frame->height;
+  unsigned int nWidth = frame->width;
   if (nHeight > height)
   {
     nHeight = height;
@@ -501,7 +618,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     nHeight = (unsigned int)(nWidth / ratio + 0.5f);
   }
 
-  struct SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat,
+  struct SwsContext* context = sws_getContext(frame->width, frame->height, pixFormat,
     nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
 
   if (range == AVCOL_RANGE_JPEG)
@@ -514,7 +631,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
   }
 
-  sws_scale(context, frame->data, frame->linesize, 0, m_originalHeight,
+  sws_scale(context, frame->data, frame->linesize, 0, frame->height,
     pictureRGB->data, pictureRGB->linesize);
   sws_freeContext(context);
 
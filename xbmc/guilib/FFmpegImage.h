@@ -81,7 +81,12 @@ public:
                                   unsigned int &bufferoutSize) override;
   void ReleaseThumbnailBuffer() override;
 
-  bool Initialize(unsigned char* buffer, unsigned int bufSize);
+  /*!
+   \brief Open the image for decoding
+   \param width, height the size the image is going to be scaled down to, 0 to decode it at full size.
+   Baseline jpegs are decoded at 1/2, 1/4 or 1/8 of their size if that is still large enough.
+   */
+  bool Initialize(unsigned char* buffer, unsigned int bufSize, unsigned int width = 0, unsigned int height = 0);
 
   std::shared_ptr<Frame> ReadFrame();
 
@@ -45,6 +45,8 @@ CGUIBaseContainer::CGUIBaseContainer(int parentID, int controlID, float posX, fl
 {
   m_cursor = 0;
   m_offset = 0;
+  m_cursorMoved = false;
+  m_dirtyItemsOnly = false;
   m_lastHoldTime = 0;
   m_itemsPerPage = 10;
   m_pageControl = 0;
@@ -96,6 +98,7 @@ void CGUIBaseContainer::Process(unsigned int currentTime, CDirtyRegionList &dirt
   if (!m_layout || !m_focusedLayout) return;
 
   UpdateScrollOffset(currentTime);
+  PrepareCursorDirtyRegions(dirtyregions);
 
   int offset = (int)floorf(m_scroller.GetValue() / m_layout->Size(m_orientation));
 
@@ -198,6 +201,20 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
       item->GetLayout()->Process(item.get(), m_parentID, currentTime, dirtyregions);
   }
 
+  if (focused || (m_dirtyItemsOnly && item == m_lastFocusedItem))
+  {
+    // cover both layouts, the item switches between them when the cursor moves
+    CRect region = g_graphicsContext.generateAABB(CRect(0, 0, m_layout->Size(HORIZONTAL), m_layout->Size(VERTICAL)));
+    if (item->GetLayout())
+      region.Union(item->GetLayout()->GetRenderRegion());
+    if (item->GetFocusedLayout())
+      region.Union(item->GetFocusedLayout()->GetRenderRegion());
+    if (focused)
+      m_focusedItemRegion = region;
+    if (m_dirtyItemsOnly)
+      dirtyregions.push_back(CDirtyRegion(region));
+  }
+
   g_graphicsContext.RestoreOrigin();
 }
 
@@ -1345,14 +1362,16 @@ int CGUIBaseContainer::GetCurrentPage() const
 
 void CGUIBaseContainer::GetCacheOffsets(int &cacheBefore, int &cacheAfter) const
 {
+  // while scrolling, always prefetch the next row so its images are loaded
+  // in the background before it scrolls into view
   if (m_scroller.IsScrollingDown())
   {
     cacheBefore = 0;
-    cacheAfter = m_cacheItems;
+    cacheAfter = std::max(m_cacheItems, 1);
   }
   else if (m_scroller.IsScrollingUp())
   {
-    cacheBefore = m_cacheItems;
+    cacheBefore = std::max(m_cacheItems, 1);
     cacheAfter = 0;
   }
   else
@@ -1365,10 +1384,38 @@ void CGUIBaseContainer::GetCacheOffsets(int &cacheBefore, int &cacheAfter) const
 void CGUIBaseContainer::SetCursor(int cursor)
 {
   if (m_cursor != cursor)
-    MarkDirtyRegion();
+    m_cursorMoved = true; // marked dirty in PrepareCursorDirtyRegions
   m_cursor = cursor;
 }
 
+void CGUIBaseContainer::PrepareCursorDirtyRegions(CDirtyRegionList &dirtyregions)
+{
+  CRect lastRegion = m_focusedItemRegion;
+  m_focusedItemRegion = CRect();
+  m_lastFocusedItem = m_lastItem;
+  m_dirtyItemsOnly = false;
+
+  if (!m_cursorMoved)
+    return;
+  m_cursorMoved = false;
+
+  // scrolling or a layout change redraws everything anyway
+  if (m_controlDirtyState & DIRTY_STATE_CONTROL)
+    return;
+
+  // a focused item of a different size moves the items after it
+  if (m_layout->Size(HORIZONTAL) != m_focusedLayout->Size(HORIZONTAL) ||
+      m_layout->Size(VERTICAL) != m_focusedLayout->Size(VERTICAL))
+  {
+    MarkDirtyRegion();
+    return;
+  }
+
+  m_dirtyItemsOnly = true;
+  if (!lastRegion.IsEmpty())
+    dirtyregions.push_back(CDirtyRegion(lastRegion));
+}
+
 void CGUIBaseContainer::SetOffset(int offset)
 {
   if (m_offset != offset)
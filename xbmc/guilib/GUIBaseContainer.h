@@ -164,6 +164,12 @@ protected:
   void SetContainerMoving(int direction);
   void UpdateScrollOffset(unsigned int currentTime);
 
+  /*! \brief Work out how a cursor move is redrawn, called before the items are processed.
+   As long as nothing else in the container changed and focused and unfocused items have
+   the same size, only the previously and the newly focused items are marked dirty.
+   */
+  void PrepareCursorDirtyRegions(CDirtyRegionList &dirtyregions);
+
   CScroller m_scroller;
 
   IListProvider *m_listProvider;
@@ -220,6 +226,10 @@ private:
 
   int m_cursor;
   int m_offset;
+  bool m_cursorMoved;
+  bool m_dirtyItemsOnly;           ///< only the focused items are dirty this frame
+  CGUIListItemPtr m_lastFocusedItem;
+  CRect m_focusedItemRegion;       ///< screen region of the focused item, last frame
   int m_cacheItems;
   CStopWatch m_scrollTimer;
   CStopWatch m_lastScrollStartTimer;
@@ -24,6 +24,7 @@
 #include "addons/Skin.h"
 #include "GUIFontTTF.h"
 #include "GUIFont.h"
+#include "GUITextLayoutCache.h"
 #include "utils/XMLUtils.h"
 #include "GUIControlFactory.h"
 #include "filesystem/Directory.h"
@@ -235,6 +236,9 @@ void GUIFontManager::ReloadTTFFonts(void)
 
     font->SetFont(pFontFile);
   }
+
+  // text was laid out with the old font sizes
+  CGUITextLayoutCache::GetInstance().Flush();
 }
 
 void GUIFontManager::Unload(const std::string& strFontName)
@@ -243,6 +247,7 @@ void GUIFontManager::Unload(const std::string& strFontName)
   {
     if (StringUtils::EqualsNoCase((*iFont)->GetFontName(), strFontName))
     {
+      CGUITextLayoutCache::GetInstance().Flush();
       delete (*iFont);
       m_vecFonts.erase(iFont);
       return;
@@ -256,6 +261,7 @@ void GUIFontManager::FreeFontFile(CGUIFontTTFBase *pFont)
   {
     if (pFont == *it)
     {
+      CGUITextLayoutCache::GetInstance().Flush();
       m_vecFontFiles.erase(it);
       delete pFont;
       return;
@@ -324,6 +330,8 @@ CGUIFont* GUIFontManager::GetDefaultFont(bool border)
 
 void GUIFontManager::Clear()
 {
+  CGUITextLayoutCache::GetInstance().Flush();
+
   for (int i = 0; i < (int)m_vecFonts.size(); ++i)
   {
     CGUIFont* pFont = m_vecFonts[i];
@@ -0,0 +1,88 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "GUIFrameProfiler.h"
+#include "filesystem/File.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+using namespace XbmcThreads;
+
+std::atomic<bool> CGUIFrameProfiler::m_running(false);
+
+CGUIFrameProfiler::CGUIFrameProfiler()
+  : m_frame(0),
+    m_frameStart(0),
+    m_mainThread(0),
+    m_maxFrameCount(200)
+{
+}
+
+CGUIFrameProfiler &CGUIFrameProfiler::GetInstance()
+{
+  static CGUIFrameProfiler instance;
+  return instance;
+}
+
+void CGUIFrameProfiler::Start(const std::string &outputFile)
+{
+  if (IsRunning())
+    return;
+
+  m_outputFile = outputFile;
+  m_frame = 0;
+  m_frameStart = SystemClockNanos();
+  m_mainThread = (uint64_t)CThread::GetCurrentThreadId();
+  m_running.store(true, std::memory_order_release);
+  CTrace::Start();
+}
+
+void CGUIFrameProfiler::EndFrame()
+{
+  if (!IsRunning())
+    return;
+
+  int64_t now = SystemClockNanos();
+  CTrace::AddSpan("gui", "Frame", m_frameStart, now);
+  m_frameStart = now;
+  CTrace::AddCounter("gui", "frame", ++m_frame);
+
+  if (static_cast<int>(m_frame) >= m_maxFrameCount)
+  {
+    CTrace::Stop();
+    m_running = false;
+    if (!SaveResults())
+      CLog::Log(LOGERROR, "CGUIFrameProfiler: unable to write %s", m_outputFile.c_str());
+  }
+}
+
+bool CGUIFrameProfiler::SaveResults() const
+{
+  if (m_outputFile.empty())
+    return false;
+
+  std::string json = CTrace::ExportChromeTrace(m_mainThread);
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(m_outputFile, true))
+    return false;
+
+  return file.Write(json.c_str(), json.size()) == static_cast<ssize_t>(json.size());
+}
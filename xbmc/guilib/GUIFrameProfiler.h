@@ -0,0 +1,82 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+#include "threads/Trace.h"
+
+/*!
+ \ingroup guilib
+ \brief Records a timeline of the GUI frames, exported as Chrome trace JSON.
+
+ Timed sections are marked with CGUIFrameProfilerScope, or any other
+ XbmcThreads::CTraceScope. The profiler runs the trace recorder for the given
+ number of frames, marking every frame, then stops it and writes the timeline,
+ which can be loaded in chrome://tracing or https://ui.perfetto.dev to get a
+ flame graph per frame.
+ */
+class CGUIFrameProfiler
+{
+public:
+  static CGUIFrameProfiler &GetInstance();
+  static bool IsRunning() { return m_running.load(std::memory_order_acquire); }
+
+  /*! \brief Start recording
+   \param outputFile the file the timeline is written to once done
+   */
+  void Start(const std::string &outputFile);
+
+  /*! \brief Mark the end of a frame, called by the application after rendering.
+   Stops and saves the results once the maximum frame count is reached.
+   */
+  void EndFrame();
+
+  int GetMaxFrameCount() const { return m_maxFrameCount; }
+  void SetMaxFrameCount(int maxFrameCount) { m_maxFrameCount = maxFrameCount; }
+
+  bool SaveResults() const;
+
+private:
+  CGUIFrameProfiler();
+  CGUIFrameProfiler(const CGUIFrameProfiler&) = delete;
+  CGUIFrameProfiler& operator=(const CGUIFrameProfiler&) = delete;
+
+  static std::atomic<bool> m_running;
+
+  unsigned int m_frame;
+  int64_t m_frameStart;
+  uint64_t m_mainThread;
+  int m_maxFrameCount;
+  std::string m_outputFile;
+};
+
+/*!
+ \ingroup guilib
+ \brief Times the enclosing scope in the "gui" trace category, does nothing unless tracing is running.
+ \param name the name of the section, must be a string literal
+ */
+class CGUIFrameProfilerScope : public XbmcThreads::CTraceScope
+{
+public:
+  explicit CGUIFrameProfilerScope(const char *name) : CTraceScope("gui", name) {}
+};
@@ -45,6 +45,7 @@ void CGUIPanelContainer::Process(unsigned int currentTime, CDirtyRegionList &dir
   if (!m_layout || !m_focusedLayout) return;
 
   UpdateScrollOffset(currentTime);
+  PrepareCursorDirtyRegions(dirtyregions);
 
   int offset = (int)(m_scroller.GetValue() / m_layout->Size(m_orientation));
 
@@ -22,6 +22,8 @@
 #include "GUIFont.h"
 #include "GUIControl.h"
 #include "GUIColorManager.h"
+#include "GUIFrameProfiler.h"
+#include "GUITextLayoutCache.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
 
@@ -238,6 +240,22 @@ bool CGUITextLayout::UpdateW(const std::wstring &text, float maxWidth /*= 0*/, b
 
 void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool forceLTRReadingOrder)
 {
+  CGUIFrameProfilerScope profile("CGUITextLayout::Update");
+
+  // the same labels are laid out over and over again, e.g. while scrolling lists
+  CGUITextLayoutCache::Key key = { m_font, m_textColor, m_wrap && maxWidth > 0 ? maxWidth : 0, m_maxHeight,
+                                   g_graphicsContext.GetGUIScaleX(), g_graphicsContext.GetGUIScaleY(),
+                                   forceLTRReadingOrder, text };
+  CGUITextLayoutCache::Layout layout;
+  if (m_font && CGUITextLayoutCache::GetInstance().Get(key, layout))
+  {
+    m_lines.swap(layout.lines);
+    m_colors.swap(layout.colors);
+    m_textWidth = layout.width;
+    m_textHeight = layout.height;
+    return;
+  }
+
   // parse the text for style information
   vecText parsedText;
   vecColors colors;
@@ -245,10 +263,21 @@ void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool
 
   // and update
   UpdateStyled(parsedText, colors, maxWidth, forceLTRReadingOrder);
+
+  if (m_font)
+  {
+    layout.lines = m_lines;
+    layout.colors = m_colors;
+    layout.width = m_textWidth;
+    layout.height = m_textHeight;
+    CGUITextLayoutCache::GetInstance().Add(key, std::move(layout));
+  }
 }
 
 void CGUITextLayout::UpdateStyled(const vecText &text, const vecColors &colors, float maxWidth, bool forceLTRReadingOrder)
 {
+  CGUIFrameProfilerScope profile("CGUITextLayout::UpdateStyled");
+
   // empty out our previous string
   m_lines.clear();
   m_colors = colors;
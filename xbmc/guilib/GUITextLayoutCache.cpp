@@ -0,0 +1,110 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "GUITextLayoutCache.h"
+#include "threads/SingleLock.h"
+
+#include <functional>
+#include <utility>
+
+bool CGUITextLayoutCache::Key::operator==(const Key &right) const
+{
+  return font == right.font &&
+         textColor == right.textColor &&
+         maxWidth == right.maxWidth &&
+         maxHeight == right.maxHeight &&
+         scaleX == right.scaleX &&
+         scaleY == right.scaleY &&
+         forceLTRReadingOrder == right.forceLTRReadingOrder &&
+         text == right.text;
+}
+
+size_t CGUITextLayoutCache::KeyHash::operator()(const Key &key) const
+{
+  size_t hash = std::hash<std::wstring>()(key.text);
+  hash ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash ^= std::hash<float>()(key.maxWidth) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+CGUITextLayoutCache::CGUITextLayoutCache()
+  : m_size(0)
+{
+}
+
+CGUITextLayoutCache &CGUITextLayoutCache::GetInstance()
+{
+  static CGUITextLayoutCache instance;
+  return instance;
+}
+
+bool CGUITextLayoutCache::Get(const Key &key, Layout &layout)
+{
+  CSingleLock lock(m_critSection);
+  auto it = m_index.find(key);
+  if (it == m_index.end())
+    return false;
+
+  // move to the front of the list
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  layout = it->second->layout;
+  return true;
+}
+
+void CGUITextLayoutCache::Add(const Key &key, Layout layout)
+{
+  size_t size = GetSize(key, layout);
+  if (size > TEXT_LAYOUT_CACHE_SIZE / 16)
+    return; // not worth evicting everything else for
+
+  CSingleLock lock(m_critSection);
+  if (m_index.find(key) != m_index.end())
+    return;
+
+  while (!m_entries.empty() && m_size + size > TEXT_LAYOUT_CACHE_SIZE)
+  {
+    m_size -= m_entries.back().size;
+    m_index.erase(m_entries.back().key);
+    m_entries.pop_back();
+  }
+
+  Entry entry = { key, std::move(layout), size };
+  m_entries.push_front(std::move(entry));
+  m_index.insert(std::make_pair(key, m_entries.begin()));
+  m_size += size;
+}
+
+void CGUITextLayoutCache::Flush()
+{
+  CSingleLock lock(m_critSection);
+  m_index.clear();
+  m_entries.clear();
+  m_size = 0;
+}
+
+size_t CGUITextLayoutCache::GetSize(const Key &key, const Layout &layout)
+{
+  // the key is stored twice, in the list and the index
+  size_t size = sizeof(Entry) + 2 * (sizeof(Key) + key.text.size() * sizeof(wchar_t));
+  size += layout.colors.size() * sizeof(color_t);
+  for (const auto &line : layout.lines)
+    size += sizeof(CGUIString) + line.m_text.size() * sizeof(character_t);
+  return size;
+}
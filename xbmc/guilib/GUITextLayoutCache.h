@@ -0,0 +1,111 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GUITextLayout.h"
+#include "threads/CriticalSection.h"
+
+// upper bound of the memory used by the laid out texts
+#define TEXT_LAYOUT_CACHE_SIZE (4 * 1024 * 1024)
+
+/*!
+ \ingroup strings
+ \brief Cache of laid out texts, shared by all text layouts.
+
+ Parsing the markup, bidi flipping and wrapping a label is expensive compared
+ to rendering it, and list containers lay out the same labels over and over
+ while scrolling. The result of a layout is kept for every combination of font,
+ color, text, wrapping width and GUI scale, the least recently used layouts are evicted
+ once the cache exceeds TEXT_LAYOUT_CACHE_SIZE.
+
+ The cache must be flushed whenever a font is reloaded or deleted.
+ */
+class CGUITextLayoutCache
+{
+public:
+  struct Key
+  {
+    const CGUIFont *font;
+    color_t textColor;
+    float maxWidth;           ///< 0 if not wrapped
+    float maxHeight;          ///< 0 if not wrapped
+    float scaleX;             ///< GUI scale, text widths depend on it
+    float scaleY;             ///< GUI scale, line heights depend on it
+    bool forceLTRReadingOrder;
+    std::wstring text;
+
+    bool operator==(const Key &right) const;
+  };
+
+  struct Layout
+  {
+    std::vector<CGUIString> lines;
+    vecColors colors;
+    float width;
+    float height;
+  };
+
+  static CGUITextLayoutCache &GetInstance();
+
+  /*! \brief Get a cached layout
+   \param key the font, text and dimensions of the layout
+   \param layout [out] the cached layout, if found
+   \return true if the layout was found, false otherwise
+   */
+  bool Get(const Key &key, Layout &layout);
+
+  /*! \brief Add a layout, evicting the least recently used ones if the cache is full
+   */
+  void Add(const Key &key, Layout layout);
+
+  /*! \brief Drop all cached layouts, e.g. after the fonts were reloaded
+   */
+  void Flush();
+
+private:
+  CGUITextLayoutCache();
+  CGUITextLayoutCache(const CGUITextLayoutCache&) = delete;
+  CGUITextLayoutCache& operator=(const CGUITextLayoutCache&) = delete;
+
+  struct KeyHash
+  {
+    size_t operator()(const Key &key) const;
+  };
+
+  struct Entry
+  {
+    Key key;
+    Layout layout;
+    size_t size;
+  };
+  typedef std::list<Entry> EntryList;
+
+  static size_t GetSize(const Key &key, const Layout &layout);
+
+  CCriticalSection m_critSection;
+  EntryList m_entries; ///< most recently used first
+  std::unordered_map<Key, EntryList::iterator, KeyHash> m_index;
+  size_t m_size;
+};
@@ -122,6 +122,10 @@ public:
   bool IsAllocated() const { return m_isAllocated != NO; };
   bool FailedToAlloc() const { return m_isAllocated == NORMAL_FAILED || m_isAllocated == LARGE_FAILED; };
   bool ReadyToRender() const;
+
+  /*! \brief Draw any textures the implementation is holding back to batch them, see CGUITextureGL::Flush
+   */
+  static void Flush() {};
 protected:
   bool CalculateSize();
   void LoadDiffuseImage();
@@ -28,10 +28,23 @@
 
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
+CGUITextureGL::BatchState CGUITextureGL::m_batchState;
+std::vector<CGUITextureGL::PackedVertex> CGUITextureGL::m_batchVertices;
+std::vector<GLushort> CGUITextureGL::m_batchIndices;
+bool CGUITextureGL::m_flushing = false;
+
+bool CGUITextureGL::BatchState::operator==(const BatchState &right) const
+{
+  return shader == right.shader &&
+         texture == right.texture &&
+         diffuse == right.diffuse &&
+         blend == right.blend &&
+         memcmp(col, right.col, sizeof(col)) == 0;
+}
+
 CGUITextureGL::CGUITextureGL(float posX, float posY, float width, float height, const CTextureInfo &texture)
 : CGUITextureBase(posX, posY, width, height, texture)
 {
-  memset(m_col, 0, sizeof(m_col));
 }
 
 void CGUITextureGL::Begin(color_t color)
@@ -41,118 +54,128 @@ void CGUITextureGL::Begin(color_t color)
   if (m_diffuse.size())
     m_diffuse.m_textures[0]->LoadToGPU();
 
-  texture->BindToUnit(0);
+  BatchState state;
+  state.texture = static_cast<CGLTexture*>(texture)->GetTextureObject();
+  state.diffuse = 0;
 
   // Setup Colors
-  m_col[0] = (GLubyte)GET_R(color);
-  m_col[1] = (GLubyte)GET_G(color);
-  m_col[2] = (GLubyte)GET_B(color);
-  m_col[3] = (GLubyte)GET_A(color);
+  state.col[0] = (GLubyte)GET_R(color);
+  state.col[1] = (GLubyte)GET_G(color);
+  state.col[2] = (GLubyte)GET_B(color);
+  state.col[3] = (GLubyte)GET_A(color);
 
   if (g_Windowing.UseLimitedColor())
   {
-    m_col[0] = (235 - 16) * m_col[0] / 255 + 16.0f / 255.0f;
-    m_col[1] = (235 - 16) * m_col[1] / 255 + 16.0f / 255.0f;
-    m_col[2] = (235 - 16) * m_col[2] / 255 + 16.0f / 255.0f;
+    state.col[0] = (235 - 16) * state.col[0] / 255 + 16.0f / 255.0f;
+    state.col[1] = (235 - 16) * state.col[1] / 255 + 16.0f / 255.0f;
+    state.col[2] = (235 - 16) * state.col[2] / 255 + 16.0f / 255.0f;
   }
 
-  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || m_col[3] < 255;
+  bool opaque = state.col[0] == 255 && state.col[1] == 255 && state.col[2] == 255 && state.col[3] == 255;
+  state.blend = texture->HasAlpha() || state.col[3] < 255;
 
   if (m_diffuse.size())
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255 )
-    {
-      g_Windowing.EnableShader(SM_MULTI);
-    }
-    else
-    {
-      g_Windowing.EnableShader(SM_MULTI_BLENDCOLOR);
-    }
-
-    hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
-
-    m_diffuse.m_textures[0]->BindToUnit(1);
+    state.shader = opaque ? SM_MULTI : SM_MULTI_BLENDCOLOR;
+    state.diffuse = static_cast<CGLTexture*>(m_diffuse.m_textures[0])->GetTextureObject();
+    state.blend |= m_diffuse.m_textures[0]->HasAlpha();
   }
   else
-  {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255)
-    {
-      g_Windowing.EnableShader(SM_TEXTURE_NOBLEND);
-    }
-    else
-    {
-      g_Windowing.EnableShader(SM_TEXTURE);
-    }
-  }
+    state.shader = opaque ? SM_TEXTURE_NOBLEND : SM_TEXTURE;
 
-  if (hasAlpha)
-  {
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-    glEnable(GL_BLEND);
-  }
-  else
-  {
-    glDisable(GL_BLEND);
-  }
-  m_packedVertices.clear();
-  m_idx.clear();
+  // consecutive textures drawn the same way are merged into a single draw call
+  if (!m_batchVertices.empty() && !(state == m_batchState))
+    Flush();
+  m_batchState = state;
 }
 
 void CGUITextureGL::End()
 {
-  if (m_packedVertices.size())
-  {
-    GLint posLoc  = g_Windowing.ShaderGetPos();
-    GLint tex0Loc = g_Windowing.ShaderGetCoord0();
-    GLint tex1Loc = g_Windowing.ShaderGetCoord1();
-    GLint uniColLoc = g_Windowing.ShaderGetUniCol();
+  // the quads are drawn with the next flush of the batch
+}
 
-    GLuint VertexVBO;
-    GLuint IndexVBO;
+void CGUITextureGL::Flush()
+{
+  if (m_batchVertices.empty() || m_flushing)
+    return;
 
-    glGenBuffers(1, &VertexVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VertexVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex)*m_packedVertices.size(), &m_packedVertices[0], GL_STATIC_DRAW);
+  m_flushing = true;
 
-    if (uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
+  // the batch is usually flushed while someone else is setting up to draw,
+  // keep the textures and blending they configured
+  CRenderSystemGL::GUIState previous = g_Windowing.GetGUIState();
 
-    if (m_diffuse.size())
-    {
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), BUFFER_OFFSET(offsetof(PackedVertex, u2)));
-      glEnableVertexAttribArray(tex1Loc);
-    }
+  const BatchState &state = m_batchState;
+  g_Windowing.BindTexture(state.texture, 0);
+  if (state.diffuse)
+    g_Windowing.BindTexture(state.diffuse, 1);
 
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex), BUFFER_OFFSET(offsetof(PackedVertex, x)));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), BUFFER_OFFSET(offsetof(PackedVertex, u1)));
-    glEnableVertexAttribArray(tex0Loc);
+  g_Windowing.EnableShader(static_cast<ESHADERMETHOD>(state.shader));
 
-    glGenBuffers(1, &IndexVBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IndexVBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(ushort)*m_idx.size(), m_idx.data(), GL_STATIC_DRAW);
+  if (state.blend)
+  {
+    g_Windowing.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+    g_Windowing.SetBlending(true);
+  }
+  else
+  {
+    g_Windowing.SetBlending(false);
+  }
 
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, 0);
+  GLint posLoc  = g_Windowing.ShaderGetPos();
+  GLint tex0Loc = g_Windowing.ShaderGetCoord0();
+  GLint tex1Loc = g_Windowing.ShaderGetCoord1();
+  GLint uniColLoc = g_Windowing.ShaderGetUniCol();
 
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
+  GLuint VertexVBO;
+  GLuint IndexVBO;
 
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
+  glGenBuffers(1, &VertexVBO);
+  glBindBuffer(GL_ARRAY_BUFFER, VertexVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex)*m_batchVertices.size(), &m_batchVertices[0], GL_STATIC_DRAW);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glDeleteBuffers(1, &VertexVBO);
-    glDeleteBuffers(1, &IndexVBO);
+  if (uniColLoc >= 0)
+  {
+    glUniform4f(uniColLoc,(state.col[0] / 255.0f), (state.col[1] / 255.0f), (state.col[2] / 255.0f), (state.col[3] / 255.0f));
   }
 
-  if (m_diffuse.size())
-    glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_BLEND);
+  if (state.diffuse)
+  {
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), BUFFER_OFFSET(offsetof(PackedVertex, u2)));
+    glEnableVertexAttribArray(tex1Loc);
+  }
+
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex), BUFFER_OFFSET(offsetof(PackedVertex, x)));
+  glEnableVertexAttribArray(posLoc);
+  glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), BUFFER_OFFSET(offsetof(PackedVertex, u1)));
+  glEnableVertexAttribArray(tex0Loc);
+
+  glGenBuffers(1, &IndexVBO);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IndexVBO);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort)*m_batchIndices.size(), m_batchIndices.data(), GL_STATIC_DRAW);
+
+  glDrawElements(GL_TRIANGLES, m_batchIndices.size(), GL_UNSIGNED_SHORT, 0);
+  g_Windowing.AddDrawCall(m_batchVertices.size() / 4);
+
+  if (state.diffuse)
+    glDisableVertexAttribArray(tex1Loc);
+
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glDeleteBuffers(1, &VertexVBO);
+  glDeleteBuffers(1, &IndexVBO);
 
   g_Windowing.DisableShader();
+
+  // restore the previous state, the render system skips what is set already
+  g_Windowing.RestoreGUIState(previous);
+
+  m_batchVertices.clear();
+  m_batchIndices.clear();
+  m_flushing = false;
 }
 
 void CGUITextureGL::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
@@ -227,24 +250,25 @@ void CGUITextureGL::Draw(float *x, float *y, float *z, const CRect &texture, con
     }
   }
 
+  // the indices are 16 bit
+  if (m_batchVertices.size() + 4 > MAX_BATCH_VERTICES)
+    Flush();
+
+  size_t first = m_batchVertices.size();
   for (int i=0; i<4; i++)
   {
     vertices[i].x = x[i];
     vertices[i].y = y[i];
     vertices[i].z = z[i];
-    m_packedVertices.push_back(vertices[i]);
+    m_batchVertices.push_back(vertices[i]);
   }
 
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
+  m_batchIndices.push_back(first+0);
+  m_batchIndices.push_back(first+1);
+  m_batchIndices.push_back(first+2);
+  m_batchIndices.push_back(first+2);
+  m_batchIndices.push_back(first+3);
+  m_batchIndices.push_back(first+0);
 }
 
 void CGUITextureGL::DrawQuad(const CRect &rect, color_t color, CBaseTexture *texture, const CRect *texCoords)
@@ -255,8 +279,8 @@ void CGUITextureGL::DrawQuad(const CRect &rect, color_t color, CBaseTexture *tex
     texture->BindToUnit(0);
   }
 
-  glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
-  glEnable(GL_BLEND);          // Turn Blending On
+  g_Windowing.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  g_Windowing.SetBlending(true);
 
   VerifyGLState();
 
@@ -335,6 +359,7 @@ void CGUITextureGL::DrawQuad(const CRect &rect, color_t color, CBaseTexture *tex
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLubyte)*4, idx, GL_STATIC_DRAW);
   
   glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_BYTE, 0);
+  g_Windowing.AddDrawCall();
 
   glDisableVertexAttribArray(posLoc);
   if (texture)
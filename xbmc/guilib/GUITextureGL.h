@@ -24,20 +24,26 @@
 
 #include "GUITexture.h"
 
+#include <vector>
+
 class CGUITextureGL : public CGUITextureBase
 {
 public:
   CGUITextureGL(float posX, float posY, float width, float height, const CTextureInfo& texture);
   static void DrawQuad(const CRect &coords, color_t color, CBaseTexture *texture = NULL, const CRect *texCoords = NULL);
 
+  /*! \brief Draw the quads of all textures rendered since the last flush.
+   Textures are batched until the render state changes, the render system
+   flushes the batch whenever the state is changed or something else is drawn.
+   */
+  static void Flush();
+
 protected:
   void Begin(color_t color) override;
   void Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation) override;
   void End() override;
 
 private:
-  GLubyte m_col[4];
-
   struct PackedVertex
   {
     float x, y, z;
@@ -45,7 +51,22 @@ private:
     float u2, v2;
   };
 
-  std::vector<PackedVertex> m_packedVertices;
-  std::vector<GLushort> m_idx;
+  struct BatchState
+  {
+    int shader;
+    GLuint texture;
+    GLuint diffuse;
+    GLubyte col[4];
+    bool blend;
+
+    bool operator==(const BatchState &right) const;
+  };
+
+  static const size_t MAX_BATCH_VERTICES = 65536;
+
+  static BatchState m_batchState;
+  static std::vector<PackedVertex> m_batchVertices;
+  static std::vector<GLushort> m_batchIndices;
+  static bool m_flushing;
 };
 
@@ -34,6 +34,20 @@
 #if defined(HAS_GLES)
 
 
+CGUITextureGLES::BatchState CGUITextureGLES::m_batchState;
+PackedVertices CGUITextureGLES::m_batchVertices;
+std::vector<GLushort> CGUITextureGLES::m_batchIndices;
+bool CGUITextureGLES::m_flushing = false;
+
+bool CGUITextureGLES::BatchState::operator==(const BatchState &right) const
+{
+  return shader == right.shader &&
+         texture == right.texture &&
+         diffuse == right.diffuse &&
+         blend == right.blend &&
+         memcmp(col, right.col, sizeof(col)) == 0;
+}
+
 CGUITextureGLES::CGUITextureGLES(float posX, float posY, float width, float height, const CTextureInfo &texture)
 : CGUITextureBase(posX, posY, width, height, texture)
 {
@@ -46,93 +60,104 @@ void CGUITextureGLES::Begin(color_t color)
   if (m_diffuse.size())
     m_diffuse.m_textures[0]->LoadToGPU();
 
-  texture->BindToUnit(0);
+  BatchState state;
+  state.texture = static_cast<CGLTexture*>(texture)->GetTextureObject();
+  state.diffuse = 0;
 
   // Setup Colors
-  m_col[0] = (GLubyte)GET_R(color);
-  m_col[1] = (GLubyte)GET_G(color);
-  m_col[2] = (GLubyte)GET_B(color);
-  m_col[3] = (GLubyte)GET_A(color);
+  state.col[0] = (GLubyte)GET_R(color);
+  state.col[1] = (GLubyte)GET_G(color);
+  state.col[2] = (GLubyte)GET_B(color);
+  state.col[3] = (GLubyte)GET_A(color);
 
-  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || m_col[3] < 255;
+  bool opaque = state.col[0] == 255 && state.col[1] == 255 && state.col[2] == 255 && state.col[3] == 255;
+  state.blend = texture->HasAlpha() || state.col[3] < 255;
 
   if (m_diffuse.size())
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255 )
-    {
-      g_Windowing.EnableGUIShader(SM_MULTI);
-    }
-    else
-    {
-      g_Windowing.EnableGUIShader(SM_MULTI_BLENDCOLOR);
-    }
+    state.shader = opaque ? SM_MULTI : SM_MULTI_BLENDCOLOR;
+    state.diffuse = static_cast<CGLTexture*>(m_diffuse.m_textures[0])->GetTextureObject();
+    state.blend |= m_diffuse.m_textures[0]->HasAlpha();
+  }
+  else
+    state.shader = opaque ? SM_TEXTURE_NOBLEND : SM_TEXTURE;
 
-    hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
+  // consecutive textures drawn the same way are merged into a single draw call
+  if (!m_batchVertices.empty() && !(state == m_batchState))
+    Flush();
+  m_batchState = state;
+}
 
-    m_diffuse.m_textures[0]->BindToUnit(1);
+void CGUITextureGLES::End()
+{
+  // the quads are drawn with the next flush of the batch
+}
+
+void CGUITextureGLES::Flush()
+{
+  if (m_batchVertices.empty() || m_flushing)
+    return;
+
+  m_flushing = true;
+
+  // the batch is usually flushed while someone else is setting up to draw,
+  // keep the textures and blending they configured
+  CRenderSystemGLES::GUIState previous = g_Windowing.GetGUIState();
 
+  const BatchState &state = m_batchState;
+  g_Windowing.BindTexture(state.texture, 0);
+  if (state.diffuse)
+    g_Windowing.BindTexture(state.diffuse, 1);
+
+  g_Windowing.EnableGUIShader(static_cast<ESHADERMETHOD>(state.shader));
+
+  if (state.blend)
+  {
+    g_Windowing.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+    g_Windowing.SetBlending(true);
   }
   else
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255)
-    {
-      g_Windowing.EnableGUIShader(SM_TEXTURE_NOBLEND);
-    }
-    else
-    {
-      g_Windowing.EnableGUIShader(SM_TEXTURE);
-    }
+    g_Windowing.SetBlending(false);
   }
 
-  if ( hasAlpha )
+  GLint posLoc  = g_Windowing.GUIShaderGetPos();
+  GLint tex0Loc = g_Windowing.GUIShaderGetCoord0();
+  GLint tex1Loc = g_Windowing.GUIShaderGetCoord1();
+  GLint uniColLoc = g_Windowing.GUIShaderGetUniCol();
+
+  if(uniColLoc >= 0)
   {
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-    glEnable( GL_BLEND );
+    glUniform4f(uniColLoc,(state.col[0] / 255.0f), (state.col[1] / 255.0f), (state.col[2] / 255.0f), (state.col[3] / 255.0f));
   }
-  else
+
+  if(state.diffuse)
   {
-    glDisable(GL_BLEND);
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_batchVertices[0] + offsetof(PackedVertex, u2));
+    glEnableVertexAttribArray(tex1Loc);
   }
-  m_packedVertices.clear();
-}
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_batchVertices[0] + offsetof(PackedVertex, x));
+  glEnableVertexAttribArray(posLoc);
+  glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_batchVertices[0] + offsetof(PackedVertex, u1));
+  glEnableVertexAttribArray(tex0Loc);
 
-void CGUITextureGLES::End()
-{
-  if (m_packedVertices.size())
-  {
-    GLint posLoc  = g_Windowing.GUIShaderGetPos();
-    GLint tex0Loc = g_Windowing.GUIShaderGetCoord0();
-    GLint tex1Loc = g_Windowing.GUIShaderGetCoord1();
-    GLint uniColLoc = g_Windowing.GUIShaderGetUniCol();
+  glDrawElements(GL_TRIANGLES, m_batchIndices.size(), GL_UNSIGNED_SHORT, m_batchIndices.data());
+  g_Windowing.AddDrawCall(m_batchVertices.size() / 4);
 
-    if(uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
+  if (state.diffuse)
+    glDisableVertexAttribArray(tex1Loc);
 
-    if(m_diffuse.size())
-    {
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u2));
-      glEnableVertexAttribArray(tex1Loc);
-    }
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, x));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u1));
-    glEnableVertexAttribArray(tex0Loc);
-
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, m_idx.data());
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
 
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
+  g_Windowing.DisableGUIShader();
 
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
-  }
+  // restore the previous state, the render system skips what is set already
+  g_Windowing.RestoreGUIState(previous);
 
-  if (m_diffuse.size())
-    glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_BLEND);
-  g_Windowing.DisableGUIShader();
+  m_batchVertices.clear();
+  m_batchIndices.clear();
+  m_flushing = false;
 }
 
 void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
@@ -201,24 +226,25 @@ void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, c
     }
   }
 
+  // the indices are 16 bit
+  if (m_batchVertices.size() + 4 > MAX_BATCH_VERTICES)
+    Flush();
+
+  size_t first = m_batchVertices.size();
   for (int i=0; i<4; i++)
   {
     vertices[i].x = x[i];
     vertices[i].y = y[i];
     vertices[i].z = z[i];
-    m_packedVertices.push_back(vertices[i]);
+    m_batchVertices.push_back(vertices[i]);
   }
 
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
+  m_batchIndices.push_back(first+0);
+  m_batchIndices.push_back(first+1);
+  m_batchIndices.push_back(first+2);
+  m_batchIndices.push_back(first+2);
+  m_batchIndices.push_back(first+3);
+  m_batchIndices.push_back(first+0);
 }
 
 void CGUITextureGLES::DrawQuad(const CRect &rect, color_t color, CBaseTexture *texture, const CRect *texCoords)
@@ -229,8 +255,8 @@ void CGUITextureGLES::DrawQuad(const CRect &rect, color_t color, CBaseTexture *t
     texture->BindToUnit(0);
   }
 
-  glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
-  glEnable(GL_BLEND);          // Turn Blending On
+  g_Windowing.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  g_Windowing.SetBlending(true);
 
   VerifyGLState();
 
@@ -280,6 +306,7 @@ void CGUITextureGLES::DrawQuad(const CRect &rect, color_t color, CBaseTexture *t
     tex[2][1] = tex[3][1] = coords.y2;
   }
   glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_BYTE, idx);
+  g_Windowing.AddDrawCall();
 
   glDisableVertexAttribArray(posLoc);
   if (texture)
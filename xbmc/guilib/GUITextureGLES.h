@@ -46,15 +46,34 @@ class CGUITextureGLES : public CGUITextureBase
 public:
   CGUITextureGLES(float posX, float posY, float width, float height, const CTextureInfo& texture);
   static void DrawQuad(const CRect &coords, color_t color, CBaseTexture *texture = NULL, const CRect *texCoords = NULL);
+
+  /*! \brief Draw the quads of all textures rendered since the last flush.
+   \sa CGUITextureGL::Flush
+   */
+  static void Flush();
 protected:
   void Begin(color_t color);
   void Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation);
   void End();
 
-  GLubyte m_col[4];
+private:
+  struct BatchState
+  {
+    int shader;
+    GLuint texture;
+    GLuint diffuse;
+    GLubyte col[4];
+    bool blend;
+
+    bool operator==(const BatchState &right) const;
+  };
+
+  static const size_t MAX_BATCH_VERTICES = 65536;
 
-  PackedVertices m_packedVertices;
-  std::vector<GLushort> m_idx;
+  static BatchState m_batchState;
+  static PackedVertices m_batchVertices;
+  static std::vector<GLushort> m_batchIndices;
+  static bool m_flushing;
 };
 
 #endif
@@ -168,7 +168,19 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", strPath.c_str());
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  // windows loaded every time reuse the resolved xml until one of the include conditions changes
+  if (m_loadType != LOAD_EVERY_TIME)
+    return Load(Prepare(m_windowXMLRootElement).get());
+
+  if (!m_preparedXMLRootElement || g_infoManager.ConditionsChangedValues(m_xmlIncludeConditions))
+  {
+    m_xmlIncludeConditions.clear();
+    m_preparedXMLRootElement = Prepare(m_windowXMLRootElement);
+  }
+  else
+    CLog::Log(LOGDEBUG, "Using already resolved xml for %s", strPath.c_str());
+
+  return Load(m_preparedXMLRootElement.get());
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(TiXmlElement *pRootElement)
@@ -827,6 +839,7 @@ void CGUIWindow::FreeResources(bool forceUnload /*= FALSE */)
   {
     delete m_windowXMLRootElement;
     m_windowXMLRootElement = nullptr;
+    m_preparedXMLRootElement.reset();
     m_xmlIncludeConditions.clear();
   }
 }
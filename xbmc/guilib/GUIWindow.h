@@ -310,6 +310,7 @@ protected:
   CGUIAction m_unloadActions;
 
   TiXmlElement* m_windowXMLRootElement;
+  std::unique_ptr<TiXmlElement> m_preparedXMLRootElement; ///< \brief resolved xml of windows loaded every time
 
   bool m_manualRunActions;
 
@@ -21,6 +21,7 @@
 #include "GUIWindowManager.h"
 #include "GUIAudioManager.h"
 #include "GUIDialog.h"
+#include "GUIFrameProfiler.h"
 #include "Application.h"
 #include "messaging/ApplicationMessenger.h"
 #include "messaging/helpers/DialogHelper.h"
@@ -1087,6 +1088,7 @@ bool RenderOrderSortFunction(CGUIWindow *first, CGUIWindow *second)
 void CGUIWindowManager::Process(unsigned int currentTime)
 {
   assert(g_application.IsCurrentThread());
+  CGUIFrameProfilerScope profile("CGUIWindowManager::Process");
   CSingleLock lock(g_graphicsContext);
 
   m_dirtyregions.clear();
@@ -1158,6 +1160,7 @@ void CGUIWindowManager::RenderEx() const
 bool CGUIWindowManager::Render()
 {
   assert(g_application.IsCurrentThread());
+  CGUIFrameProfilerScope profile("CGUIWindowManager::Render");
   CSingleExit lock(g_graphicsContext);
 
   CDirtyRegionList dirtyRegions = m_tracker.GetDirtyRegions();
@@ -1229,6 +1232,7 @@ void CGUIWindowManager::AfterRender()
 void CGUIWindowManager::FrameMove()
 {
   assert(g_application.IsCurrentThread());
+  CGUIFrameProfilerScope profile("CGUIWindowManager::FrameMove");
   CSingleLock lock(g_graphicsContext);
 
   if(m_iNested == 0)
@@ -1571,6 +1575,15 @@ bool CGUIWindowManager::IsWindowVisible(const std::string &xmlFile) const
   return IsWindowActive(xmlFile, false);
 }
 
+void CGUIWindowManager::GetActiveWindowState(std::vector<int> &state) const
+{
+  CSingleLock lock(g_graphicsContext);
+  state.clear();
+  state.push_back(GetActiveWindow());
+  for (const auto& window : m_activeDialogs)
+    state.push_back(window->IsAnimating(ANIM_TYPE_WINDOW_CLOSE) ? -window->GetID() : window->GetID());
+}
+
 void CGUIWindowManager::LoadNotOnDemandWindows()
 {
   CSingleLock lock(g_graphicsContext);
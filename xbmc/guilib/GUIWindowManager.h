@@ -200,6 +200,11 @@ public:
   bool IsWindowActive(const std::string &xmlFile, bool ignoreClosing = true) const;
   bool IsWindowVisible(const std::string &xmlFile) const;
   bool IsWindowTopMost(const std::string &xmlFile) const;
+  /*! \brief Get the ids of the active window and dialogs, in the order they were activated.
+   Ids of dialogs that are closing are negated. Used to detect changes of the window state.
+   \param state [out] the window ids
+   */
+  void GetActiveWindowState(std::vector<int> &state) const;
   /*! \brief Checks if the given window is an addon window.
    *
    * \return true if the given window is an addon window, otherwise false.
@@ -27,8 +27,6 @@
 #include "utils/URIUtils.h"
 #include "utils/POUtils.h"
 #include "filesystem/Directory.h"
-#include "threads/SharedSection.h"
-#include "threads/SingleLock.h"
 #include "utils/StringUtils.h"
 
 
@@ -191,24 +189,36 @@ static bool LoadWithFallback(const std::string& path, const std::string& languag
   return true;
 }
 
-CLocalizeStrings::CLocalizeStrings(void) = default;
+CLocalizeStrings::CLocalizeStrings(void)
+  : m_strings(std::make_shared<const Strings>()),
+    m_skinStrings(std::make_shared<const Strings>())
+{
+}
 
 CLocalizeStrings::~CLocalizeStrings(void) = default;
 
+void CLocalizeStrings::Publish(StringTable &table, Strings strings)
+{
+  std::shared_ptr<const Strings> snapshot = std::make_shared<const Strings>(std::move(strings));
+  {
+    CSingleLock lock(m_tablesSection);
+    m_tables.push_back(snapshot);
+  }
+  table.Set(snapshot);
+}
+
 void CLocalizeStrings::ClearSkinStrings()
 {
-  // clear the skin strings
-  CExclusiveLock lock(m_stringsMutex);
-  Clear(31000, 31999);
+  Publish(m_skinStrings, Strings());
 }
 
 bool CLocalizeStrings::LoadSkinStrings(const std::string& path, const std::string& language)
 {
-  //! @todo shouldn't hold lock while loading file
-  CExclusiveLock lock(m_stringsMutex);
-  ClearSkinStrings();
-  // load the skin strings in.
-  return LoadWithFallback(path, language, m_strings);
+  // readers see either all old or all new skin strings
+  Strings strings;
+  bool loaded = LoadWithFallback(path, language, strings);
+  Publish(m_skinStrings, std::move(strings));
+  return loaded;
 }
 
 bool CLocalizeStrings::Load(const std::string& strPathName, const std::string& strLanguage)
@@ -241,40 +251,27 @@ bool CLocalizeStrings::Load(const std::string& strPathName, const std::string& s
   strings[20210].strTranslated = "yard/s";
   strings[20211].strTranslated = "Furlong/Fortnight";
 
-  CExclusiveLock lock(m_stringsMutex);
-  Clear();
-  m_strings = std::move(strings);
+  Publish(m_strings, std::move(strings));
   return true;
 }
 
 const std::string& CLocalizeStrings::Get(uint32_t dwCode) const
 {
-  CSharedLock lock(m_stringsMutex);
-  ciStrings i = m_strings.find(dwCode);
-  if (i == m_strings.end())
+  // the language strings take precedence over the skin strings like they did in a single map
+  for (const StringTable *table : { &m_strings, &m_skinStrings })
   {
-    return StringUtils::Empty;
+    StringTable::CReader strings(*table);
+    ciStrings i = (*strings)->find(dwCode);
+    if (i != (*strings)->end())
+      return i->second.strTranslated;
   }
-  return i->second.strTranslated;
+  return StringUtils::Empty;
 }
 
 void CLocalizeStrings::Clear()
 {
-  CExclusiveLock lock(m_stringsMutex);
-  m_strings.clear();
-}
-
-void CLocalizeStrings::Clear(uint32_t start, uint32_t end)
-{
-  CExclusiveLock lock(m_stringsMutex);
-  iStrings it = m_strings.begin();
-  while (it != m_strings.end())
-  {
-    if (it->first >= start && it->first <= end)
-      m_strings.erase(it++);
-    else
-      ++it;
-  }
+  Publish(m_strings, Strings());
+  Publish(m_skinStrings, Strings());
 }
 
 bool CLocalizeStrings::LoadAddonStrings(const std::string& path, const std::string& language, const std::string& addonId)
@@ -283,23 +280,24 @@ bool CLocalizeStrings::LoadAddonStrings(const std::string& path, const std::stri
   if (!LoadWithFallback(path, language, strings))
     return false;
 
-  CExclusiveLock lock(m_addonStringsMutex);
-  auto it = m_addonStrings.find(addonId);
-  if (it != m_addonStrings.end())
-    m_addonStrings.erase(it);
-
-  return m_addonStrings.emplace(std::string(addonId), std::move(strings)).second;
+  // the strings of the other add-ons are shared with the previous snapshot, not copied
+  std::shared_ptr<const Strings> addonStrings = std::make_shared<const Strings>(std::move(strings));
+  m_addonStrings.Update([&](std::map<std::string, std::shared_ptr<const Strings>> &addons)
+  {
+    addons[addonId] = addonStrings;
+  });
+  return true;
 }
 
 std::string CLocalizeStrings::GetAddonString(const std::string& addonId, uint32_t code)
 {
-  CSharedLock lock(m_addonStringsMutex);
-  auto i = m_addonStrings.find(addonId);
-  if (i == m_addonStrings.end())
+  CReadMostly<std::map<std::string, std::shared_ptr<const Strings>>>::CReader addons(m_addonStrings);
+  auto i = addons->find(addonId);
+  if (i == addons->end())
     return StringUtils::Empty;
 
-  auto j = i->second.find(code);
-  if (j == i->second.end())
+  auto j = i->second->find(code);
+  if (j == i->second->end())
     return StringUtils::Empty;
 
   return j->second.strTranslated;
@@ -28,12 +28,13 @@
  *
  */
 
-#include "threads/CriticalSection.h"
-#include "threads/SharedSection.h"
+#include "threads/ReadMostly.h"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <stdint.h>
+#include <vector>
 
 #include "utils/ILocalizer.h"
 
@@ -69,15 +70,22 @@ public:
   std::string Localize(std::uint32_t code) const override { return Get(code); }
 
 protected:
-  void Clear(uint32_t start, uint32_t end);
+  typedef std::map<uint32_t, LocStr> Strings;
+  typedef Strings::const_iterator ciStrings;
+  typedef Strings::iterator       iStrings;
+  typedef CReadMostly<std::shared_ptr<const Strings>> StringTable;
 
-  std::map<uint32_t, LocStr> m_strings;
-  std::map<std::string, std::map<uint32_t, LocStr>> m_addonStrings;
-  typedef std::map<uint32_t, LocStr>::const_iterator ciStrings;
-  typedef std::map<uint32_t, LocStr>::iterator       iStrings;
+  void Publish(StringTable &table, Strings strings);
 
-  CSharedSection m_stringsMutex;
-  CSharedSection m_addonStringsMutex;
+  // looked up by every label, changed when the language, skin or an add-on is loaded.
+  // The skin strings have a table of their own, so a skin reload doesn't copy the language.
+  StringTable m_strings;
+  StringTable m_skinStrings;
+  CReadMostly<std::map<std::string, std::shared_ptr<const Strings>>> m_addonStrings;
+
+  // Get() returns references into the tables, every table published is kept until destruction
+  CCriticalSection m_tablesSection;
+  std::vector<std::shared_ptr<const Strings>> m_tables;
 };
 
 /*!
@@ -122,7 +122,7 @@ void CBaseTexture::Update(unsigned int width, unsigned int height, unsigned int
   if (pixels == NULL)
     return;
 
-  if (format & XB_FMT_DXT_MASK)
+  if ((format & XB_FMT_DXT_MASK) && !g_Windowing.SupportsDXT())
     return;
 
   Allocate(width, height, format);
@@ -235,7 +235,8 @@ bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned
     if (image.ReadFile(texturePath))
     {
       Update(image.GetWidth(), image.GetHeight(), 0, image.GetFormat(), image.GetData(), false);
-      return true;
+      m_hasAlpha = image.GetFormat() != XB_FMT_DXT1;
+      return m_pixels != nullptr;
     }
     return false;
   }
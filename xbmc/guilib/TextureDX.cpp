@@ -19,6 +19,7 @@
  */
 
 #include "TextureDX.h"
+#include "GUIFrameProfiler.h"
 #include "windowing/WindowingFactory.h"
 #include "utils/log.h"
 
@@ -80,6 +81,7 @@ void CDXTexture::LoadToGPU()
     // nothing to load - probably same image (no change)
     return;
   }
+  CGUIFrameProfilerScope profile("CDXTexture::LoadToGPU");
 
   bool needUpdate = true;
   D3D11_USAGE usage = D3D11_USAGE_DEFAULT;
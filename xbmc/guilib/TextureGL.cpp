@@ -23,6 +23,8 @@
 #include "windowing/WindowingFactory.h"
 #include "utils/log.h"
 #include "utils/GLUtils.h"
+#include "guilib/GUIFrameProfiler.h"
+#include "guilib/GUITexture.h"
 #include "guilib/TextureManager.h"
 #include "settings/AdvancedSettings.h"
 #ifdef TARGET_POSIX
@@ -63,15 +65,22 @@ void CGLTexture::LoadToGPU()
     // nothing to load - probably same image (no change)
     return;
   }
+  CGUIFrameProfilerScope profile("CGLTexture::LoadToGPU");
+
   if (m_texture == 0)
   {
     // Have OpenGL generate a texture object handle for us
     // this happens only one time - the first time the texture is loaded
     CreateTextureObject();
   }
+  else
+  {
+    // the previous image may still be waiting in the batch of GUI textures
+    CGUITexture::Flush();
+  }
 
   // Bind the texture object
-  glBindTexture(GL_TEXTURE_2D, m_texture);
+  g_Windowing.BindTexture(m_texture);
 
   GLenum filter = (m_scalingMethod == TEXTURE_SCALING::NEAREST ? GL_NEAREST : GL_LINEAR);
 
@@ -213,8 +222,7 @@ void CGLTexture::LoadToGPU()
 
 void CGLTexture::BindToUnit(unsigned int unit)
 {
-  glActiveTexture(GL_TEXTURE0 + unit);
-  glBindTexture(GL_TEXTURE_2D, m_texture);
+  g_Windowing.BindTexture(m_texture, unit);
 }
 
 #endif // HAS_GL
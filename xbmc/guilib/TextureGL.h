@@ -40,6 +40,8 @@ public:
   void LoadToGPU() override;
   void BindToUnit(unsigned int unit) override;
 
+  GLuint GetTextureObject() const { return m_texture; }
+
 protected:
   GLuint m_texture;
 };
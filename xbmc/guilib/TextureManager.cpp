@@ -519,7 +519,7 @@ void CGUITextureManager::FreeUnusedTextures(unsigned int timeDelay)
 #if defined(TARGET_DARWIN_IOS)
     if (!g_Windowing.IsBackgrounded() || glIsTexture(m_unusedHwTextures[i]))
 #endif
-      glDeleteTextures(1, (GLuint*) &m_unusedHwTextures[i]);
+      g_Windowing.DeleteTexture(m_unusedHwTextures[i]);
   }
 #endif
   m_unusedHwTextures.clear();
@@ -90,7 +90,7 @@ void CPiTexture::LoadToGPU()
     }
 
     // Bind the texture object
-    glBindTexture(GL_TEXTURE_2D, m_texture);
+    g_Windowing.BindTexture(m_texture);
 
     if (IsMipmapped()) {
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -0,0 +1,115 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "guilib/GUITextLayoutCache.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+CGUITextLayoutCache::Key MakeKey(const std::wstring &text, float scale = 1.0f)
+{
+  CGUITextLayoutCache::Key key = { nullptr, 0xFFFFFFFF, 0, 0, scale, scale, false, text };
+  return key;
+}
+
+CGUITextLayoutCache::Layout MakeLayout(float width)
+{
+  CGUITextLayoutCache::Layout layout;
+  layout.colors.push_back(0xFFFFFFFF);
+  layout.width = width;
+  layout.height = 10;
+  return layout;
+}
+}
+
+class TestGUITextLayoutCache : public testing::Test
+{
+protected:
+  TestGUITextLayoutCache() { CGUITextLayoutCache::GetInstance().Flush(); }
+  ~TestGUITextLayoutCache() override { CGUITextLayoutCache::GetInstance().Flush(); }
+};
+
+TEST_F(TestGUITextLayoutCache, HitAndMiss)
+{
+  CGUITextLayoutCache &cache = CGUITextLayoutCache::GetInstance();
+  CGUITextLayoutCache::Layout layout;
+  EXPECT_FALSE(cache.Get(MakeKey(L"label"), layout));
+
+  cache.Add(MakeKey(L"label"), MakeLayout(42));
+  ASSERT_TRUE(cache.Get(MakeKey(L"label"), layout));
+  EXPECT_EQ(42, layout.width);
+  EXPECT_EQ(1u, layout.colors.size());
+
+  EXPECT_FALSE(cache.Get(MakeKey(L"other label"), layout));
+
+  cache.Flush();
+  EXPECT_FALSE(cache.Get(MakeKey(L"label"), layout));
+}
+
+TEST_F(TestGUITextLayoutCache, ScaleIsPartOfKey)
+{
+  // text is wrapped and measured in scaled units, another window resolution
+  // needs its own layout
+  CGUITextLayoutCache &cache = CGUITextLayoutCache::GetInstance();
+  cache.Add(MakeKey(L"label", 1.0f), MakeLayout(42));
+
+  CGUITextLayoutCache::Layout layout;
+  EXPECT_FALSE(cache.Get(MakeKey(L"label", 1.5f), layout));
+
+  cache.Add(MakeKey(L"label", 1.5f), MakeLayout(63));
+  ASSERT_TRUE(cache.Get(MakeKey(L"label", 1.5f), layout));
+  EXPECT_EQ(63, layout.width);
+  ASSERT_TRUE(cache.Get(MakeKey(L"label", 1.0f), layout));
+  EXPECT_EQ(42, layout.width);
+}
+
+TEST_F(TestGUITextLayoutCache, EvictsLeastRecentlyUsed)
+{
+  // entries of a bit less than 1/20 of the cache, the key is stored twice
+  const size_t length = TEXT_LAYOUT_CACHE_SIZE / 41 / sizeof(wchar_t);
+  auto text = [length](wchar_t c) { return std::wstring(length, c); };
+
+  CGUITextLayoutCache &cache = CGUITextLayoutCache::GetInstance();
+  for (wchar_t c = L'a'; c < L'a' + 20; c++)
+    cache.Add(MakeKey(text(c)), MakeLayout(c));
+
+  // all fit, and 'a' becomes the most recently used
+  CGUITextLayoutCache::Layout layout;
+  for (wchar_t c = L'a'; c < L'a' + 20; c++)
+    EXPECT_TRUE(cache.Get(MakeKey(text(c)), layout));
+  EXPECT_TRUE(cache.Get(MakeKey(text(L'a')), layout));
+
+  cache.Add(MakeKey(text(L'z')), MakeLayout(0));
+  EXPECT_TRUE(cache.Get(MakeKey(text(L'z')), layout));
+  EXPECT_TRUE(cache.Get(MakeKey(text(L'a')), layout));
+  EXPECT_FALSE(cache.Get(MakeKey(text(L'b')), layout));
+  EXPECT_TRUE(cache.Get(MakeKey(text(L'c')), layout));
+}
+
+TEST_F(TestGUITextLayoutCache, SkipsHugeLayouts)
+{
+  CGUITextLayoutCache &cache = CGUITextLayoutCache::GetInstance();
+  const std::wstring text(TEXT_LAYOUT_CACHE_SIZE / 16 / sizeof(wchar_t), L'x');
+  cache.Add(MakeKey(text), MakeLayout(0));
+
+  CGUITextLayoutCache::Layout layout;
+  EXPECT_FALSE(cache.Get(MakeKey(text), layout));
+}
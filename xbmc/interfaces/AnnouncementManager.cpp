@@ -32,11 +32,18 @@
 #include "PlayListPlayer.h"
 #include "ServiceBroker.h"
 
+#include <functional>
+#include <iterator>
+#include <utility>
+
 #define LOOKUP_PROPERTY "database-lookup"
 
 using namespace ANNOUNCEMENT;
 
-CAnnouncementManager::CAnnouncementManager() : CThread("Announce")
+CAnnouncementManager::CAnnouncementManager()
+  : CThread("Announce"),
+    m_coalescedCount(0),
+    m_maxQueueSize(0)
 {
 }
 
@@ -117,13 +124,126 @@ void CAnnouncementManager::Announce(AnnouncementFlag flag, const char *sender, c
   if (item != nullptr)
     announcement.item = CFileItemPtr(new CFileItem(*item));
 
+  announcement.coalesce = CanCoalesce(announcement);
+  announcement.hash = announcement.coalesce ? GetHash(announcement) : 0;
+
   {
-    CSingleLock lock (m_critSection);
-    m_announcementQueue.push_back(announcement);
+    CSingleLock lock (m_queueCritSection);
+
+    if (!announcement.coalesce)
+      m_announcementQueue.push_back(std::move(announcement));
+    else
+    {
+      // the latest announcement wins, it's queued at the end so it still
+      // follows everything announced in between
+      auto range = m_announcementIndex.equal_range(announcement.hash);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (IsEquivalent(*it->second, announcement))
+        {
+          m_announcementQueue.erase(it->second);
+          m_announcementIndex.erase(it);
+          m_coalescedCount++;
+          break;
+        }
+      }
+
+      size_t hash = announcement.hash;
+      m_announcementQueue.push_back(std::move(announcement));
+      m_announcementIndex.insert(std::make_pair(hash, std::prev(m_announcementQueue.end())));
+    }
+    if (m_announcementQueue.size() > m_maxQueueSize)
+      m_maxQueueSize = m_announcementQueue.size();
   }
   m_queueEvent.Set();
 }
 
+bool CAnnouncementManager::CanCoalesce(const CAnnounceData &announcement)
+{
+  // only the library updates a scan repeats, every other announcement reaches
+  // the listeners as sent
+  if (announcement.flag != VideoLibrary && announcement.flag != AudioLibrary)
+    return false;
+
+  return announcement.message == "OnUpdate" || StringUtils::StartsWith(announcement.message, "OnScan");
+}
+
+static size_t HashVariant(const CVariant &variant)
+{
+  size_t hash = std::hash<int>()(variant.type());
+  switch (variant.type())
+  {
+  case CVariant::VariantTypeBoolean:
+    hash ^= std::hash<bool>()(variant.asBoolean()) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    break;
+  case CVariant::VariantTypeInteger:
+  case CVariant::VariantTypeUnsignedInteger:
+    hash ^= std::hash<uint64_t>()(variant.asUnsignedInteger()) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    break;
+  case CVariant::VariantTypeDouble:
+    hash ^= std::hash<double>()(variant.asDouble()) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    break;
+  case CVariant::VariantTypeString:
+    hash ^= std::hash<std::string>()(variant.asString()) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    break;
+  case CVariant::VariantTypeArray:
+    for (auto it = variant.begin_array(); it != variant.end_array(); ++it)
+      hash ^= HashVariant(*it) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    break;
+  case CVariant::VariantTypeObject:
+    for (auto it = variant.begin_map(); it != variant.end_map(); ++it)
+    {
+      hash ^= std::hash<std::string>()(it->first) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      hash ^= HashVariant(it->second) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    break;
+  default:
+    break;
+  }
+  return hash;
+}
+
+size_t CAnnouncementManager::GetHash(const CAnnounceData &announcement)
+{
+  size_t hash = std::hash<int>()(announcement.flag);
+  hash ^= std::hash<std::string>()(announcement.message) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  if (announcement.item != nullptr)
+    hash ^= std::hash<std::string>()(announcement.item->GetPath()) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash ^= HashVariant(announcement.data) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+bool CAnnouncementManager::IsEquivalent(const CAnnounceData &left, const CAnnounceData &right)
+{
+  if (left.flag != right.flag || left.sender != right.sender || left.message != right.message || !(left.data == right.data))
+    return false;
+
+  if (left.item == nullptr || right.item == nullptr)
+    return left.item == right.item;
+
+  // the items are resolved to their database id, type and title when dispatched
+  const CFileItem &a = *left.item;
+  const CFileItem &b = *right.item;
+  if (a.GetPath() != b.GetPath() || a.GetLabel() != b.GetLabel() ||
+      a.HasVideoInfoTag() != b.HasVideoInfoTag() || a.HasMusicInfoTag() != b.HasMusicInfoTag() ||
+      a.HasPVRChannelInfoTag() != b.HasPVRChannelInfoTag() || a.HasPVRRecordingInfoTag() != b.HasPVRRecordingInfoTag() ||
+      a.HasPictureInfoTag() != b.HasPictureInfoTag())
+    return false;
+
+  if (a.HasVideoInfoTag() &&
+      (a.GetVideoInfoTag()->m_iDbId != b.GetVideoInfoTag()->m_iDbId || a.GetVideoInfoTag()->m_type != b.GetVideoInfoTag()->m_type))
+    return false;
+
+  if (a.HasMusicInfoTag() && a.GetMusicInfoTag()->GetDatabaseId() != b.GetMusicInfoTag()->GetDatabaseId())
+    return false;
+
+  if (a.HasPVRChannelInfoTag() && a.GetPVRChannelInfoTag()->ChannelID() != b.GetPVRChannelInfoTag()->ChannelID())
+    return false;
+
+  // anything else we can't compare cheaply is never coalesced
+  return !a.HasPVRRecordingInfoTag();
+}
+
 void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
 {
   CLog::Log(LOGDEBUG, "CAnnouncementManager - Announcement: %s from %s", message, sender);
@@ -289,19 +409,41 @@ void CAnnouncementManager::Process()
 
   while (!m_bStop)
   {
-    CSingleLock lock (m_critSection);
+    CSingleLock lock (m_queueCritSection);
     if (!m_announcementQueue.empty())
     {
-      auto announcement = m_announcementQueue.front();
+      if (m_announcementQueue.front().coalesce)
+      {
+        auto range = m_announcementIndex.equal_range(m_announcementQueue.front().hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+          if (it->second == m_announcementQueue.begin())
+          {
+            m_announcementIndex.erase(it);
+            break;
+          }
+        }
+      }
+
+      CAnnounceData announcement = std::move(m_announcementQueue.front());
       m_announcementQueue.pop_front();
+
+      if (m_announcementQueue.empty() && m_coalescedCount > 0)
+      {
+        CLog::Log(LOGDEBUG, "CAnnouncementManager - %u announcements were replaced by newer ones, up to %zu were queued",
+                  m_coalescedCount, m_maxQueueSize);
+        m_coalescedCount = 0;
+        m_maxQueueSize = 0;
+      }
+
       {
-        CSingleExit ex(m_critSection);
+        CSingleExit ex(m_queueCritSection);
         DoAnnounce(announcement.flag, announcement.sender.c_str(), announcement.message.c_str(), announcement.item, announcement.data);
       }
     }
     else
     {
-      CSingleExit ex(m_critSection);
+      CSingleExit ex(m_queueCritSection);
       m_queueEvent.Wait();
     }
   }
@@ -18,6 +18,8 @@
  *  <http://www.gnu.org/licenses/>.
  *
  */
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 #include "IAnnouncer.h"
@@ -64,8 +66,25 @@ namespace ANNOUNCEMENT
       std::string message;
       CFileItemPtr item;
       CVariant data;
+      bool coalesce;
+      size_t hash;
     };
-    std::list<CAnnounceData> m_announcementQueue;
+    typedef std::list<CAnnounceData> AnnouncementQueue;
+
+    static bool CanCoalesce(const CAnnounceData &announcement);
+    static size_t GetHash(const CAnnounceData &announcement);
+    static bool IsEquivalent(const CAnnounceData &left, const CAnnounceData &right);
+
+    /*! The queue has its own lock so announcing never waits for the
+     listeners, which are called with m_critSection held.
+     A library OnUpdate or OnScan* announcement replaces an equivalent one still
+     waiting in the queue, e.g. the repeated OnUpdate of an item during a scan.
+     All others are delivered as announced. */
+    CCriticalSection m_queueCritSection;
+    AnnouncementQueue m_announcementQueue;
+    std::unordered_multimap<size_t, AnnouncementQueue::iterator> m_announcementIndex;
+    unsigned int m_coalescedCount;
+    size_t m_maxQueueSize;
     CEvent m_queueEvent;
 
   private:
@@ -49,6 +49,9 @@ bool CLanguageInvokerThread::execute(const std::string &script, const std::vecto
   m_script = script;
   m_args = arguments;
 
+  // services run for the whole session, anything else is usually waited for by the user
+  if (m_addon != NULL && m_addon->Type() == ADDON::ADDON_SERVICE)
+    SetRole(XbmcThreads::ThreadRole::BACKGROUND_CPU);
   Create();
   return true;
 }
@@ -23,13 +23,15 @@
 
 namespace INFO
 {
-  InfoBool::InfoBool(const std::string &expression, int context, unsigned int &refreshCounter)
+  InfoBool::InfoBool(const std::string &expression, int context, const InfoSources &sources)
     : m_value(false),
       m_context(context),
       m_listItemDependent(false),
+      m_dependencies(DEPENDENCY_FRAME),
       m_expression(expression),
-      m_refreshCounter(0),
-      m_parentRefreshCounter(refreshCounter)
+      m_evaluated(false),
+      m_stamp(0),
+      m_sources(sources)
   {
     StringUtils::ToLower(m_expression);
   }
@@ -27,6 +27,68 @@ class CGUIListItem;
 
 namespace INFO
 {
+/*!
+ \ingroup info
+ \brief Sources of information an info bool can depend on.
+ Info bools are only re-evaluated once one of the sources they depend on has changed.
+ */
+enum InfoDependency
+{
+  DEPENDENCY_NONE    = 0,      ///< constant, only re-evaluated when all info bools are reset
+  DEPENDENCY_FRAME   = 1 << 0, ///< may change at any time, re-evaluated every frame
+  DEPENDENCY_PLAYER  = 1 << 1, ///< state of the player and the playing item
+  DEPENDENCY_WINDOW  = 1 << 2, ///< active windows and dialogs
+  DEPENDENCY_SETTING = 1 << 3, ///< skin settings
+  DEPENDENCY_TIME    = 1 << 4, ///< wall clock, changes once a second
+  DEPENDENCY_LIBRARY = 1 << 5, ///< content of the libraries
+};
+
+/*!
+ \ingroup info
+ \brief Change counters of the info sources, used to check whether info bools are dirty
+ */
+class InfoSources
+{
+public:
+  InfoSources() : m_reset(0), m_counters() {};
+
+  /*! \brief Mark all info bools depending on one of the given sources as dirty
+   \param dependencies the changed sources, combination of InfoDependency values
+   */
+  void Changed(unsigned int dependencies)
+  {
+    for (unsigned int i = 0; i < SOURCE_COUNT; i++)
+    {
+      if (dependencies & (1 << i))
+        m_counters[i]++;
+    }
+  }
+
+  /*! \brief Mark all info bools as dirty, regardless of their dependencies
+   */
+  void Reset() { m_reset++; }
+
+  /*! \brief Get a stamp that changes whenever one of the given sources changes
+   \param dependencies the sources, combination of InfoDependency values
+   */
+  unsigned int GetStamp(unsigned int dependencies) const
+  {
+    unsigned int stamp = m_reset;
+    for (unsigned int i = 0; dependencies >> i; i++)
+    {
+      if (dependencies & (1 << i))
+        stamp += m_counters[i];
+    }
+    return stamp;
+  }
+
+private:
+  static const unsigned int SOURCE_COUNT = 6;
+
+  unsigned int m_reset;
+  unsigned int m_counters[SOURCE_COUNT];
+};
+
 /*!
  \ingroup info
  \brief Base class, wrapping boolean conditions and expressions
@@ -34,7 +96,7 @@ namespace INFO
 class InfoBool
 {
 public:
-  InfoBool(const std::string &expression, int context, unsigned int &refreshCounter);
+  InfoBool(const std::string &expression, int context, const InfoSources &sources);
   virtual ~InfoBool() = default;
 
   virtual void Initialize() {};
@@ -47,10 +109,15 @@ public:
   {
     if (item && m_listItemDependent)
       Update(item);
-    else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
+    else
     {
-      Update(NULL);
-      m_refreshCounter = m_parentRefreshCounter;
+      unsigned int stamp = m_sources.GetStamp(m_dependencies);
+      if (stamp != m_stamp || !m_evaluated)
+      {
+        Update(NULL);
+        m_stamp = stamp;
+        m_evaluated = true;
+      }
     }
     return m_value;
   }
@@ -78,16 +145,23 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+
+  /*! \brief Get the info sources this info bool depends on
+   \return combination of InfoDependency values
+   */
+  unsigned int GetDependencies() const { return m_dependencies; }
 protected:
 
   bool m_value;                ///< current value
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent;    ///< do not cache if a listitem pointer is given
+  unsigned int m_dependencies; ///< sources the value depends on, set by Initialize()
   std::string  m_expression;   ///< original expression
 
 private:
-  unsigned int m_refreshCounter;
-  unsigned int &m_parentRefreshCounter;
+  bool m_evaluated;
+  unsigned int m_stamp;
+  const InfoSources &m_sources;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
@@ -22,6 +22,7 @@
 #include <stack>
 #include "utils/log.h"
 #include "GUIInfoManager.h"
+#include "guilib/GUIFrameProfiler.h"
 #include <list>
 #include <memory>
 
@@ -30,24 +31,35 @@ using namespace INFO;
 void InfoSingle::Initialize()
 {
   m_condition = g_infoManager.TranslateSingleString(m_expression, m_listItemDependent);
+  m_dependencies = g_infoManager.GetDependencies(m_condition);
+  // the cached value is overwritten when evaluated for an item
+  if (m_listItemDependent)
+    m_dependencies |= DEPENDENCY_FRAME;
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
 {
+  CGUIFrameProfilerScope profile("InfoSingle::Update");
   m_value = g_infoManager.GetBool(m_condition, m_context, item);
 }
 
 void InfoExpression::Initialize()
 {
+  // collected from the operands while parsing
+  m_dependencies = DEPENDENCY_NONE;
   if (!Parse(m_expression))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", m_expression.c_str());
     m_expression_tree = std::make_shared<InfoLeaf>(g_infoManager.Register("false", 0), false);
+    m_dependencies = DEPENDENCY_NONE;
   }
+  if (m_listItemDependent)
+    m_dependencies |= DEPENDENCY_FRAME;
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
+  CGUIFrameProfilerScope profile("InfoExpression::Update");
   m_value = m_expression_tree->Evaluate(item);
 }
 
@@ -246,8 +258,9 @@ bool InfoExpression::Parse(const std::string &expression)
           CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
           return false;
         }
-        /* Propagate any listItem dependency from the operand to the expression */
+        /* Propagate any listItem dependency and the info sources from the operand to the expression */
         m_listItemDependent |= info->ListItemDependent();
+        m_dependencies |= info->GetDependencies();
         nodes.push(std::make_shared<InfoLeaf>(info, invert));
         /* Reuse operand string for next operand */
         operand.clear();
@@ -297,8 +310,9 @@ bool InfoExpression::Parse(const std::string &expression)
       CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
       return false;
     }
-    /* Propagate any listItem dependency from the operand to the expression */
+    /* Propagate any listItem dependency and the info sources from the operand to the expression */
     m_listItemDependent |= info->ListItemDependent();
+    m_dependencies |= info->GetDependencies();
     nodes.push(std::make_shared<InfoLeaf>(info, invert));
   }
   while (!operator_stack.empty())
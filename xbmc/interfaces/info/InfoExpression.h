@@ -34,8 +34,8 @@ namespace INFO
 class InfoSingle : public InfoBool
 {
 public:
-  InfoSingle(const std::string &expression, int context, unsigned int &refreshCounter)
-    : InfoBool(expression, context, refreshCounter) {};
+  InfoSingle(const std::string &expression, int context, const InfoSources &sources)
+    : InfoBool(expression, context, sources) {};
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
@@ -48,8 +48,8 @@ private:
 class InfoExpression : public InfoBool
 {
 public:
-  InfoExpression(const std::string &expression, int context, unsigned int &refreshCounter)
-    : InfoBool(expression, context, refreshCounter) {};
+  InfoExpression(const std::string &expression, int context, const InfoSources &sources)
+    : InfoBool(expression, context, sources) {};
   ~InfoExpression() override = default;
 
   void Initialize() override;
@@ -48,7 +48,7 @@ using namespace MUSIC_INFO;
 using namespace JSONRPC;
 using namespace XFILE;
 
-bool CFileItemHandler::GetField(const std::string &field, const CVariant &info, const CFileItemPtr &item, CVariant &result, bool &fetchedArt, CThumbLoader *thumbLoader /* = NULL */)
+bool CFileItemHandler::GetField(const std::string &field, CVariant &info, const CFileItemPtr &item, CVariant &result, bool &fetchedArt, CThumbLoader *thumbLoader /* = NULL */)
 {
   if (result.isMember(field) && !result[field].empty())
     return true;
@@ -67,7 +67,8 @@ bool CFileItemHandler::GetField(const std::string &field, const CVariant &info,
   // check for serialized values
   if (info.isMember(field) && !info[field].isNull())
   {
-    result[field] = info[field];
+    // info is a throwaway serialization of the item, each field is only taken once
+    result[field] = std::move(info[field]);
     return true;
   }
 
@@ -121,7 +122,7 @@ bool CFileItemHandler::GetField(const std::string &field, const CVariant &info,
           artObj[artIt->first] = CTextureUtils::GetWrappedImageURL(artIt->second);
       }
 
-      result["art"] = artObj;
+      result["art"] = std::move(artObj);
       return true;
     }
     
@@ -379,9 +380,9 @@ void CFileItemHandler::HandleFileItem(const char *ID, bool allowFile, const char
   if (resultname)
   {
     if (append)
-      result[resultname].append(object);
+      result[resultname].append(std::move(object));
     else
-      result[resultname] = object;
+      result[resultname] = std::move(object);
   }
 }
 
@@ -398,14 +398,17 @@ bool CMusicDatabase::AddAlbum(CAlbum& album)
   // Add the album artists
   if (album.artistCredits.empty())
     AddAlbumArtist(BLANKARTIST_ID, album.idAlbum, BLANKARTIST_NAME, 0); // Album must have at least one artist so set artist to [Missing]
+  std::vector<std::string> albumArtists;
   for (auto artistCredit = album.artistCredits.begin(); artistCredit != album.artistCredits.end(); ++artistCredit)
   {
     artistCredit->idArtist = AddArtist(artistCredit->GetArtist(), artistCredit->GetMusicBrainzArtistID(), artistCredit->GetSortName());
-    AddAlbumArtist(artistCredit->idArtist,
-                   album.idAlbum,
-                   artistCredit->GetArtist(),
-                   std::distance(album.artistCredits.begin(), artistCredit));
+    albumArtists.push_back(PrepareSQL("(%i,%i,'%s',%i)",
+                                      artistCredit->idArtist,
+                                      album.idAlbum,
+                                      artistCredit->GetArtist().c_str(),
+                                      static_cast<int>(std::distance(album.artistCredits.begin(), artistCredit))));
   }
+  ExecuteBulkInsert("REPLACE INTO album_artist (idArtist, idAlbum, strArtist, iOrder) VALUES ", albumArtists);
 
   for (auto song = album.songs.begin(); song != album.songs.end(); ++song)
   {
@@ -430,24 +433,26 @@ bool CMusicDatabase::AddAlbum(CAlbum& album)
     if (song->artistCredits.empty())    
       AddSongArtist(BLANKARTIST_ID, song->idSong, ROLE_ARTIST, BLANKARTIST_NAME, 0); // Song must have at least one artist so set artist to [Missing]
     
+    std::vector<std::string> songArtists;
     for (auto artistCredit = song->artistCredits.begin(); artistCredit != song->artistCredits.end(); ++artistCredit)
     {
       artistCredit->idArtist = AddArtist(artistCredit->GetArtist(),
                                          artistCredit->GetMusicBrainzArtistID(),
                                          artistCredit->GetSortName());
-      AddSongArtist(artistCredit->idArtist,
-                    song->idSong,
-                    ROLE_ARTIST,
-                    artistCredit->GetArtist(), // we don't have song artist breakdowns from scrapers, yet
-                    std::distance(song->artistCredits.begin(), artistCredit));
-    }
+      songArtists.push_back(PrepareSQL("(%i,%i,%i,'%s',%i)",
+                                       artistCredit->idArtist,
+                                       song->idSong,
+                                       ROLE_ARTIST,
+                                       artistCredit->GetArtist().c_str(), // we don't have song artist breakdowns from scrapers, yet
+                                       static_cast<int>(std::distance(song->artistCredits.begin(), artistCredit))));
+    }
+    ExecuteBulkInsert("REPLACE INTO song_artist (idArtist, idSong, idRole, strArtist, iOrder) VALUES ", songArtists);
     // Having added artist credits (maybe with MBID) add the other contributing artists (no MBID)
     // and use COMPOSERSORT tag data to provide sort names for artists that are composers
     AddSongContributors(song->idSong, song->GetContributors(), song->GetComposerSort());
   }
 
-  for (const auto &albumArt : album.art)
-    SetArtForItem(album.idAlbum, MediaTypeAlbum, albumArt.first, albumArt.second);
+  SetArtForItem(album.idAlbum, MediaTypeAlbum, album.art);
 
   CommitTransaction();
   return true;
@@ -633,15 +638,24 @@ int CMusicDatabase::AddSong(const int idAlbum,
     if (!strThumb.empty())
       SetArtForItem(idSong, MediaTypeSong, "thumb", strThumb);
 
+    std::vector<std::string> songGenres;
+    std::vector<std::string> albumGenres;
     unsigned int index = 0;
     for (const auto &i : genres)
     {
       // index will be wrong for albums, but ordering is not all that relevant
       // for genres anyway
       int idGenre = AddGenre(i);
-      AddSongGenre(idGenre, idSong, index);
-      AddAlbumGenre(idGenre, idAlbum, index++);
+      if (idGenre == -1)
+        continue;
+      if (idSong != -1)
+        songGenres.push_back(PrepareSQL("(%i,%i,%i)", idGenre, idSong, index));
+      if (idAlbum != -1)
+        albumGenres.push_back(PrepareSQL("(%i,%i,%i)", idGenre, idAlbum, index));
+      index++;
     }
+    ExecuteBulkInsert("REPLACE INTO song_genre (idGenre, idSong, iOrder) VALUES ", songGenres);
+    ExecuteBulkInsert("REPLACE INTO album_genre (idGenre, idAlbum, iOrder) VALUES ", albumGenres);
 
     UpdateFileDateAdded(idSong, strPathAndFileName);
 
@@ -5978,7 +5992,9 @@ bool CMusicDatabase::CommitTransaction()
 {
   if (CDatabase::CommitTransaction())
   { // number of items in the db has likely changed, so reset the infomanager cache
-    g_infoManager.SetLibraryBool(LIBRARY_HAS_MUSIC, GetSongsCount() > 0);
+    // (unless this only finished an item within a batch transaction)
+    if (!InTransaction())
+      g_infoManager.SetLibraryBool(LIBRARY_HAS_MUSIC, GetSongsCount() > 0);
     return true;
   }
   return false;
@@ -6606,8 +6622,41 @@ void CMusicDatabase::SetPropertiesForFileItem(CFileItem& item)
 
 void CMusicDatabase::SetArtForItem(int mediaId, const std::string &mediaType, const std::map<std::string, std::string> &art)
 {
-  for (const auto &i : art)
-    SetArtForItem(mediaId, mediaType, i.first, i.second);
+  try
+  {
+    if (NULL == m_pDB.get()) return;
+    if (NULL == m_pDS.get()) return;
+
+    // fetch the existing art in one go, update it and insert the rest at once
+    std::map<std::string, int> existing;
+    std::string sql = PrepareSQL("SELECT type,art_id FROM art WHERE media_id=%i AND media_type='%s'", mediaId, mediaType.c_str());
+    m_pDS->query(sql);
+    while (!m_pDS->eof())
+    {
+      existing[m_pDS->fv(0).get_asString()] = m_pDS->fv(1).get_asInt();
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    std::vector<std::string> rows;
+    for (const auto &i : art)
+    {
+      // don't set <foo>.<bar> art types - these are derivative types from parent items
+      if (i.first.find('.') != std::string::npos)
+        continue;
+
+      const auto it = existing.find(i.first);
+      if (it == existing.end())
+        rows.push_back(PrepareSQL("(%d, '%s', '%s', '%s')", mediaId, mediaType.c_str(), i.first.c_str(), i.second.c_str()));
+      else
+        m_pDS->exec(PrepareSQL("UPDATE art SET url='%s' where art_id=%d", i.second.c_str(), it->second));
+    }
+    ExecuteBulkInsert("INSERT INTO art(media_id, media_type, type, url) VALUES ", rows);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s(%d, '%s') failed", __FUNCTION__, mediaId, mediaType.c_str());
+  }
 }
 
 void CMusicDatabase::SetArtForItem(int mediaId, const std::string &mediaType, const std::string &artType, const std::string &url)
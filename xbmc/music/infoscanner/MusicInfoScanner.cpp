@@ -24,6 +24,7 @@
 #include <utility>
 
 #include "ServiceBroker.h"
+#include "DatabaseManager.h"
 #include "addons/AddonManager.h"
 #include "addons/AddonSystemSettings.h"
 #include "addons/Scraper.h"
@@ -82,6 +83,7 @@ CMusicInfoScanner::CMusicInfoScanner()
   m_itemCount=0;
   m_flags = 0;
   m_bClean = false;
+  SetRole(XbmcThreads::ThreadRole::BACKGROUND_IO);
 }
 
 CMusicInfoScanner::~CMusicInfoScanner() = default;
@@ -110,6 +112,8 @@ void CMusicInfoScanner::Process()
     }
     
     unsigned int tick = XbmcThreads::SystemClockMillis();
+    unsigned int lockWaits, lockWaitTime, maxLockWait;
+    CDatabaseManager::GetInstance().GetLockWaits(lockWaits, lockWaitTime, maxLockWait);
     m_musicDatabase.Open();
     m_bCanInterrupt = true;
 
@@ -151,7 +155,11 @@ void CMusicInfoScanner::Process()
           continue;
         }
 
+        // group the writes of the scanned albums into larger transactions,
+        // committed before online scraping as that may take a while
+        m_musicDatabase.BeginBatch(g_advancedSettings.m_iMusicLibraryScanBatchSize);
         bool scancomplete = DoScan(*it);
+        m_musicDatabase.EndBatch();
         if (scancomplete)
         {// Finally download additional album and artist information for the recently added albums
           if ((m_flags & SCAN_ONLINE) && m_albumsAdded.size() > 0)
@@ -188,9 +196,17 @@ void CMusicInfoScanner::Process()
       m_fileCountReader.StopThread();
 
       m_musicDatabase.EmptyCache();
+
+      // keep the write-ahead log from growing with every scan
+      m_musicDatabase.Checkpoint(true);
       
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGNOTICE, "My Music: Scanning for music info using worker thread, operation took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
+
+      unsigned int waits, waitTime;
+      CDatabaseManager::GetInstance().GetLockWaits(waits, waitTime, maxLockWait);
+      CLog::Log(LOGDEBUG, "My Music: %u database lock waits taking %u ms during scan, longest wait since startup %u ms",
+                waits - lockWaits, waitTime - lockWaitTime, maxLockWait);
     }
     if (m_scanType == 1) // load album info
     {
@@ -851,6 +867,7 @@ int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileI
 
     album->strPath = strDirectory;
     m_musicDatabase.AddAlbum(*album);
+    m_musicDatabase.BatchItemDone();
     m_albumsAdded.emplace_back(album->idAlbum);
 
     // Yuk - this is a kludgy way to do what we want to do, but it will work to sort
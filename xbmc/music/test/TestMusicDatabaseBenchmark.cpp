@@ -0,0 +1,214 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FileItem.h"
+#include "music/MusicDatabase.h"
+#include "music/MusicDbUrl.h"
+#include "settings/AdvancedSettings.h"
+#include "test/LibraryBenchmark.h"
+#include "utils/StringUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace
+{
+// library size at --set-benchmark-scale 1.0
+const unsigned int FULL_SONGS = 1000000;
+const unsigned int FULL_ARTISTS = 20000;
+
+const unsigned int SONGS_PER_ALBUM = 10;
+const unsigned int GENRES = 60;
+const unsigned int PAGE_SIZE = 500;
+
+unsigned int Next(unsigned int &seed, unsigned int range)
+{
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) % range;
+}
+
+std::string GetSongsUrl(const std::string &option, const std::string &value)
+{
+  CMusicDbUrl url;
+  url.FromString("musicdb://songs/");
+  url.AddOption("singles", false);
+  if (!option.empty())
+    url.AddOption(option, value);
+  return url.ToString();
+}
+}
+
+class TestMusicDatabaseBenchmark : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    m_benchmark.reset(new CLibraryBenchmark("musicdatabase"));
+    m_database.reset(new CMusicDatabase());
+    if (!CLibraryBenchmark::CreateDatabase(*m_database, "MyMusicBenchmark"))
+    {
+      m_database.reset();
+      return;
+    }
+
+    const unsigned int albums = CLibraryBenchmark::Scaled(FULL_SONGS / SONGS_PER_ALBUM);
+    const unsigned int artists = CLibraryBenchmark::Scaled(FULL_ARTISTS);
+    m_benchmark->SetInfo("version", m_database->GetSingleValue("version", "idVersion"));
+    m_benchmark->SetInfo("albums", albums);
+    m_benchmark->SetInfo("songs", albums * SONGS_PER_ALBUM);
+    m_benchmark->SetInfo("artists", artists);
+
+    // the scan-time insert path, batched the same way the scanner does
+    unsigned int seed = 42;
+    m_benchmark->Measure("AddAlbum", 1, [&]()
+    {
+      m_database->BeginBatch(g_advancedSettings.m_iMusicLibraryScanBatchSize);
+      for (unsigned int i = 0; i < albums; i++)
+      {
+        std::string artist = StringUtils::Format("Artist %u", Next(seed, artists) + 1);
+        std::string path = StringUtils::Format("/media/music/%s/Album %u/", artist.c_str(), i + 1);
+
+        CAlbum album;
+        album.strAlbum = StringUtils::Format("Album %u", i + 1);
+        album.strPath = path;
+        album.iYear = 1950 + Next(seed, 68);
+        album.artistCredits.push_back(CArtistCredit(artist));
+        album.genre.push_back(StringUtils::Format("Genre %u", Next(seed, GENRES) + 1));
+
+        for (unsigned int track = 1; track <= SONGS_PER_ALBUM; track++)
+        {
+          CSong song;
+          song.strTitle = StringUtils::Format("Song %u", track);
+          song.strFileName = StringUtils::Format("%s%02u.flac", path.c_str(), track);
+          song.iTrack = track;
+          song.iDuration = 120 + Next(seed, 300);
+          song.iYear = album.iYear;
+          song.genre = album.genre;
+          song.artistCredits = album.artistCredits;
+          // every fifth song features a second artist
+          if (Next(seed, 5) == 0)
+            song.artistCredits.push_back(CArtistCredit(StringUtils::Format("Artist %u", Next(seed, artists) + 1)));
+          album.songs.push_back(song);
+        }
+
+        if (!m_database->AddAlbum(album))
+          return -1;
+        m_database->BatchItemDone();
+      }
+      return m_database->EndBatch() ? static_cast<int>(albums * SONGS_PER_ALBUM) : -1;
+    });
+
+    m_database->ExecuteQuery("UPDATE song SET iTimesPlayed = 1, lastplayed = '2018-01-01 20:00:00' WHERE idSong % 3 = 0");
+    m_database->Checkpoint(true);
+  }
+
+  static void TearDownTestCase()
+  {
+    if (m_database)
+      m_database->Close();
+    m_database.reset();
+
+    EXPECT_TRUE(m_benchmark->Write());
+    m_benchmark.reset();
+  }
+
+  static std::unique_ptr<CMusicDatabase> m_database;
+  static std::unique_ptr<CLibraryBenchmark> m_benchmark;
+};
+
+std::unique_ptr<CMusicDatabase> TestMusicDatabaseBenchmark::m_database;
+std::unique_ptr<CLibraryBenchmark> TestMusicDatabaseBenchmark::m_benchmark;
+
+TEST_F(TestMusicDatabaseBenchmark, DISABLED_GetSongsPaged)
+{
+  ASSERT_TRUE(m_database != nullptr);
+
+  // the same query AudioLibrary.GetSongs runs, first and last page
+  const unsigned int songs = CLibraryBenchmark::Scaled(FULL_SONGS / SONGS_PER_ALBUM) * SONGS_PER_ALBUM;
+  const struct
+  {
+    const char *name;
+    unsigned int start;
+  } pages[] = {
+    { "GetSongsFullByWhere/firstpage", 0 },
+    { "GetSongsFullByWhere/lastpage", songs > PAGE_SIZE ? songs - PAGE_SIZE : 0 },
+  };
+
+  for (const auto &page : pages)
+  {
+    EXPECT_TRUE(m_benchmark->Measure(page.name, 5, [&]()
+    {
+      SortDescription sorting;
+      sorting.sortBy = SortByTitle;
+      sorting.limitStart = page.start;
+      sorting.limitEnd = page.start + PAGE_SIZE;
+
+      CFileItemList items;
+      return m_database->GetSongsFullByWhere(GetSongsUrl("", ""), CDatabase::Filter(), items, sorting, true) ? items.Size() : -1;
+    }));
+  }
+
+  EXPECT_TRUE(m_benchmark->Measure("GetSongsFullByWhere/genre", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetSongsFullByWhere(GetSongsUrl("genre", "Genre 3"), CDatabase::Filter(), items, SortDescription(), true) ? items.Size() : -1;
+  }));
+}
+
+TEST_F(TestMusicDatabaseBenchmark, DISABLED_SmartPlaylist)
+{
+  ASSERT_TRUE(m_database != nullptr);
+
+  std::string url = GetSongsUrl("xsp",
+    "{\"type\":\"songs\",\"rules\":{\"and\":["
+    "{\"field\":\"genre\",\"operator\":\"is\",\"value\":[\"Genre 3\",\"Genre 4\"]},"
+    "{\"field\":\"year\",\"operator\":\"greaterthan\",\"value\":[\"1990\"]},"
+    "{\"field\":\"playcount\",\"operator\":\"is\",\"value\":[\"0\"]}]}}");
+
+  EXPECT_TRUE(m_benchmark->Measure("SmartPlaylist/songs", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetSongsByWhere(url, CDatabase::Filter(), items) ? items.Size() : -1;
+  }));
+}
+
+TEST_F(TestMusicDatabaseBenchmark, DISABLED_Navigation)
+{
+  ASSERT_TRUE(m_database != nullptr);
+
+  EXPECT_TRUE(m_benchmark->Measure("GetArtistsNav/albumartists", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetArtistsNav("musicdb://artists/", items, true) ? items.Size() : -1;
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("GetAlbumsByWhere", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetAlbumsByWhere("musicdb://albums/", CDatabase::Filter(), items) ? items.Size() : -1;
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("GetGenresNav", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetGenresNav("musicdb://genres/", items) ? items.Size() : -1;
+  }));
+}
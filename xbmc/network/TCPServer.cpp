@@ -24,6 +24,9 @@
 #include <memory.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#if !defined(TARGET_WINDOWS)
+#include <fcntl.h>
+#endif
 
 #include "settings/AdvancedSettings.h"
 #include "interfaces/json-rpc/JSONRPC.h"
@@ -61,9 +64,32 @@ using namespace JSONRPC;
 using namespace ANNOUNCEMENT;
 
 #define RECEIVEBUFFER 1024
+#define MAX_PENDING_ANNOUNCEMENTS 1000
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
+namespace
+{
+bool SetNonBlocking(SOCKET socket)
+{
+#ifdef TARGET_WINDOWS
+  u_long nonblocking = 1;
+  return ioctlsocket(socket, FIONBIO, &nonblocking) == 0;
+#else
+  return fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK) == 0;
+#endif
+}
+
+bool WouldBlock()
+{
+#ifdef TARGET_WINDOWS
+  return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+  return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+}
+
 bool CTCPServer::StartServer(int port, bool nonlocal)
 {
   StopServer(true);
@@ -127,8 +153,10 @@ void CTCPServer::Process()
   {
     SOCKET          max_fd = 0;
     fd_set          rfds;
+    fd_set          wfds;
     struct timeval  to     = {1, 0};
     FD_ZERO(&rfds);
+    FD_ZERO(&wfds);
 
     for (std::vector<SOCKET>::iterator it = m_servers.begin(); it != m_servers.end(); ++it)
     {
@@ -139,12 +167,15 @@ void CTCPServer::Process()
 
     for (unsigned int i = 0; i < m_connections.size(); i++)
     {
-      FD_SET(m_connections[i]->m_socket, &rfds);
+      if (!m_connections[i]->HasPendingResponse())
+        FD_SET(m_connections[i]->m_socket, &rfds);
+      if (m_connections[i]->HasPendingData())
+        FD_SET(m_connections[i]->m_socket, &wfds);
       if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
         max_fd = m_connections[i]->m_socket;
     }
 
-    int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
+    int res = select((intptr_t)max_fd+1, &rfds, &wfds, NULL, &to);
     if (res < 0)
     {
       CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
@@ -153,6 +184,18 @@ void CTCPServer::Process()
     }
     else if (res > 0)
     {
+      for (int i = m_connections.size() - 1; i >= 0; i--)
+      {
+        if (FD_ISSET(m_connections[i]->m_socket, &wfds) && !m_connections[i]->SendPendingData())
+        {
+          CSingleLock lock(m_critSection);
+          CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+          m_connections[i]->Disconnect();
+          delete m_connections[i];
+          m_connections.erase(m_connections.begin() + i);
+        }
+      }
+
       for (int i = m_connections.size() - 1; i >= 0; i--)
       {
         int socket = m_connections[i]->m_socket;
@@ -174,6 +217,7 @@ void CTCPServer::Process()
 
               if (websocket != NULL)
               {
+                CSingleLock lock(m_critSection);
                 // Replace the CTCPClient with a CWebSocketClient
                 CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *(m_connections[i]));
                 delete m_connections[i];
@@ -188,10 +232,11 @@ void CTCPServer::Process()
             close = m_connections[i]->Closing();
           }
           else
-            close = true;
+            close = nread == 0 || !WouldBlock();
 
           if (close)
           {
+            CSingleLock lock(m_critSection);
             CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
             m_connections[i]->Disconnect();
             delete m_connections[i];
@@ -221,6 +266,10 @@ void CTCPServer::Process()
           else
           {
             CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
+            // sending must never block the server or the announcing thread
+            if (!SetNonBlocking(newconnection->m_socket))
+              CLog::Log(LOGWARNING, "JSONRPC Server: Unable to make the new connection non-blocking");
+            CSingleLock lock(m_critSection);
             m_connections.push_back(newconnection);
           }
         }
@@ -248,8 +297,11 @@ int CTCPServer::GetCapabilities()
 
 void CTCPServer::Announce(AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
 {
-  std::string str = IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, g_advancedSettings.m_jsonOutputCompact);
+  // serialized once, the clients share it until it's sent
+  std::shared_ptr<const std::string> str = std::make_shared<const std::string>(
+    IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, g_advancedSettings.m_jsonOutputCompact));
 
+  CSingleLock lock (m_critSection);
   for (unsigned int i = 0; i < m_connections.size(); i++)
   {
     {
@@ -258,7 +310,7 @@ void CTCPServer::Announce(AnnouncementFlag flag, const char *sender, const char
         continue;
     }
 
-    m_connections[i]->Send(str.c_str(), str.size());
+    m_connections[i]->QueueAnnouncement(str);
   }
 }
 
@@ -478,13 +530,16 @@ bool CTCPServer::InitializeTCP()
 
 void CTCPServer::Deinitialize()
 {
-  for (unsigned int i = 0; i < m_connections.size(); i++)
   {
-    m_connections[i]->Disconnect();
-    delete m_connections[i];
-  }
+    CSingleLock lock(m_critSection);
+    for (unsigned int i = 0; i < m_connections.size(); i++)
+    {
+      m_connections[i]->Disconnect();
+      delete m_connections[i];
+    }
 
-  m_connections.clear();
+    m_connections.clear();
+  }
 
   for (unsigned int i = 0; i < m_servers.size(); i++)
     closesocket(m_servers[i]);
@@ -509,6 +564,10 @@ CTCPServer::CTCPClient::CTCPClient()
   m_endBrackets = 0;
   m_beginChar = 0;
   m_endChar = 0;
+  m_pendingOffset = 0;
+  m_pendingResponses = 0;
+  m_droppedAnnouncements = 0;
+  m_sendFailed = false;
 
   m_addrlen = sizeof(m_cliaddr);
 }
@@ -542,12 +601,122 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
 
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
+  // responses and announcements are sent from different threads, keep their order
+  CSingleLock lock (m_critSection);
+  if (m_sendFailed)
+    return;
+
   unsigned int sent = 0;
-  do
+  if (m_pendingData.empty())
   {
-    CSingleLock lock (m_critSection);
-    sent += send(m_socket, data + sent, size - sent, 0);
-  } while (sent < size);
+    int result = send(m_socket, data, size, 0);
+    if (result < 0 && !WouldBlock())
+    {
+      m_sendFailed = true;
+      return;
+    }
+    if (result > 0)
+      sent = result;
+  }
+
+  if (sent < size)
+  {
+    PendingData pending = { std::make_shared<const std::string>(data + sent, size - sent), false };
+    m_pendingData.push_back(std::move(pending));
+    m_pendingResponses++;
+  }
+}
+
+std::shared_ptr<const std::string> CTCPServer::CTCPClient::EncodeAnnouncement(const std::shared_ptr<const std::string> &announcement)
+{
+  return announcement;
+}
+
+void CTCPServer::CTCPClient::QueueAnnouncement(const std::shared_ptr<const std::string> &announcement)
+{
+  CSingleLock lock (m_critSection);
+  if (m_sendFailed)
+    return;
+
+  std::shared_ptr<const std::string> data = EncodeAnnouncement(announcement);
+  if (!data)
+    return;
+
+  // the first entry may be partially sent already, it has to stay
+  const size_t first = m_pendingOffset > 0 ? 1 : 0;
+
+  for (auto it = m_pendingData.begin() + first; it != m_pendingData.end(); ++it)
+  {
+    if (it->announcement && *it->data == *data)
+    {
+      m_pendingData.erase(it);
+      break;
+    }
+  }
+
+  unsigned int announcements = 0;
+  auto oldest = m_pendingData.end();
+  for (auto it = m_pendingData.begin() + first; it != m_pendingData.end(); ++it)
+  {
+    if (!it->announcement)
+      continue;
+    if (announcements++ == 0)
+      oldest = it;
+  }
+
+  if (announcements >= MAX_PENDING_ANNOUNCEMENTS)
+  {
+    if (m_droppedAnnouncements++ == 0)
+      CLog::Log(LOGWARNING, "JSONRPC Server: Client doesn't keep up with the announcements, dropping the oldest ones");
+    m_pendingData.erase(oldest);
+  }
+
+  PendingData pending = { data, true };
+  m_pendingData.push_back(std::move(pending));
+  SendPendingData();
+}
+
+bool CTCPServer::CTCPClient::HasPendingData()
+{
+  CSingleLock lock (m_critSection);
+  return !m_pendingData.empty();
+}
+
+bool CTCPServer::CTCPClient::HasPendingResponse()
+{
+  CSingleLock lock (m_critSection);
+  return m_pendingResponses > 0;
+}
+
+bool CTCPServer::CTCPClient::SendPendingData()
+{
+  CSingleLock lock (m_critSection);
+  while (!m_sendFailed && !m_pendingData.empty())
+  {
+    const PendingData &pending = m_pendingData.front();
+    int result = send(m_socket, pending.data->c_str() + m_pendingOffset, pending.data->size() - m_pendingOffset, 0);
+    if (result < 0)
+    {
+      m_sendFailed = !WouldBlock();
+      break;
+    }
+
+    m_pendingOffset += result;
+    if (m_pendingOffset < pending.data->size())
+      break; // the socket is full
+
+    if (!pending.announcement)
+      m_pendingResponses--;
+    m_pendingData.pop_front();
+    m_pendingOffset = 0;
+  }
+
+  if (m_pendingData.empty() && m_droppedAnnouncements > 0)
+  {
+    CLog::Log(LOGINFO, "JSONRPC Server: Client caught up, %u announcements were dropped", m_droppedAnnouncements);
+    m_droppedAnnouncements = 0;
+  }
+  return !m_sendFailed;
 }
 
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -592,6 +761,8 @@ void CTCPServer::CTCPClient::Disconnect()
   if (m_socket > 0)
   {
     CSingleLock lock (m_critSection);
+    // last chance for whatever is still pending, e.g. a websocket close frame
+    SendPendingData();
     shutdown(m_socket, SHUT_RDWR);
     closesocket(m_socket);
     m_socket = INVALID_SOCKET;
@@ -610,6 +781,11 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_beginChar         = client.m_beginChar;
   m_endChar           = client.m_endChar;
   m_buffer            = client.m_buffer;
+  m_pendingData       = client.m_pendingData;
+  m_pendingOffset     = client.m_pendingOffset;
+  m_pendingResponses  = client.m_pendingResponses;
+  m_droppedAnnouncements = client.m_droppedAnnouncements;
+  m_sendFailed        = client.m_sendFailed;
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -645,6 +821,7 @@ CTCPServer::CWebSocketClient& CTCPServer::CWebSocketClient::operator=(const CWeb
 
 void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
 {
+  CSingleLock lock (m_critSection);
   const CWebSocketMessage *msg = m_websocket->Send(WebSocketTextFrame, data, size);
   if (msg == NULL || !msg->IsComplete())
     return;
@@ -654,6 +831,20 @@ void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
     CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
 }
 
+std::shared_ptr<const std::string> CTCPServer::CWebSocketClient::EncodeAnnouncement(const std::shared_ptr<const std::string> &announcement)
+{
+  const CWebSocketMessage *msg = m_websocket->Send(WebSocketTextFrame, announcement->c_str(), announcement->size());
+  if (msg == NULL || !msg->IsComplete())
+    return nullptr;
+
+  std::string data;
+  std::vector<const CWebSocketFrame *> frames = msg->GetFrames();
+  for (unsigned int index = 0; index < frames.size(); index++)
+    data.append(frames.at(index)->GetFrameData(), frames.at(index)->GetFrameLength());
+  delete msg;
+  return std::make_shared<const std::string>(std::move(data));
+}
+
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
 {
   bool send;
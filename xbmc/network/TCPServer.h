@@ -19,6 +19,9 @@
  *
  */
 
+#include <deque>
+#include <memory>
+#include <string>
 #include <vector>
 #include <sys/socket.h>
 
@@ -69,10 +72,29 @@ namespace JSONRPC
       int GetAnnouncementFlags() override;
       bool SetAnnouncementFlags(int flags) override;
 
+      /*! \brief Send data without blocking, what the socket doesn't take right
+       away is queued and sent by the server thread once the socket is writable.
+       */
       virtual void Send(const char *data, unsigned int size);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
       virtual void Disconnect();
 
+      /*! \brief Send an announcement without ever blocking the announcing thread.
+       It's queued behind the data still pending for the client and replaces an
+       identical announcement still waiting. The oldest announcements are dropped
+       if the client doesn't keep up.
+       */
+      void QueueAnnouncement(const std::shared_ptr<const std::string> &announcement);
+      bool HasPendingData();
+      /*! \brief Whether a response is still being sent, no further requests are
+       read from the client until it is, so it can't queue up responses forever.
+       */
+      bool HasPendingResponse();
+      /*! \brief Send the queued data the socket takes without blocking
+       \return false if the connection failed
+       */
+      bool SendPendingData();
+
       virtual bool IsNew() const { return m_new; }
       virtual bool Closing() const { return false; }
 
@@ -83,12 +105,25 @@ namespace JSONRPC
 
     protected:
       void Copy(const CTCPClient& client);
+      /*! \brief Wrap an announcement for the wire, nullptr if it can't be sent */
+      virtual std::shared_ptr<const std::string> EncodeAnnouncement(const std::shared_ptr<const std::string> &announcement);
     private:
+      struct PendingData
+      {
+        std::shared_ptr<const std::string> data;
+        bool announcement;
+      };
+
       bool m_new;
       int m_announcementflags;
       int m_beginBrackets, m_endBrackets;
       char m_beginChar, m_endChar;
       std::string m_buffer;
+      std::deque<PendingData> m_pendingData;
+      size_t m_pendingOffset; ///< bytes of the first pending entry already sent
+      unsigned int m_pendingResponses;
+      unsigned int m_droppedAnnouncements;
+      bool m_sendFailed;
     };
 
     class CWebSocketClient : public CTCPClient
@@ -107,10 +142,14 @@ namespace JSONRPC
       bool IsNew() const override { return m_websocket == NULL; }
       bool Closing() const override { return m_websocket != NULL && m_websocket->GetState() == WebSocketStateClosed; }
 
+    protected:
+      std::shared_ptr<const std::string> EncodeAnnouncement(const std::shared_ptr<const std::string> &announcement) override;
+
     private:
       CWebSocket *m_websocket;
     };
 
+    CCriticalSection m_critSection; ///< guards m_connections against the announcing thread
     std::vector<CTCPClient*> m_connections;
     std::vector<SOCKET> m_servers;
     int m_port;
@@ -245,6 +245,7 @@ void CPictureThumbLoader::ProcessFoldersAndArchives(CFileItem *pItem)
           details.file = relativeCacheFile;
           details.width = g_advancedSettings.m_imageRes;
           details.height = g_advancedSettings.m_imageRes;
+          CTextureCache::DeleteCompressedImage(CTextureCache::GetCachedPath(relativeCacheFile));
           CTextureCache::GetInstance().AddCachedTexture(thumb, details);
           db.SetTextureForPath(pItem->GetPath(), "thumb", thumb);
           pItem->SetArt("thumb", CTextureCache::GetCachedPath(relativeCacheFile));
@@ -842,8 +842,8 @@ void CSlideShowPic::Render(float *x, float *y, CBaseTexture* pTexture, color_t c
     pTexture->LoadToGPU();
     pTexture->BindToUnit(0);
 
-    glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_BLEND);          // Turn Blending On
+    g_Windowing.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    g_Windowing.SetBlending(true);
 
     g_Windowing.EnableShader(SM_TEXTURE);
   }
@@ -946,8 +946,8 @@ void CSlideShowPic::Render(float *x, float *y, CBaseTexture* pTexture, color_t c
     pTexture->LoadToGPU();
     pTexture->BindToUnit(0);
 
-    glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_BLEND);          // Turn Blending On
+    g_Windowing.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    g_Windowing.SetBlending(true);
 
     g_Windowing.EnableGUIShader(SM_TEXTURE);
   }
@@ -1,39 +1,44 @@
-#pragma once
-/*
-*      Copyright (C) 2005-2017 Team Kodi
-*      http://xbmc.org
-*
-*  This Program is free software; you can redistribute it and/or modify
-*  it under the terms of the GNU General Public License as published by
-*  the Free Software Foundation; either version 2, or (at your option)
-*  any later version.
-*
-*  This Program is distributed in the hope that it will be useful,
-*  but WITHOUT ANY WARRANTY; without even the implied warranty of
-*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
-*  GNU General Public License for more details.
-*
-*  You should have received a copy of the GNU General Public License
-*  along with XBMC; see the file COPYING.  If not, see
-*  <http://www.gnu.org/licenses/>.
-*
-*/
-
-#include <string>
-#include <system_error>
-namespace KODI
-{
-namespace PLATFORM
-{
-namespace FILESYSTEM
-{
-struct space_info {
-  std::uintmax_t capacity;
-  std::uintmax_t free;
-  std::uintmax_t available;
-};
-
-space_info space(const std::string& path, std::error_code& ec);
-}
-}
+#pragma once
+/*
+*      Copyright (C) 2005-2017 Team Kodi
+*      http://xbmc.org
+*
+*  This Program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2, or (at your option)
+*  any later version.
+*
+*  This Program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with XBMC; see the file COPYING.  If not, see
+*  <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include <string>
+#include <system_error>
+namespace KODI
+{
+namespace PLATFORM
+{
+namespace FILESYSTEM
+{
+struct space_info {
+  std::uintmax_t capacity;
+  std::uintmax_t free;
+  std::uintmax_t available;
+};
+
+space_info space(const std::string& path, std::error_code& ec);
+
+/*! \brief Whether path is on a network filesystem (NFS, SMB, ...), where
+ file locking and shared memory mappings can't be relied on.
+ */
+bool is_network(const std::string& path, std::error_code& ec);
+}
+}
 }
\ No newline at end of file
@@ -22,7 +22,10 @@
 #include "system.h"
 #include "filesystem/SpecialProtocol.h"
 
+#include <errno.h>
+
 #if defined(TARGET_LINUX)
+#include <sys/statfs.h>
 #include <sys/statvfs.h>
 #elif defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
 #include <sys/param.h>
@@ -65,6 +68,36 @@ space_info space(const std::string& path, std::error_code& ec)
 
   return sp;
 }
+
+bool is_network(const std::string& path, std::error_code& ec)
+{
+  ec.clear();
+  struct statfs fsInfo;
+  if (statfs(CSpecialProtocol::TranslatePath(path).c_str(), &fsInfo) != 0)
+  {
+    ec.assign(errno, std::system_category());
+    return false;
+  }
+
+#if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
+  return (fsInfo.f_flags & MNT_LOCAL) == 0;
+#else
+  switch (static_cast<unsigned long>(fsInfo.f_type))
+  {
+  case 0x6969:     // NFS
+  case 0x517B:     // SMB
+  case 0xFF534D42: // CIFS
+  case 0xFE534D42: // SMB2
+  case 0x564C:     // NCP
+  case 0x5346414F: // AFS
+  case 0x73757245: // CODA
+  case 0x01021997: // 9P
+    return true;
+  default:
+    return false;
+  }
+#endif
+}
+}
 }
 }
-}
\ No newline at end of file
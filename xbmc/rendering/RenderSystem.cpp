@@ -32,10 +32,26 @@ CRenderSystemBase::CRenderSystemBase()
   m_renderCaps = 0;
   m_renderQuirks = 0;
   m_minDXTPitch = 0;
+  m_drawCalls = 0;
+  m_drawQuads = 0;
+  m_lastDrawCalls = 0;
+  m_lastDrawQuads = 0;
+  m_stateChanges = 0;
+  m_lastStateChanges = 0;
 }
 
 CRenderSystemBase::~CRenderSystemBase() = default;
 
+void CRenderSystemBase::ResetDrawStats()
+{
+  m_lastDrawCalls = m_drawCalls;
+  m_lastDrawQuads = m_drawQuads;
+  m_lastStateChanges = m_stateChanges;
+  m_drawCalls = 0;
+  m_drawQuads = 0;
+  m_stateChanges = 0;
+}
+
 void CRenderSystemBase::GetRenderVersion(unsigned int& major, unsigned int& minor) const
 {
   major = m_RenderVersionMajor;
@@ -82,6 +82,12 @@ public:
   virtual void CaptureStateBlock() = 0;
   virtual void ApplyStateBlock() = 0;
 
+  /**
+   * Forget the texture, blend and scissor state the render system tracks for the GUI,
+   * to be called after code that changes it directly has rendered
+   */
+  virtual void ResetGUIState() {};
+
   virtual void SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor = 0.f) = 0;
   virtual void ApplyHardwareTransform(const TransformMatrix &matrix) = 0;
   virtual void RestoreHardwareTransform() = 0;
@@ -113,7 +119,30 @@ public:
   unsigned int GetMinDXTPitch() const { return m_minDXTPitch; }
   unsigned int GetRenderQuirks() const { return m_renderQuirks; }
 
+  /**
+   * Count a draw call issued by the GUI
+   * \param quads the number of quads drawn by the call
+   */
+  void AddDrawCall(unsigned int quads = 1) { m_drawCalls++; m_drawQuads += quads; }
+
+  /**
+   * Count a texture, blend or scissor change sent to the GPU for the GUI
+   */
+  void AddStateChange() { m_stateChanges++; }
+
+  /**
+   * Get the number of draw calls, quads and state changes of the last presented frame
+   */
+  void GetDrawStats(unsigned int &drawCalls, unsigned int &quads, unsigned int &stateChanges) const
+  {
+    drawCalls = m_lastDrawCalls;
+    quads = m_lastDrawQuads;
+    stateChanges = m_lastStateChanges;
+  }
+
 protected:
+  void ResetDrawStats();
+
   bool                m_bRenderCreated;
   RenderingSystemType m_enumRenderingSystem;
   bool                m_bVSync;
@@ -129,6 +158,12 @@ protected:
   unsigned int m_renderQuirks;
   RENDER_STEREO_VIEW m_stereoView;
   RENDER_STEREO_MODE m_stereoMode;
+  unsigned int m_drawCalls;
+  unsigned int m_drawQuads;
+  unsigned int m_lastDrawCalls;
+  unsigned int m_lastDrawQuads;
+  unsigned int m_stateChanges;
+  unsigned int m_lastStateChanges;
 };
 
 #endif // RENDER_SYSTEM_H
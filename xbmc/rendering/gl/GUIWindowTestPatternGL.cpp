@@ -25,6 +25,7 @@
 #ifdef HAS_GL
 #include "system_gl.h"
 #include "GUIWindowTestPatternGL.h"
+#include "windowing/WindowingFactory.h"
 
 CGUIWindowTestPatternGL::CGUIWindowTestPatternGL(void) : CGUIWindowTestPattern()
 {
@@ -190,7 +191,7 @@ void CGUIWindowTestPatternGL::DrawCircle(int originX, int originY, int radius)
 void CGUIWindowTestPatternGL::BeginRender()
 {
   glDisable(GL_TEXTURE_2D);
-  glDisable(GL_BLEND);
+  g_Windowing.SetBlending(false);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
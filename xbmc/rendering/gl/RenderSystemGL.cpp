@@ -23,6 +23,7 @@
 
 #include "RenderSystemGL.h"
 #include "guilib/GraphicContext.h"
+#include "guilib/GUITexture.h"
 #include "settings/AdvancedSettings.h"
 #include "guilib/MatrixGLES.h"
 #include "settings/DisplaySettings.h"
@@ -251,6 +252,8 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
   glEnable(GL_BLEND);          // Turn Blending On
   glDisable(GL_DEPTH_TEST);
 
+  ResetGUIState();
+
   return true;
 }
 
@@ -271,6 +274,9 @@ bool CRenderSystemGL::BeginRender()
   if (!m_bRenderCreated)
     return false;
 
+  // the video and add-ons rendered since the last frame change the state directly
+  ResetGUIState();
+
   return true;
 }
 
@@ -279,6 +285,8 @@ bool CRenderSystemGL::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  CGUITexture::Flush();
+
   return true;
 }
 
@@ -287,6 +295,8 @@ bool CRenderSystemGL::ClearBuffers(color_t color)
   if (!m_bRenderCreated)
     return false;
 
+  CGUITexture::Flush();
+
   /* clear is not affected by stipple pattern, so we can only clear on first frame */
   if(m_stereoMode == RENDER_STEREO_MODE_INTERLACED && m_stereoView == RENDER_STEREO_VIEW_RIGHT)
     return true;
@@ -329,6 +339,9 @@ bool CRenderSystemGL::IsExtSupported(const char* extension)
 
 void CRenderSystemGL::PresentRender(bool rendered, bool videoLayer)
 {
+  CGUITexture::Flush();
+  ResetDrawStats();
+
   SetVSync(true);
 
   if (!m_bRenderCreated)
@@ -364,12 +377,15 @@ void CRenderSystemGL::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
 
   glDisable(GL_SCISSOR_TEST); // fixes FBO corruption on Macs
   glActiveTexture(GL_TEXTURE0);
+  ResetGUIState();
 }
 
 void CRenderSystemGL::ApplyStateBlock()
@@ -377,6 +393,8 @@ void CRenderSystemGL::ApplyStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
   glBindVertexArray(m_vertexArray);
 
   glViewport(m_viewPort[0], m_viewPort[1], m_viewPort[2], m_viewPort[3]);
@@ -388,6 +406,7 @@ void CRenderSystemGL::ApplyStateBlock()
   glActiveTexture(GL_TEXTURE0);
   glEnable(GL_BLEND);
   glEnable(GL_SCISSOR_TEST);
+  ResetGUIState();
 }
 
 void CRenderSystemGL::SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor)
@@ -395,6 +414,8 @@ void CRenderSystemGL::SetCameraPosition(const CPoint &camera, int screenWidth, i
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
 
 
@@ -445,6 +466,8 @@ void CRenderSystemGL::ApplyHardwareTransform(const TransformMatrix &finalMatrix)
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
   glMatrixModview.Push();
   GLfloat matrix[4][4];
 
@@ -466,6 +489,8 @@ void CRenderSystemGL::RestoreHardwareTransform()
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
   glMatrixModview.PopLoad();
 }
 
@@ -531,6 +556,9 @@ void CRenderSystemGL::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
+  m_scissorsKnown = false;
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -565,11 +593,23 @@ void CRenderSystemGL::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+
   GLint x1 = MathUtils::round_int(rect.x1);
   GLint y1 = MathUtils::round_int(rect.y1);
   GLint x2 = MathUtils::round_int(rect.x2);
   GLint y2 = MathUtils::round_int(rect.y2);
-  glScissor(x1, m_height - y2, x2-x1, y2-y1);
+  GLint scissors[4] = { x1, m_height - y2, x2 - x1, y2 - y1 };
+
+  // the batched GUI textures can stay in the batch if the clipping doesn't change
+  if (m_scissorsKnown && memcmp(scissors, m_scissors, sizeof(scissors)) == 0)
+    return;
+
+  CGUITexture::Flush();
+
+  glScissor(scissors[0], scissors[1], scissors[2], scissors[3]);
+  memcpy(m_scissors, scissors, sizeof(scissors));
+  m_scissorsKnown = true;
+  AddStateChange();
 }
 
 void CRenderSystemGL::ResetScissors()
@@ -577,6 +617,91 @@ void CRenderSystemGL::ResetScissors()
   SetScissors(CRect(0, 0, (float)m_width, (float)m_height));
 }
 
+void CRenderSystemGL::BindTexture(GLuint texture, unsigned int unit)
+{
+  SetActiveTextureUnit(unit);
+
+  if (unit < GUI_TEXTURE_UNITS)
+  {
+    if (m_guiState.texturesKnown[unit] && m_guiState.textures[unit] == texture)
+      return;
+    m_guiState.textures[unit] = texture;
+    m_guiState.texturesKnown[unit] = true;
+  }
+
+  glBindTexture(GL_TEXTURE_2D, texture);
+  AddStateChange();
+}
+
+void CRenderSystemGL::SetActiveTextureUnit(unsigned int unit)
+{
+  if (m_guiState.activeUnitKnown && m_guiState.activeUnit == unit)
+    return;
+
+  glActiveTexture(GL_TEXTURE0 + unit);
+  m_guiState.activeUnit = unit;
+  m_guiState.activeUnitKnown = true;
+  AddStateChange();
+}
+
+void CRenderSystemGL::SetBlending(bool enable)
+{
+  if (m_guiState.blendKnown && m_guiState.blend == enable)
+    return;
+
+  if (enable)
+    glEnable(GL_BLEND);
+  else
+    glDisable(GL_BLEND);
+  m_guiState.blend = enable;
+  m_guiState.blendKnown = true;
+  AddStateChange();
+}
+
+void CRenderSystemGL::SetBlendFunc(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+{
+  GLenum blendFunc[4] = { srcRGB, dstRGB, srcAlpha, dstAlpha };
+  if (m_guiState.blendFuncKnown && memcmp(blendFunc, m_guiState.blendFunc, sizeof(blendFunc)) == 0)
+    return;
+
+  glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+  memcpy(m_guiState.blendFunc, blendFunc, sizeof(blendFunc));
+  m_guiState.blendFuncKnown = true;
+  AddStateChange();
+}
+
+void CRenderSystemGL::DeleteTexture(GLuint texture)
+{
+  glDeleteTextures(1, &texture);
+
+  for (unsigned int unit = 0; unit < GUI_TEXTURE_UNITS; unit++)
+  {
+    if (m_guiState.textures[unit] == texture)
+      m_guiState.textures[unit] = 0;
+  }
+}
+
+void CRenderSystemGL::RestoreGUIState(const GUIState &state)
+{
+  for (unsigned int unit = 0; unit < GUI_TEXTURE_UNITS; unit++)
+  {
+    if (state.texturesKnown[unit])
+      BindTexture(state.textures[unit], unit);
+  }
+  if (state.activeUnitKnown)
+    SetActiveTextureUnit(state.activeUnit);
+  if (state.blendFuncKnown)
+    SetBlendFunc(state.blendFunc[0], state.blendFunc[1], state.blendFunc[2], state.blendFunc[3]);
+  if (state.blendKnown)
+    SetBlending(state.blend);
+}
+
+void CRenderSystemGL::ResetGUIState()
+{
+  m_guiState = GUIState();
+  m_scissorsKnown = false;
+}
+
 void CRenderSystemGL::GetGLSLVersion(int& major, int& minor)
 {
   major = m_glslMajor;
@@ -634,6 +759,8 @@ static const GLubyte stipple_3d[] = {
 
 void CRenderSystemGL::SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view)
 {
+  CGUITexture::Flush();
+
   CRenderSystemBase::SetStereoMode(mode, view);
 
   glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -765,6 +892,9 @@ void CRenderSystemGL::InitialiseShader()
 
 void CRenderSystemGL::EnableShader(ESHADERMETHOD method)
 {
+  // the batched GUI textures are drawn with the shader they were batched for
+  CGUITexture::Flush();
+
   m_method = method;
   if (m_pShader[m_method])
   {
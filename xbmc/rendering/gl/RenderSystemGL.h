@@ -94,6 +94,37 @@ public:
   GLint ShaderGetUniCol();
   GLint ShaderGetModel();
 
+  static const unsigned int GUI_TEXTURE_UNITS = 2;
+
+  /*! \brief Texture bindings and blending the GUI set through the render system
+   Anything that was changed directly since the last ResetGUIState() is unknown.
+   */
+  struct GUIState
+  {
+    GLuint textures[GUI_TEXTURE_UNITS] = {};
+    bool texturesKnown[GUI_TEXTURE_UNITS] = {};
+    unsigned int activeUnit = 0;
+    bool activeUnitKnown = false;
+    bool blend = false;
+    bool blendKnown = false;
+    GLenum blendFunc[4] = {};
+    bool blendFuncKnown = false;
+  };
+
+  // the GL calls are skipped when the state is already set
+  void BindTexture(GLuint texture, unsigned int unit = 0);
+  void SetActiveTextureUnit(unsigned int unit);
+  void SetBlending(bool enable);
+  void SetBlendFunc(GLenum src, GLenum dst) { SetBlendFunc(src, dst, src, dst); }
+  void SetBlendFunc(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+  /*! \brief Delete a texture, the units it was bound to fall back to texture 0 */
+  void DeleteTexture(GLuint texture);
+
+  const GUIState& GetGUIState() const { return m_guiState; }
+  /*! \brief Set the known parts of a state returned by GetGUIState() again */
+  void RestoreGUIState(const GUIState &state);
+  void ResetGUIState() override;
+
 protected:
   virtual void SetVSyncImpl(bool enable) = 0;
   virtual void PresentRenderImpl(bool rendered) = 0;
@@ -110,6 +141,9 @@ protected:
   int m_glslMinor = 0;
   
   GLint m_viewPort[4];
+  GLint m_scissors[4];
+  bool m_scissorsKnown = false;
+  GUIState m_guiState;
 
   std::unique_ptr<CGLShader*[]> m_pShader;
   ESHADERMETHOD m_method = SM_DEFAULT;
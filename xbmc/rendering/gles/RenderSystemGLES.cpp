@@ -22,6 +22,7 @@
 #include "system.h"
 
 #include "guilib/GraphicContext.h"
+#include "guilib/GUITexture.h"
 #include "settings/AdvancedSettings.h"
 #include "RenderSystemGLES.h"
 #include "guilib/MatrixGLES.h"
@@ -164,7 +165,9 @@ bool CRenderSystemGLES::ResetRenderSystem(int width, int height)
   glBlendFunc(GL_SRC_ALPHA, GL_ONE);
   glEnable(GL_BLEND);          // Turn Blending On
   glDisable(GL_DEPTH_TEST);  
-    
+
+  ResetGUIState();
+
   return true;
 }
 
@@ -206,6 +209,9 @@ bool CRenderSystemGLES::BeginRender()
   if (!m_bRenderCreated)
     return false;
 
+  // the video and add-ons rendered since the last frame change the state directly
+  ResetGUIState();
+
   return true;
 }
 
@@ -214,6 +220,8 @@ bool CRenderSystemGLES::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  CGUITexture::Flush();
+
   return true;
 }
 
@@ -222,6 +230,8 @@ bool CRenderSystemGLES::ClearBuffers(color_t color)
   if (!m_bRenderCreated)
     return false;
 
+  CGUITexture::Flush();
+
   float r = GET_R(color) / 255.0f;
   float g = GET_G(color) / 255.0f;
   float b = GET_B(color) / 255.0f;
@@ -267,6 +277,9 @@ bool CRenderSystemGLES::IsExtSupported(const char* extension)
 
 void CRenderSystemGLES::PresentRender(bool rendered, bool videoLayer)
 {
+  CGUITexture::Flush();
+  ResetDrawStats();
+
   SetVSync(true);
 
   if (!m_bRenderCreated)
@@ -313,12 +326,15 @@ void CRenderSystemGLES::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
 
   glDisable(GL_SCISSOR_TEST); // fixes FBO corruption on Macs
   glActiveTexture(GL_TEXTURE0);
+  ResetGUIState();
 //! @todo - NOTE: Only for Screensavers & Visualisations
 //  glColor3f(1.0, 1.0, 1.0);
 }
@@ -328,6 +344,8 @@ void CRenderSystemGLES::ApplyStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
   glMatrixProject.PopLoad();
   glMatrixModview.PopLoad();
   glMatrixTexture.PopLoad();
@@ -335,6 +353,7 @@ void CRenderSystemGLES::ApplyStateBlock()
   glEnable(GL_BLEND);
   glEnable(GL_SCISSOR_TEST);  
   glClear(GL_DEPTH_BUFFER_BIT);
+  ResetGUIState();
 }
 
 void CRenderSystemGLES::SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor)
@@ -342,6 +361,8 @@ void CRenderSystemGLES::SetCameraPosition(const CPoint &camera, int screenWidth,
   if (!m_bRenderCreated)
     return;
   
+  CGUITexture::Flush();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
   
   float w = (float)m_viewPort[2]*0.5f;
@@ -418,6 +439,8 @@ void CRenderSystemGLES::ApplyHardwareTransform(const TransformMatrix &finalMatri
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
   glMatrixModview.Push();
   GLfloat matrix[4][4];
 
@@ -439,6 +462,8 @@ void CRenderSystemGLES::RestoreHardwareTransform()
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
   glMatrixModview.PopLoad();
 }
 
@@ -464,6 +489,9 @@ void CRenderSystemGLES::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  CGUITexture::Flush();
+
+  m_scissorsKnown = false;
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -498,11 +526,23 @@ void CRenderSystemGLES::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+
   GLint x1 = MathUtils::round_int(rect.x1);
   GLint y1 = MathUtils::round_int(rect.y1);
   GLint x2 = MathUtils::round_int(rect.x2);
   GLint y2 = MathUtils::round_int(rect.y2);
-  glScissor(x1, m_height - y2, x2-x1, y2-y1);
+  GLint scissors[4] = { x1, m_height - y2, x2 - x1, y2 - y1 };
+
+  // the batched GUI textures can stay in the batch if the clipping doesn't change
+  if (m_scissorsKnown && memcmp(scissors, m_scissors, sizeof(scissors)) == 0)
+    return;
+
+  CGUITexture::Flush();
+
+  glScissor(scissors[0], scissors[1], scissors[2], scissors[3]);
+  memcpy(m_scissors, scissors, sizeof(scissors));
+  m_scissorsKnown = true;
+  AddStateChange();
 }
 
 void CRenderSystemGLES::ResetScissors()
@@ -510,6 +550,91 @@ void CRenderSystemGLES::ResetScissors()
   SetScissors(CRect(0, 0, (float)m_width, (float)m_height));
 }
 
+void CRenderSystemGLES::BindTexture(GLuint texture, unsigned int unit)
+{
+  SetActiveTextureUnit(unit);
+
+  if (unit < GUI_TEXTURE_UNITS)
+  {
+    if (m_guiState.texturesKnown[unit] && m_guiState.textures[unit] == texture)
+      return;
+    m_guiState.textures[unit] = texture;
+    m_guiState.texturesKnown[unit] = true;
+  }
+
+  glBindTexture(GL_TEXTURE_2D, texture);
+  AddStateChange();
+}
+
+void CRenderSystemGLES::SetActiveTextureUnit(unsigned int unit)
+{
+  if (m_guiState.activeUnitKnown && m_guiState.activeUnit == unit)
+    return;
+
+  glActiveTexture(GL_TEXTURE0 + unit);
+  m_guiState.activeUnit = unit;
+  m_guiState.activeUnitKnown = true;
+  AddStateChange();
+}
+
+void CRenderSystemGLES::SetBlending(bool enable)
+{
+  if (m_guiState.blendKnown && m_guiState.blend == enable)
+    return;
+
+  if (enable)
+    glEnable(GL_BLEND);
+  else
+    glDisable(GL_BLEND);
+  m_guiState.blend = enable;
+  m_guiState.blendKnown = true;
+  AddStateChange();
+}
+
+void CRenderSystemGLES::SetBlendFunc(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+{
+  GLenum blendFunc[4] = { srcRGB, dstRGB, srcAlpha, dstAlpha };
+  if (m_guiState.blendFuncKnown && memcmp(blendFunc, m_guiState.blendFunc, sizeof(blendFunc)) == 0)
+    return;
+
+  glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+  memcpy(m_guiState.blendFunc, blendFunc, sizeof(blendFunc));
+  m_guiState.blendFuncKnown = true;
+  AddStateChange();
+}
+
+void CRenderSystemGLES::DeleteTexture(GLuint texture)
+{
+  glDeleteTextures(1, &texture);
+
+  for (unsigned int unit = 0; unit < GUI_TEXTURE_UNITS; unit++)
+  {
+    if (m_guiState.textures[unit] == texture)
+      m_guiState.textures[unit] = 0;
+  }
+}
+
+void CRenderSystemGLES::RestoreGUIState(const GUIState &state)
+{
+  for (unsigned int unit = 0; unit < GUI_TEXTURE_UNITS; unit++)
+  {
+    if (state.texturesKnown[unit])
+      BindTexture(state.textures[unit], unit);
+  }
+  if (state.activeUnitKnown)
+    SetActiveTextureUnit(state.activeUnit);
+  if (state.blendFuncKnown)
+    SetBlendFunc(state.blendFunc[0], state.blendFunc[1], state.blendFunc[2], state.blendFunc[3]);
+  if (state.blendKnown)
+    SetBlending(state.blend);
+}
+
+void CRenderSystemGLES::ResetGUIState()
+{
+  m_guiState = GUIState();
+  m_scissorsKnown = false;
+}
+
 void CRenderSystemGLES::InitialiseGUIShader()
 {
   if (!m_pGUIshader)
@@ -549,6 +674,9 @@ void CRenderSystemGLES::InitialiseGUIShader()
 
 void CRenderSystemGLES::EnableGUIShader(ESHADERMETHOD method)
 {
+  // the batched GUI textures are drawn with the shader they were batched for
+  CGUITexture::Flush();
+
   m_method = method;
   if (m_pGUIshader[m_method])
   {
@@ -36,6 +36,7 @@
 #include "settings/lib/Setting.h"
 #include "settings/Settings.h"
 #include "settings/SettingUtils.h"
+#include "threads/ThreadRoles.h"
 #include "system.h"
 #include "utils/LangCodeExpander.h"
 #include "utils/log.h"
@@ -257,6 +258,7 @@ void CAdvancedSettings::Initialize()
 
   m_fanartRes = 1080;
   m_imageRes = 720;
+  m_useDDSTextures = false;
   m_imageScalingAlgorithm = CPictureScalingAlgorithm::Default;
 
   m_sambaclienttimeout = 30;
@@ -282,6 +284,7 @@ void CAdvancedSettings::Initialize()
   m_musicArtistSeparators = { ";", " feat. ", " ft. " };
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
+  m_iMusicLibraryScanBatchSize = 50; // albums per transaction while scanning
 
   m_bVideoLibraryAllItemsOnBottom = false;
   m_iVideoLibraryRecentlyAddedItems = 25;
@@ -292,6 +295,7 @@ void CAdvancedSettings::Initialize()
   m_bVideoLibraryImportResumePoint = false;
   m_bVideoScannerIgnoreErrors = false;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
+  m_iVideoLibraryScanBatchSize = 50; // items per transaction while scanning
 
   m_iEpgUpdateCheckInterval = 300; /* check if tables need to be updated every 5 minutes */
   m_iEpgCleanupInterval = 900;     /* remove old entries from the EPG every 15 minutes */
@@ -371,11 +375,15 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiTextureUploadBudget = 4;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
   m_databaseMusic.Reset();
   m_databaseVideo.Reset();
+  m_bSqliteWal = true;
+  m_iSqliteWalAutoCheckpoint = 1000;
+  m_iSqliteConnectionPool = 4;
 
   m_pictureExtensions = ".png|.jpg|.jpeg|.bmp|.gif|.ico|.tif|.tiff|.tga|.pcx|.cbz|.zip|.cbr|.rar|.rss|.webp|.jp2|.apng";
   m_musicExtensions = ".nsv|.m4a|.flac|.aac|.strm|.pls|.rm|.rma|.mpa|.wav|.wma|.ogg|.mp3|.mp2|.m3u|.gdm|.imf|.m15|.sfx|.uni|.ac3|.dts|.cue|.aif|.aiff|.wpl|.ape|.mac|.mpc|.mp+|.mpp|.shn|.zip|.rar|.wv|.dsp|.xsp|.xwav|.waa|.wvs|.wam|.gcm|.idsp|.mpdsp|.mss|.spt|.rsd|.sap|.cmc|.cmr|.dmc|.mpt|.mpd|.rmt|.tmc|.tm8|.tm2|.oga|.url|.pxml|.tta|.rss|.wtv|.mka|.tak|.opus|.dff|.dsf|.m4b";
@@ -727,6 +735,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "scanbatchsize", m_iMusicLibraryScanBatchSize, 1, 10000);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -754,6 +763,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "importwatchedstate", m_bVideoLibraryImportWatchedState);
     XMLUtils::GetBoolean(pElement, "importresumepoint", m_bVideoLibraryImportResumePoint);
     XMLUtils::GetInt(pElement, "dateadded", m_iVideoLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "scanbatchsize", m_iVideoLibraryScanBatchSize, 1, 10000);
   }
 
   pElement = pRootElement->FirstChildElement("videoscanner");
@@ -800,6 +810,40 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
   }
 
+  pElement = pRootElement->FirstChildElement("threadroles");
+  if (pElement)
+  {
+    TiXmlElement* pRole = pElement->FirstChildElement("role");
+    while (pRole)
+    {
+      const char* name = pRole->Attribute("name");
+      XbmcThreads::ThreadRole role = name ? XbmcThreads::CThreadRoles::GetRole(name) : XbmcThreads::ThreadRole::NONE;
+      if (role != XbmcThreads::ThreadRole::NONE)
+      {
+        // only the given settings replace the defaults of the role
+        XbmcThreads::ThreadRoleSettings settings = XbmcThreads::CThreadRoles::GetSettings(role);
+        std::string value;
+        if (XMLUtils::GetString(pRole, "policy", value))
+          settings.policy = XbmcThreads::CThreadRoles::GetPolicy(value);
+        XMLUtils::GetInt(pRole, "priority", settings.priority, 1, 99);
+        if (XMLUtils::GetInt(pRole, "nice", settings.nice, -20, 19))
+          settings.setNice = true;
+        if (XMLUtils::GetString(pRole, "cpus", value))
+        {
+          settings.cpus.clear();
+          for (const auto& cpu : StringUtils::Split(value, ','))
+            settings.cpus.push_back(strtoul(cpu.c_str(), nullptr, 10));
+        }
+        XMLUtils::GetPath(pRole, "cpuset", settings.cpuset);
+        XbmcThreads::CThreadRoles::SetSettings(role, settings);
+      }
+      else
+        CLog::Log(LOGWARNING, "Ignoring unknown thread role %s", name ? name : "");
+
+      pRole = pRole->NextSiblingElement("role");
+    }
+  }
+
   pElement = pRootElement->FirstChildElement("samba");
   if (pElement)
   {
@@ -1005,6 +1049,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   XMLUtils::GetFloat(pRootElement, "controllerdeadzone", m_controllerDeadzone, 0.0f, 1.0f);
   XMLUtils::GetUInt(pRootElement, "fanartres", m_fanartRes, 0, 1080);
   XMLUtils::GetUInt(pRootElement, "imageres", m_imageRes, 0, 1080);
+  XMLUtils::GetBoolean(pRootElement, "useddstextures", m_useDDSTextures);
   if (XMLUtils::GetString(pRootElement, "imagescalingalgorithm", tmp))
     m_imageScalingAlgorithm = CPictureScalingAlgorithm::FromString(tmp);
   XMLUtils::GetBoolean(pRootElement, "playlistasfolders", m_playlistAsFolders);
@@ -1167,6 +1212,14 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pDatabase, "compression", m_databaseSavestates.compression);
   }
 
+  pDatabase = pRootElement->FirstChildElement("sqlite");
+  if (pDatabase)
+  {
+    XMLUtils::GetBoolean(pDatabase, "wal", m_bSqliteWal);
+    XMLUtils::GetInt(pDatabase, "walautocheckpoint", m_iSqliteWalAutoCheckpoint, 0, 100000);
+    XMLUtils::GetInt(pDatabase, "connectionpool", m_iSqliteConnectionPool, 0, 32);
+  }
+
   pElement = pRootElement->FirstChildElement("enablemultimediakeys");
   if (pElement)
   {
@@ -1179,6 +1232,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetInt(pElement, "textureuploadbudget", m_guiTextureUploadBudget, 0, 100);
   }
 
   std::string seekSteps;
@@ -237,6 +237,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     unsigned int m_fanartRes; ///< \brief the maximal resolution to cache fanart at (assumes 16x9)
     unsigned int m_imageRes;  ///< \brief the maximal resolution to cache images at (assumes 16x9)
+    bool m_useDDSTextures;    ///< \brief whether to keep a DXT compressed copy of cached images for faster loading
     CPictureScalingAlgorithm::Algorithm m_imageScalingAlgorithm;
 
     int m_sambaclienttimeout;
@@ -252,6 +253,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     int m_iMusicLibraryRecentlyAddedItems;
     int m_iMusicLibraryDateAdded;
+    int m_iMusicLibraryScanBatchSize;
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
     bool m_bMusicLibraryPromptFullTagScan;
@@ -274,6 +276,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     bool m_bVideoScannerIgnoreErrors;
     int m_iVideoLibraryDateAdded;
+    int m_iVideoLibraryScanBatchSize;
 
     std::set<std::string> m_vecTokens;
 
@@ -337,10 +340,14 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     DatabaseSettings m_databaseEpg;   /*!< advanced EPG database setup */
     DatabaseSettings m_databaseADSP;  /*!< advanced audio dsp database setup */
     DatabaseSettings m_databaseSavestates; /*!< advanced savestate database setup */
+    bool m_bSqliteWal;              /*!< use write-ahead logging for sqlite databases, so readers don't block on writers */
+    int m_iSqliteWalAutoCheckpoint; /*!< number of WAL pages after which sqlite checkpoints automatically, 0 disables it */
+    int m_iSqliteConnectionPool;    /*!< number of idle sqlite connections kept open per database */
 
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    int  m_guiTextureUploadBudget; ///< \brief time in ms per frame to spend uploading background loaded textures
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
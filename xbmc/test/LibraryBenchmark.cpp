@@ -0,0 +1,135 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LibraryBenchmark.h"
+#include "TestUtils.h"
+#include "dbwrappers/Database.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/URIUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+std::string GetOutputDirectory()
+{
+  const std::string &output = CXBMCTestUtils::Instance().getBenchmarkOutput();
+  if (output.empty())
+    return CSpecialProtocol::TranslatePath("special://temp/");
+  return output;
+}
+}
+
+CLibraryBenchmark::CLibraryBenchmark(const std::string &suite)
+  : m_suite(suite),
+    m_results(CVariant::VariantTypeObject)
+{
+  m_results["suite"] = suite;
+  m_results["scale"] = CXBMCTestUtils::Instance().getBenchmarkScale();
+  m_results["info"] = CVariant(CVariant::VariantTypeObject);
+  m_results["results"] = CVariant(CVariant::VariantTypeArray);
+}
+
+unsigned int CLibraryBenchmark::Scaled(unsigned int fullSize)
+{
+  double size = fullSize * CXBMCTestUtils::Instance().getBenchmarkScale();
+  return std::max(1u, static_cast<unsigned int>(size));
+}
+
+bool CLibraryBenchmark::CreateDatabase(CDatabase &db, const std::string &name)
+{
+  std::string directory = GetOutputDirectory();
+  if (!XFILE::CDirectory::Exists(directory) && !XFILE::CDirectory::Create(directory))
+    return false;
+
+  std::string file = URIUtils::AddFileToFolder(directory, name + ".db");
+  XFILE::CFile::Delete(file);
+  XFILE::CFile::Delete(file + "-wal");
+  XFILE::CFile::Delete(file + "-shm");
+
+  DatabaseSettings settings;
+  settings.type = "sqlite3";
+  settings.host = directory;
+  return db.Connect(name, settings, true);
+}
+
+void CLibraryBenchmark::SetInfo(const std::string &key, const CVariant &value)
+{
+  m_results["info"][key] = value;
+}
+
+bool CLibraryBenchmark::Measure(const std::string &name, unsigned int iterations, const std::function<int()> &func)
+{
+  iterations = std::max(1u, iterations);
+
+  double total = 0.0, min = 0.0, max = 0.0;
+  int rows = 0;
+  bool success = true;
+  for (unsigned int i = 0; i < iterations; i++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    int result = func();
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (result < 0)
+      success = false;
+    rows = result;
+    total += elapsed;
+    min = i == 0 ? elapsed : std::min(min, elapsed);
+    max = std::max(max, elapsed);
+  }
+
+  CVariant result(CVariant::VariantTypeObject);
+  result["name"] = name;
+  result["success"] = success;
+  result["iterations"] = iterations;
+  result["rows"] = rows;
+  result["min_ms"] = min;
+  result["avg_ms"] = total / iterations;
+  result["max_ms"] = max;
+  m_results["results"].push_back(result);
+
+  printf("[ BENCHMARK] %s.%s: %d rows, avg %.3f ms, min %.3f ms, max %.3f ms%s\n",
+         m_suite.c_str(), name.c_str(), rows, total / iterations, min, max, success ? "" : " (FAILED)");
+  return success;
+}
+
+bool CLibraryBenchmark::Write() const
+{
+  if (CXBMCTestUtils::Instance().getBenchmarkOutput().empty())
+    return true;
+
+  std::string json;
+  if (!CJSONVariantWriter::Write(m_results, json, false))
+    return false;
+
+  std::string file = URIUtils::AddFileToFolder(GetOutputDirectory(), m_suite + ".json");
+  XFILE::CFile output;
+  if (!output.OpenForWrite(file, true))
+    return false;
+
+  return output.Write(json.c_str(), json.size()) == static_cast<ssize_t>(json.size());
+}
@@ -0,0 +1,66 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "utils/Variant.h"
+
+class CDatabase;
+
+/* Collects the timings of the library benchmarks and writes them as JSON.
+ *
+ * The benchmarks are disabled gtest cases, run them with
+ *   kodi-test --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+ * or the benchmark-library target. Every suite writes
+ * <output>/<suite>.json, see --set-benchmark-output.
+ */
+class CLibraryBenchmark
+{
+public:
+  explicit CLibraryBenchmark(const std::string &suite);
+
+  /* Scale the full size of a synthetic library by --set-benchmark-scale. */
+  static unsigned int Scaled(unsigned int fullSize);
+
+  /* Create an empty database with the current schema (tables and analytics)
+   * for the given database object. The database is created in the benchmark
+   * output directory if one was given, in special://temp otherwise. An
+   * existing database of the same name is replaced.
+   */
+  static bool CreateDatabase(CDatabase &db, const std::string &name);
+
+  /* Record a property of the benchmark run, e.g. the library size. */
+  void SetInfo(const std::string &key, const CVariant &value);
+
+  /* Run func the given number of times and record min/avg/max wall time.
+   * func returns the number of rows/items it processed, or a negative
+   * value on failure. Returns false if any iteration failed.
+   */
+  bool Measure(const std::string &name, unsigned int iterations, const std::function<int()> &func);
+
+  /* Write the results to the output directory, if set. */
+  bool Write() const;
+
+private:
+  std::string m_suite;
+  CVariant m_results;
+};
@@ -101,6 +101,7 @@ private:
 CXBMCTestUtils::CXBMCTestUtils()
 {
   probability = 0.01;
+  benchmarkScale = 0.1;
 }
 
 CXBMCTestUtils &CXBMCTestUtils::Instance()
@@ -275,6 +276,15 @@ static const char usage[] =
 "    The variable should be a double type from 0.0 to 1.0. Values given\n"
 "    less than 0.0 are treated as 0.0. Values greater than 1.0 are treated\n"
 "    as 1.0. The default probability is 0.01.\n"
+"\n"
+"  --set-benchmark-scale [SCALE]\n"
+"    Set the size of the synthetic libraries used by the library benchmarks\n"
+"    (run with --gtest_also_run_disabled_tests). A scale of 1.0 generates\n"
+"    100000 movies and 1000000 songs. The default scale is 0.1.\n"
+"\n"
+"  --set-benchmark-output [DIR]\n"
+"    Set the directory the library benchmarks write their JSON results and\n"
+"    synthetic databases to. Results are only printed if not set.\n"
 ;
 
 void CXBMCTestUtils::ParseArgs(int argc, char **argv)
@@ -344,6 +354,16 @@ void CXBMCTestUtils::ParseArgs(int argc, char **argv)
       else if (probability > 1.0)
         probability = 1.0;
     }
+    else if (arg == "--set-benchmark-scale")
+    {
+      benchmarkScale = atof(argv[++i]);
+      if (benchmarkScale <= 0.0)
+        benchmarkScale = 0.1;
+    }
+    else if (arg == "--set-benchmark-output")
+    {
+      benchmarkOutput = argv[++i];
+    }
     else
     {
       std::cerr << usage;
@@ -85,6 +85,13 @@ public:
   XFILE::CFile *CreateCorruptedFile(std::string const& strFileName,
                                     std::string const& suffix);
 
+  /* Functions to get the options used by the library benchmarks. The scale
+   * is applied to the full size of the synthetic libraries, the output
+   * directory receives the benchmark results and databases.
+   */
+  double getBenchmarkScale() const { return benchmarkScale; }
+  const std::string &getBenchmarkOutput() const { return benchmarkOutput; }
+
   /* Function to parse command line options */
   void ParseArgs(int argc, char **argv);
 
@@ -103,6 +110,9 @@ private:
   std::vector<std::string> GUISettingsFiles;
 
   double probability;
+
+  double benchmarkScale;
+  std::string benchmarkOutput;
 };
 
 #define XBMC_REF_FILE_PATH(s) CXBMCTestUtils::Instance().ReferenceFilePath(s)
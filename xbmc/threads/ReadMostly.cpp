@@ -0,0 +1,140 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ReadMostly.h"
+#include "threads/ThreadLocal.h"
+
+#include <limits>
+
+namespace
+{
+const unsigned int MAX_READERS = 256;
+
+struct ReaderSlot
+{
+  alignas(64) std::atomic<uint64_t> epoch; ///< 0 while the thread doesn't read
+  std::atomic<bool> used;
+};
+
+ReaderSlot g_readers[MAX_READERS];
+std::atomic<uint64_t> g_epoch(1);
+// readers that didn't get a slot, they hold back all reclamation while reading
+std::atomic<unsigned int> g_slotlessReaders(0);
+
+struct ThreadReader
+{
+  ThreadReader() : slot(nullptr), depth(0)
+  {
+    for (unsigned int i = 0; i < MAX_READERS; i++)
+    {
+      bool expected = false;
+      if (g_readers[i].used.compare_exchange_strong(expected, true))
+      {
+        slot = &g_readers[i];
+        break;
+      }
+    }
+  }
+
+  ~ThreadReader()
+  {
+    if (slot)
+      slot->used.store(false, std::memory_order_release);
+  }
+
+  ReaderSlot *slot;
+  unsigned int depth;
+};
+
+// the slot is given back by CEpoch::ReleaseThread, thread pools come and go
+XbmcThreads::ThreadLocal<ThreadReader> t_reader;
+
+ThreadReader &GetThreadReader()
+{
+  ThreadReader *reader = t_reader.get();
+  if (!reader)
+  {
+    reader = new ThreadReader();
+    t_reader.set(reader);
+  }
+  return *reader;
+}
+}
+
+namespace XbmcThreads
+{
+
+void CEpoch::EnterRead()
+{
+  ThreadReader &reader = GetThreadReader();
+  if (reader.depth++ > 0)
+    return;
+
+  // the value is loaded after this store, a writer scanning the slots either
+  // sees us reading or has already published its new value
+  if (reader.slot)
+    reader.slot->epoch.store(g_epoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+  else
+    g_slotlessReaders.fetch_add(1, std::memory_order_seq_cst);
+}
+
+void CEpoch::ExitRead()
+{
+  ThreadReader &reader = *t_reader.get();
+  if (--reader.depth > 0)
+    return;
+
+  if (reader.slot)
+    reader.slot->epoch.store(0, std::memory_order_release);
+  else
+    g_slotlessReaders.fetch_sub(1, std::memory_order_release);
+}
+
+void CEpoch::ReleaseThread()
+{
+  ThreadReader *reader = t_reader.get();
+  if (reader && reader->depth == 0)
+  {
+    delete reader;
+    t_reader.set(nullptr);
+  }
+}
+
+uint64_t CEpoch::Advance()
+{
+  return g_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+}
+
+uint64_t CEpoch::GetOldestReader()
+{
+  if (g_slotlessReaders.load(std::memory_order_seq_cst) > 0)
+    return 0;
+
+  uint64_t oldest = std::numeric_limits<uint64_t>::max();
+  for (unsigned int i = 0; i < MAX_READERS; i++)
+  {
+    uint64_t epoch = g_readers[i].epoch.load(std::memory_order_seq_cst);
+    if (epoch != 0 && epoch < oldest)
+      oldest = epoch;
+  }
+  return oldest;
+}
+
+}
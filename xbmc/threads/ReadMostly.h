@@ -0,0 +1,164 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+namespace XbmcThreads
+{
+  /**
+   * Epoch based reclamation shared by all CReadMostly instances.
+   *
+   * Every thread gets a slot where it publishes the epoch it entered a read
+   * section in, or 0 while it doesn't read. Memory retired by a writer in
+   * epoch E may be freed once no thread is still reading in an epoch before E.
+   * Read sections nest and cost two stores to the thread's own slot, no
+   * shared cache line is written.
+   */
+  class CEpoch
+  {
+  public:
+    static void EnterRead();
+    static void ExitRead();
+
+    /**
+     * Give the reader slot of the calling thread back. Called by CThread when
+     * a thread ends, other threads keep their slot until the process exits.
+     */
+    static void ReleaseThread();
+
+    /**
+     * Start a new epoch, to be called by a writer right after unpublishing
+     * memory. Returns the epoch the memory can be freed in.
+     */
+    static uint64_t Advance();
+
+    /**
+     * The oldest epoch a thread is reading in, UINT64_MAX if no thread reads.
+     */
+    static uint64_t GetOldestReader();
+  };
+}
+
+/**
+ * A read-mostly value, readers never block and never wait for writers.
+ *
+ * The value is an immutable snapshot. Readers look at the current snapshot
+ * through a CReader, writers copy it, modify the copy and publish it. Old
+ * snapshots are freed by later writers once no reader can see them anymore.
+ * Writers are serialized and each write copies the whole value, so it's meant
+ * for registries that are read all the time and changed rarely.
+ *
+ * References taken from a CReader are only valid while the reader lives.
+ */
+template<typename T>
+class CReadMostly
+{
+public:
+  class CReader
+  {
+  public:
+    explicit CReader(const CReadMostly<T> &value)
+    {
+      XbmcThreads::CEpoch::EnterRead();
+      m_value = value.m_value.load(std::memory_order_seq_cst);
+    }
+    ~CReader() { XbmcThreads::CEpoch::ExitRead(); }
+
+    const T& operator*() const { return *m_value; }
+    const T* operator->() const { return m_value; }
+
+  private:
+    CReader(const CReader&) = delete;
+    CReader& operator=(const CReader&) = delete;
+
+    const T *m_value;
+  };
+
+  CReadMostly() : m_value(new T()) {}
+  explicit CReadMostly(T value) : m_value(new T(std::move(value))) {}
+
+  /**
+   * No reader may be left when the value is destroyed.
+   */
+  ~CReadMostly()
+  {
+    delete m_value.load();
+    for (auto &retired : m_retired)
+      delete retired.second;
+  }
+
+  /**
+   * Replace the value.
+   */
+  void Set(T value)
+  {
+    CSingleLock lock(m_writeSection);
+    Publish(new T(std::move(value)));
+  }
+
+  /**
+   * Modify a copy of the value and publish it.
+   * \param modify called with the copy, writers are serialized
+   */
+  template<typename F>
+  void Update(F modify)
+  {
+    CSingleLock lock(m_writeSection);
+    std::unique_ptr<T> value(new T(*m_value.load(std::memory_order_relaxed)));
+    modify(*value);
+    Publish(value.release());
+  }
+
+private:
+  CReadMostly(const CReadMostly&) = delete;
+  CReadMostly& operator=(const CReadMostly&) = delete;
+
+  void Publish(const T *value)
+  {
+    const T *old = m_value.exchange(value, std::memory_order_seq_cst);
+    m_retired.push_back(std::make_pair(XbmcThreads::CEpoch::Advance(), old));
+
+    uint64_t oldestReader = XbmcThreads::CEpoch::GetOldestReader();
+    auto it = m_retired.begin();
+    while (it != m_retired.end())
+    {
+      if (it->first <= oldestReader)
+      {
+        delete it->second;
+        it = m_retired.erase(it);
+      }
+      else
+        ++it;
+    }
+  }
+
+  std::atomic<const T*> m_value;
+  CCriticalSection m_writeSection;
+  std::vector<std::pair<uint64_t, const T*>> m_retired; ///< epoch each snapshot can be freed in
+};
@@ -57,5 +57,29 @@ namespace XbmcThreads
     }
     return (unsigned int)(now_time - start_time);
   }
+
+  int64_t SystemClockNanos()
+  {
+#if defined(TARGET_DARWIN)
+    static mach_timebase_info_data_t timebase = {};
+    if (timebase.denom == 0)
+      mach_timebase_info(&timebase);
+    return (int64_t)(mach_absolute_time() * timebase.numer / timebase.denom);
+#elif defined(TARGET_WINDOWS)
+    static LARGE_INTEGER frequency = {};
+    if (frequency.QuadPart == 0)
+      QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    // split to not overflow the multiplication
+    return (now.QuadPart / frequency.QuadPart) * 1000000000 + (now.QuadPart % frequency.QuadPart) * 1000000000 / frequency.QuadPart;
+#else
+    // CLOCK_MONOTONIC is served by the vdso, unlike CLOCK_MONOTONIC_RAW on older kernels
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+  }
+
   const unsigned int EndTime::InfiniteValue = std::numeric_limits<unsigned int>::max();
 }
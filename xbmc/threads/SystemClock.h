@@ -21,6 +21,7 @@
 #pragma once
 
 #include <limits>
+#include <stdint.h>
 
 namespace XbmcThreads
 {
@@ -34,6 +35,13 @@ namespace XbmcThreads
    */
   unsigned int SystemClockMillis();
 
+  /**
+   * Nanoseconds of a monotonic clock with an arbitrary reference point, for
+   *  measuring short durations such as per frame or per packet costs. It
+   *  doesn't wrap and is cheap enough to be called on hot paths.
+   */
+  int64_t SystemClockNanos();
+
   /**
    * DO NOT compare the results from SystemClockMillis() to an expected end time
    *  that was calculated by adding a number of milliseconds to some start time.
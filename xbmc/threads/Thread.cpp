@@ -24,6 +24,8 @@
 #include "Thread.h"
 #include "threads/ThreadLocal.h"
 #include "threads/SingleLock.h"
+#include "threads/ReadMostly.h"
+#include "threads/Trace.h"
 #include "commons/Exception.h"
 #include <stdlib.h>
 
@@ -52,6 +54,7 @@ CThread::CThread(const char* ThreadName)
   m_iLastTime = 0;
   m_iLastUsage = 0;
   m_fLastUsage = 0.0f;
+  m_role = XbmcThreads::ThreadRole::NONE;
 
   m_pRunnable=NULL;
 
@@ -69,6 +72,7 @@ CThread::CThread(IRunnable* pRunnable, const char* ThreadName)
   m_iLastTime = 0;
   m_iLastUsage = 0;
   m_fLastUsage = 0.0f;
+  m_role = XbmcThreads::ThreadRole::NONE;
 
   m_pRunnable=pRunnable;
 
@@ -122,6 +126,7 @@ THREADFUNC CThread::staticThread(void* data)
   autodelete = pThread->m_bAutoDelete;
 
   pThread->SetThreadInfo();
+  XbmcThreads::CThreadRoles::Enter(pThread->m_role);
 
   LOG(LOGDEBUG,"Thread %s start, auto delete: %s", name.c_str(), (autodelete ? "true" : "false"));
 
@@ -130,6 +135,10 @@ THREADFUNC CThread::staticThread(void* data)
 
   pThread->Action();
 
+  XbmcThreads::CThreadRoles::Leave();
+  XbmcThreads::CEpoch::ReleaseThread();
+  XbmcThreads::CTrace::ReleaseThread();
+
   // lock during termination
   CSingleLock lock(pThread->m_CriticalSection);
 
@@ -184,6 +193,13 @@ bool CThread::IsCurrentThread() const
   return IsCurrentThread(ThreadId());
 }
 
+void CThread::SetRole(XbmcThreads::ThreadRole role)
+{
+  m_role = role;
+  if (IsCurrentThread())
+    XbmcThreads::CThreadRoles::Enter(role);
+}
+
 CThread* CThread::GetCurrentThread()
 {
   return currentThread.get();
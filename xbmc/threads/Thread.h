@@ -30,6 +30,7 @@
 #include "Event.h"
 #include "threads/ThreadImpl.h"
 #include "threads/ThreadLocal.h"
+#include "threads/ThreadRoles.h"
 #include "commons/ilog.h"
 
 #ifdef TARGET_DARWIN
@@ -75,6 +76,13 @@ public:
   int GetNormalPriority(void);
   int GetPriority(void);
   bool SetPriority(const int iPriority);
+
+  /**
+   * Set the role deciding the scheduling of the thread, see XbmcThreads::CThreadRoles.
+   * Call it before Create() or from the thread itself. SetPriority() has no
+   * effect once the role sets the nice level.
+   */
+  void SetRole(XbmcThreads::ThreadRole role);
   bool WaitForThreadExit(unsigned int milliseconds);
   float GetRelativeUsage();  // returns the relative cpu usage of this thread since last call
   int64_t GetAbsoluteUsage();
@@ -134,6 +142,7 @@ private:
   uint64_t m_iLastUsage;
   uint64_t m_iLastTime;
   float m_fLastUsage;
+  XbmcThreads::ThreadRole m_role;
 
   std::string m_ThreadName;
 };
@@ -0,0 +1,358 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ThreadRoles.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "threads/ThreadLocal.h"
+
+#include <algorithm>
+#include <map>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+#include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+
+#define LOG if (CThread::GetLogger()) CThread::GetLogger()->Log
+
+using namespace XbmcThreads;
+
+namespace
+{
+struct RoleInfo
+{
+  const char *name;
+  ThreadRoleSettings settings;
+  bool warned;                ///< a setting failed to apply, logged once
+  uint64_t endedSwitches;     ///< involuntary context switches of threads that left the role
+  uint64_t loggedSwitches;
+};
+
+struct ThreadInfo
+{
+  ThreadRole role;
+  uint64_t baseSwitches; ///< involuntary context switches before the thread took the role
+};
+
+ThreadRoleSettings Background(ThreadRoleSettings::Policy policy)
+{
+  // scans and jobs must not take the cores from playback
+  ThreadRoleSettings settings;
+  settings.policy = policy;
+  settings.setNice = true;
+  settings.nice = 5;
+  return settings;
+}
+
+CCriticalSection g_rolesSection;
+RoleInfo g_roles[] =
+{
+  { "none", ThreadRoleSettings(), false, 0, 0 },
+  { "audio-realtime", ThreadRoleSettings(), false, 0, 0 },
+  { "video-decode", ThreadRoleSettings(), false, 0, 0 },
+  { "render", ThreadRoleSettings(), false, 0, 0 },
+  { "background-io", Background(ThreadRoleSettings::Policy::DEFAULT), false, 0, 0 },
+  { "background-cpu", Background(ThreadRoleSettings::Policy::BATCH), false, 0, 0 },
+};
+static_assert(sizeof(g_roles) / sizeof(g_roles[0]) == static_cast<size_t>(ThreadRole::COUNT), "missing thread role");
+
+std::map<long, ThreadInfo> g_threads; ///< running threads with a role, by lwp id
+XbmcThreads::ThreadLocal<RoleInfo> t_role; ///< entry in g_roles of the current thread, none if null
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+long GetCurrentLwp()
+{
+  return syscall(SYS_gettid);
+}
+
+uint64_t GetCurrentInvoluntarySwitches()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_THREAD, &usage) != 0)
+    return 0;
+  return usage.ru_nivcsw;
+}
+
+uint64_t GetInvoluntarySwitches(long lwp)
+{
+  char path[64];
+  snprintf(path, sizeof(path), "/proc/self/task/%ld/status", lwp);
+  FILE *file = fopen(path, "r");
+  if (!file)
+    return 0;
+
+  uint64_t switches = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), file))
+  {
+    if (sscanf(line, "nonvoluntary_ctxt_switches: %" SCNu64, &switches) == 1)
+      break;
+  }
+  fclose(file);
+  return switches;
+}
+
+bool WriteCpuset(const std::string &cpuset, long lwp)
+{
+  // cgroup v2 moves single threads through cgroup.threads, v1 through tasks
+  for (const char *name : { "/cgroup.threads", "/tasks" })
+  {
+    FILE *file = fopen((cpuset + name).c_str(), "w");
+    if (!file)
+      continue;
+    bool written = fprintf(file, "%ld\n", lwp) > 0;
+    if (fclose(file) == 0 && written)
+      return true;
+  }
+  return false;
+}
+
+bool Apply(const char *name, const ThreadRoleSettings &settings, long lwp, bool log)
+{
+  bool result = true;
+
+  if (settings.policy != ThreadRoleSettings::Policy::DEFAULT)
+  {
+    int policy = SCHED_OTHER;
+    switch (settings.policy)
+    {
+    case ThreadRoleSettings::Policy::BATCH: policy = SCHED_BATCH; break;
+    case ThreadRoleSettings::Policy::IDLE: policy = SCHED_IDLE; break;
+    case ThreadRoleSettings::Policy::FIFO: policy = SCHED_FIFO; break;
+    case ThreadRoleSettings::Policy::RR: policy = SCHED_RR; break;
+    default: break;
+    }
+
+    struct sched_param param = {};
+    if (policy == SCHED_FIFO || policy == SCHED_RR)
+      param.sched_priority = std::max(sched_get_priority_min(policy), std::min(settings.priority, sched_get_priority_max(policy)));
+
+    if (sched_setscheduler(0, policy, &param) != 0)
+    {
+      if (log)
+        LOG(LOGWARNING, "CThreadRoles: unable to set the scheduling policy of role %s: %s", name, strerror(errno));
+      result = false;
+    }
+  }
+
+  if (settings.setNice)
+  {
+    // the main thread may take a role too, keep the level it started with
+    static const int appNice = getpriority(PRIO_PROCESS, getpid());
+    if (setpriority(PRIO_PROCESS, lwp, appNice + settings.nice) != 0)
+    {
+      if (log)
+        LOG(LOGWARNING, "CThreadRoles: unable to set the nice level of role %s: %s", name, strerror(errno));
+      result = false;
+    }
+  }
+
+  if (!settings.cpus.empty())
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (unsigned int cpu : settings.cpus)
+    {
+      if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &cpus);
+    }
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+    {
+      if (log)
+        LOG(LOGWARNING, "CThreadRoles: unable to set the cpu affinity of role %s: %s", name, strerror(errno));
+      result = false;
+    }
+  }
+
+  if (!settings.cpuset.empty() && !WriteCpuset(settings.cpuset, lwp))
+  {
+    if (log)
+      LOG(LOGWARNING, "CThreadRoles: unable to move role %s to cpuset %s", name, settings.cpuset.c_str());
+    result = false;
+  }
+
+  return result;
+}
+#else
+long GetCurrentLwp()
+{
+  return 0;
+}
+
+uint64_t GetCurrentInvoluntarySwitches()
+{
+  return 0;
+}
+
+uint64_t GetInvoluntarySwitches(long lwp)
+{
+  return 0;
+}
+
+bool Apply(const char *name, const ThreadRoleSettings &settings, long lwp, bool log)
+{
+  if (settings.policy == ThreadRoleSettings::Policy::DEFAULT && !settings.setNice &&
+      settings.cpus.empty() && settings.cpuset.empty())
+    return true;
+
+  if (log)
+    LOG(LOGWARNING, "CThreadRoles: the settings of role %s are not supported on this platform", name);
+  return false;
+}
+#endif
+}
+
+const char *CThreadRoles::GetName(ThreadRole role)
+{
+  return g_roles[static_cast<int>(role)].name;
+}
+
+ThreadRole CThreadRoles::GetRole(const std::string &name)
+{
+  for (int role = 0; role < static_cast<int>(ThreadRole::COUNT); role++)
+  {
+    if (name == g_roles[role].name)
+      return static_cast<ThreadRole>(role);
+  }
+  return ThreadRole::NONE;
+}
+
+ThreadRoleSettings CThreadRoles::GetSettings(ThreadRole role)
+{
+  CSingleLock lock(g_rolesSection);
+  return g_roles[static_cast<int>(role)].settings;
+}
+
+void CThreadRoles::SetSettings(ThreadRole role, const ThreadRoleSettings &settings)
+{
+  CSingleLock lock(g_rolesSection);
+  g_roles[static_cast<int>(role)].settings = settings;
+  g_roles[static_cast<int>(role)].warned = false;
+}
+
+ThreadRoleSettings::Policy CThreadRoles::GetPolicy(const std::string &name)
+{
+  if (name == "other")
+    return ThreadRoleSettings::Policy::OTHER;
+  if (name == "batch")
+    return ThreadRoleSettings::Policy::BATCH;
+  if (name == "idle")
+    return ThreadRoleSettings::Policy::IDLE;
+  if (name == "fifo")
+    return ThreadRoleSettings::Policy::FIFO;
+  if (name == "rr")
+    return ThreadRoleSettings::Policy::RR;
+  return ThreadRoleSettings::Policy::DEFAULT;
+}
+
+bool CThreadRoles::Enter(ThreadRole role)
+{
+  if (t_role.get())
+    Leave();
+  if (role == ThreadRole::NONE)
+    return true;
+
+  long lwp = GetCurrentLwp();
+  ThreadRoleSettings settings;
+  bool log;
+  {
+    CSingleLock lock(g_rolesSection);
+    RoleInfo &info = g_roles[static_cast<int>(role)];
+    settings = info.settings;
+    log = !info.warned;
+    g_threads[lwp] = { role, GetCurrentInvoluntarySwitches() };
+  }
+  t_role.set(&g_roles[static_cast<int>(role)]);
+
+  bool result = Apply(GetName(role), settings, lwp, log);
+  if (!result && log)
+  {
+    CSingleLock lock(g_rolesSection);
+    g_roles[static_cast<int>(role)].warned = true;
+  }
+  return result;
+}
+
+void CThreadRoles::Leave()
+{
+  RoleInfo *role = t_role.get();
+  if (!role)
+    return;
+
+  uint64_t switches = GetCurrentInvoluntarySwitches();
+  CSingleLock lock(g_rolesSection);
+  auto thread = g_threads.find(GetCurrentLwp());
+  if (thread != g_threads.end())
+  {
+    role->endedSwitches += switches - thread->second.baseSwitches;
+    g_threads.erase(thread);
+  }
+  t_role.set(nullptr);
+}
+
+uint64_t CThreadRoles::GetInvoluntaryContextSwitches(ThreadRole role)
+{
+  CSingleLock lock(g_rolesSection);
+  uint64_t switches = g_roles[static_cast<int>(role)].endedSwitches;
+  for (const auto &thread : g_threads)
+  {
+    if (thread.second.role != role)
+      continue;
+    // the thread may have ended meanwhile
+    uint64_t current = GetInvoluntarySwitches(thread.first);
+    if (current > thread.second.baseSwitches)
+      switches += current - thread.second.baseSwitches;
+  }
+  return switches;
+}
+
+void CThreadRoles::LogStatistics()
+{
+  CSingleLock lock(g_rolesSection);
+  for (int role = static_cast<int>(ThreadRole::NONE) + 1; role < static_cast<int>(ThreadRole::COUNT); role++)
+  {
+    unsigned int threads = 0;
+    for (const auto &thread : g_threads)
+    {
+      if (thread.second.role == static_cast<ThreadRole>(role))
+        threads++;
+    }
+
+    RoleInfo &info = g_roles[role];
+    uint64_t switches = GetInvoluntaryContextSwitches(static_cast<ThreadRole>(role));
+    if (threads == 0 && switches == info.loggedSwitches)
+      continue;
+
+    LOG(LOGDEBUG, "CThreadRoles: role %s, %u threads, %" PRIu64" involuntary context switches (%" PRIu64" since last report)",
+        info.name, threads, switches, switches - info.loggedSwitches);
+    info.loggedSwitches = switches;
+  }
+}
@@ -0,0 +1,104 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace XbmcThreads
+{
+  /**
+   * What a thread is used for, decides how the scheduler treats it.
+   */
+  enum class ThreadRole
+  {
+    NONE,
+    AUDIO_REALTIME, ///< audio engine, sink and player audio, must never starve
+    VIDEO_DECODE,   ///< demuxer and video decoder
+    RENDER,         ///< the thread rendering the GUI and video
+    BACKGROUND_IO,  ///< library scanners
+    BACKGROUND_CPU, ///< low priority jobs and service add-ons
+    COUNT
+  };
+
+  struct ThreadRoleSettings
+  {
+    enum class Policy
+    {
+      DEFAULT, ///< keep the policy the thread was created with
+      OTHER,
+      BATCH,
+      IDLE,
+      FIFO,
+      RR
+    };
+
+    Policy policy = Policy::DEFAULT;
+    int priority = 0;               ///< static priority of FIFO and RR, 1 - 99
+    bool setNice = false;
+    int nice = 0;                   ///< relative to the nice level of the application
+    std::vector<unsigned int> cpus; ///< cores the threads may run on, all if empty
+    std::string cpuset;             ///< cgroup directory the threads are moved to, none if empty
+  };
+
+  /**
+   * Registry mapping thread roles to scheduling settings.
+   *
+   * A thread takes a role when it starts, see CThread::SetRole, and the
+   * settings of the role are applied to it. The registry keeps count of the
+   * involuntary context switches of all threads per role, so starved threads
+   * show up in the log. Settings can only be applied where the platform
+   * supports them (currently Linux), failures are logged and ignored.
+   */
+  class CThreadRoles
+  {
+  public:
+    static const char *GetName(ThreadRole role);
+    static ThreadRole GetRole(const std::string &name);
+
+    static ThreadRoleSettings GetSettings(ThreadRole role);
+    static void SetSettings(ThreadRole role, const ThreadRoleSettings &settings);
+    static ThreadRoleSettings::Policy GetPolicy(const std::string &name);
+
+    /**
+     * Apply the role to the calling thread.
+     * \return false if one of the settings could not be applied
+     */
+    static bool Enter(ThreadRole role);
+
+    /**
+     * Called by the thread before it ends, to account its context switches.
+     */
+    static void Leave();
+
+    /**
+     * Involuntary context switches of all threads that had the role, running or not.
+     */
+    static uint64_t GetInvoluntaryContextSwitches(ThreadRole role);
+
+    /**
+     * Log the number of threads and the involuntary context switches per role,
+     * since the last call.
+     */
+    static void LogStatistics();
+  };
+}
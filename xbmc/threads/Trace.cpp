@@ -0,0 +1,241 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Trace.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "threads/ThreadLocal.h"
+
+#include <map>
+#include <stdio.h>
+#include <vector>
+
+using namespace XbmcThreads;
+
+namespace
+{
+struct Event
+{
+  std::atomic<uint64_t> sequence; ///< index + 1 of the event stored in this slot, 0 while written
+  const char *category;
+  const char *name;
+  uint64_t thread;
+  int64_t start;
+  int64_t value; ///< the end of a span or the value of a counter
+  bool counter;
+};
+
+struct ThreadBuffer
+{
+  ThreadBuffer() : next(0), used(false)
+  {
+    for (auto &event : events)
+      event.sequence = 0;
+  }
+
+  Event events[CTrace::BUFFER_SIZE];
+  std::atomic<uint64_t> next; ///< only written by the owning thread
+  std::atomic<bool> used;
+};
+
+// buffers are only allocated by threads that record something and are never
+// freed, the exporter may still read them. New threads take over the buffer
+// of a thread that ended.
+CCriticalSection g_buffersSection;
+std::vector<ThreadBuffer*> g_buffers;
+std::atomic<int64_t> g_startNanos(0);
+
+// buffer of the current thread, given back by CTrace::ReleaseThread
+XbmcThreads::ThreadLocal<ThreadBuffer> t_buffer;
+
+ThreadBuffer &GetThreadBuffer()
+{
+  ThreadBuffer *own = t_buffer.get();
+  if (!own)
+  {
+    CSingleLock lock(g_buffersSection);
+    for (auto buffer : g_buffers)
+    {
+      if (!buffer->used.load(std::memory_order_acquire))
+      {
+        own = buffer;
+        break;
+      }
+    }
+
+    if (!own)
+    {
+      own = new ThreadBuffer();
+      g_buffers.push_back(own);
+    }
+    own->used = true;
+    t_buffer.set(own);
+  }
+  return *own;
+}
+
+void AddEvent(const char *category, const char *name, int64_t start, int64_t value, bool counter)
+{
+  ThreadBuffer &buffer = GetThreadBuffer();
+  uint64_t index = buffer.next.load(std::memory_order_relaxed);
+  buffer.next.store(index + 1, std::memory_order_release);
+  Event &event = buffer.events[index & (CTrace::BUFFER_SIZE - 1)];
+
+  // the slot is invalid until all fields are written, older events are overwritten
+  event.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  event.category = category;
+  event.name = name;
+  event.thread = (uint64_t)CThread::GetCurrentThreadId();
+  event.start = start;
+  event.value = value;
+  event.counter = counter;
+  event.sequence.store(index + 1, std::memory_order_release);
+}
+
+void AppendString(std::string &json, const char *str)
+{
+  json += '"';
+  for (; *str; str++)
+  {
+    if (*str == '"' || *str == '\\')
+      json += '\\';
+    if ((unsigned char)*str >= 0x20)
+      json += *str;
+  }
+  json += '"';
+}
+
+void AppendMicros(std::string &json, int64_t nanos)
+{
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.3f", nanos / 1000.0);
+  json += buffer;
+}
+}
+
+std::atomic<bool> CTrace::m_enabled(false);
+
+void CTrace::Start()
+{
+  g_startNanos = SystemClockNanos();
+  m_enabled.store(true, std::memory_order_release);
+}
+
+void CTrace::Stop()
+{
+  m_enabled.store(false, std::memory_order_release);
+}
+
+void CTrace::AddSpan(const char *category, const char *name, int64_t startNanos, int64_t endNanos)
+{
+  AddEvent(category, name, startNanos, endNanos, false);
+}
+
+void CTrace::AddCounter(const char *category, const char *name, int64_t value)
+{
+  AddEvent(category, name, SystemClockNanos(), value, true);
+}
+
+void CTrace::ReleaseThread()
+{
+  ThreadBuffer *buffer = t_buffer.get();
+  if (buffer)
+  {
+    buffer->used.store(false, std::memory_order_release);
+    t_buffer.set(nullptr);
+  }
+}
+
+std::string CTrace::ExportChromeTrace(uint64_t mainThread)
+{
+  struct Copy
+  {
+    const char *category;
+    const char *name;
+    uint64_t thread;
+    int64_t start;
+    int64_t value;
+    bool counter;
+  };
+
+  std::vector<Copy> events;
+  const int64_t startNanos = g_startNanos;
+  {
+    CSingleLock lock(g_buffersSection);
+    for (const auto buffer : g_buffers)
+    {
+      uint64_t last = buffer->next.load(std::memory_order_acquire);
+      uint64_t first = last > BUFFER_SIZE ? last - BUFFER_SIZE : 0;
+      for (uint64_t index = first; index < last; index++)
+      {
+        const Event &event = buffer->events[index & (BUFFER_SIZE - 1)];
+        if (event.sequence.load(std::memory_order_acquire) != index + 1)
+          continue;
+        Copy copy = { event.category, event.name, event.thread, event.start, event.value, event.counter };
+        // skip events overwritten by the thread while we read them
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (event.sequence.load(std::memory_order_relaxed) != index + 1)
+          continue;
+        if (copy.start >= startNanos)
+          events.push_back(copy);
+      }
+    }
+  }
+
+  // chrome expects small thread ids, the application thread is always 1
+  std::map<uint64_t, int> threads;
+  threads[mainThread] = 1;
+
+  std::string json = "{\"traceEvents\":[";
+  for (const auto &event : events)
+  {
+    auto thread = threads.insert(std::make_pair(event.thread, static_cast<int>(threads.size()) + 1)).first;
+
+    json += "\n{\"name\":";
+    AppendString(json, event.name);
+    json += ",\"cat\":";
+    AppendString(json, event.category);
+    json += ",\"ts\":";
+    AppendMicros(json, event.start - startNanos);
+    if (event.counter)
+    {
+      json += ",\"ph\":\"C\",\"args\":{\"value\":" + std::to_string(event.value) + "}";
+    }
+    else
+    {
+      json += ",\"ph\":\"X\",\"dur\":";
+      AppendMicros(json, event.value - event.start);
+    }
+    json += ",\"pid\":1,\"tid\":" + std::to_string(thread->second) + "},";
+  }
+
+  for (const auto &thread : threads)
+  {
+    json += "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(thread.second) + ",\"args\":{\"name\":";
+    AppendString(json, thread.second == 1 ? "Application" : ("Thread " + std::to_string(thread.second)).c_str());
+    json += "}},";
+  }
+
+  json.back() = ']';
+  json += ",\n\"displayTimeUnit\":\"ms\"}\n";
+  return json;
+}
@@ -0,0 +1,100 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+#include "threads/SystemClock.h"
+
+namespace XbmcThreads
+{
+  /**
+   * Records timed spans and counters of any thread into a per thread ring
+   * buffer, to be exported as a Chrome trace (chrome://tracing or
+   * https://ui.perfetto.dev).
+   *
+   * Names and categories must be string literals, only their pointers are
+   * stored. While tracing is stopped recording costs a relaxed load, so spans
+   * can stay in hot paths. Each thread keeps its latest BUFFER_SIZE events.
+   */
+  class CTrace
+  {
+  public:
+    static const unsigned int BUFFER_SIZE = 1 << 14; // power of 2
+
+    static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Drop all recorded events and start recording.
+     */
+    static void Start();
+    static void Stop();
+
+    static void AddSpan(const char *category, const char *name, int64_t startNanos, int64_t endNanos);
+    static void AddCounter(const char *category, const char *name, int64_t value);
+
+    /**
+     * Give the buffer of the calling thread to the next thread that records,
+     * its events are kept. Called by CThread when a thread ends.
+     */
+    static void ReleaseThread();
+
+    /**
+     * Write the recorded events in the Chrome trace event format.
+     * Can be called while recording, events written meanwhile may be missing.
+     * \param mainThread the thread shown first and named "Application"
+     */
+    static std::string ExportChromeTrace(uint64_t mainThread);
+
+  private:
+    static std::atomic<bool> m_enabled;
+  };
+
+  /**
+   * Records the enclosing scope as a span, does nothing unless tracing is running.
+   */
+  class CTraceScope
+  {
+  public:
+    CTraceScope(const char *category, const char *name)
+      : m_category(category),
+        m_name(name),
+        m_start(CTrace::IsEnabled() ? SystemClockNanos() : 0)
+    {
+    }
+
+    ~CTraceScope()
+    {
+      if (m_start && CTrace::IsEnabled())
+        CTrace::AddSpan(m_category, m_name, m_start, SystemClockNanos());
+    }
+
+  private:
+    CTraceScope(const CTraceScope&) = delete;
+    CTraceScope& operator=(const CTraceScope&) = delete;
+
+    const char *m_category;
+    const char *m_name;
+    int64_t m_start;
+  };
+}
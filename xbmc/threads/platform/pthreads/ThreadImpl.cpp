@@ -153,6 +153,8 @@ bool CThread::SetPriority(const int iPriority)
 
   if (!m_ThreadId)
     bReturn = false;
+  else if (XbmcThreads::CThreadRoles::GetSettings(m_role).setNice)
+    bReturn = true; // the role decides
   else if (iPriority >= minRR)
     bReturn = SetPrioritySched_RR(iPriority);
 #ifdef RLIMIT_NICE
@@ -0,0 +1,139 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "threads/ReadMostly.h"
+#include "threads/test/TestHelpers.h"
+
+#include <map>
+#include <vector>
+
+struct Counted
+{
+  static std::atomic<int> alive;
+
+  explicit Counted(int value_ = 0) : value(value_) { ++alive; }
+  Counted(const Counted &other) : value(other.value) { ++alive; }
+  ~Counted() { value = -1; --alive; }
+
+  int value;
+};
+
+std::atomic<int> Counted::alive(0);
+
+class ReadMostlyReader : public IRunnable
+{
+  CReadMostly<std::vector<int>> &m_value;
+  std::atomic<bool> &m_stop;
+
+public:
+  bool consistent;
+  unsigned int reads;
+
+  ReadMostlyReader(CReadMostly<std::vector<int>> &value, std::atomic<bool> &stop) :
+    m_value(value), m_stop(stop), consistent(true), reads(0) {}
+
+  void Run() override
+  {
+    while (!m_stop)
+    {
+      CReadMostly<std::vector<int>>::CReader reader(m_value);
+      // every element of a snapshot has the same value
+      for (int element : *reader)
+      {
+        if (element != reader->front())
+          consistent = false;
+      }
+      reads++;
+    }
+  }
+};
+
+TEST(TestReadMostly, General)
+{
+  CReadMostly<std::map<int, int>> value;
+  {
+    CReadMostly<std::map<int, int>>::CReader reader(value);
+    EXPECT_TRUE(reader->empty());
+  }
+
+  value.Update([](std::map<int, int> &map) { map[1] = 2; });
+  value.Set(std::map<int, int>{ { 3, 4 } });
+  value.Update([](std::map<int, int> &map) { map[5] = 6; });
+
+  CReadMostly<std::map<int, int>>::CReader reader(value);
+  EXPECT_EQ(2U, reader->size());
+  EXPECT_EQ(4, reader->at(3));
+  EXPECT_EQ(6, reader->at(5));
+}
+
+TEST(TestReadMostly, ReaderKeepsSnapshot)
+{
+  {
+    CReadMostly<Counted> value(Counted(1));
+    {
+      CReadMostly<Counted>::CReader reader(value);
+      const Counted &snapshot = *reader;
+
+      for (int i = 2; i < 10; i++)
+        value.Set(Counted(i));
+
+      // the snapshot we read from must not be freed while we read
+      EXPECT_EQ(1, snapshot.value);
+      EXPECT_EQ(1, reader->value);
+
+      CReadMostly<Counted>::CReader nested(value);
+      EXPECT_EQ(9, nested->value);
+    }
+
+    // no reader left, the next write frees all older snapshots
+    value.Set(Counted(10));
+    EXPECT_EQ(1, Counted::alive);
+  }
+  EXPECT_EQ(0, Counted::alive);
+}
+
+TEST(TestReadMostly, ConcurrentReadersAndWriter)
+{
+  CReadMostly<std::vector<int>> value(std::vector<int>(64, 0));
+  std::atomic<bool> stop(false);
+
+  ReadMostlyReader reader1(value, stop);
+  ReadMostlyReader reader2(value, stop);
+  thread thread1(reader1);
+  thread thread2(reader2);
+
+  for (int i = 1; i < 2000; i++)
+  {
+    value.Update([i](std::vector<int> &vector)
+    {
+      for (auto &element : vector)
+        element = i;
+    });
+  }
+
+  stop = true;
+  EXPECT_TRUE(thread1.timed_join(MILLIS(10000)));
+  EXPECT_TRUE(thread2.timed_join(MILLIS(10000)));
+  EXPECT_TRUE(reader1.consistent);
+  EXPECT_TRUE(reader2.consistent);
+
+  CReadMostly<std::vector<int>>::CReader reader(value);
+  EXPECT_EQ(1999, reader->back());
+}
@@ -0,0 +1,72 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "threads/ThreadRoles.h"
+#include "threads/test/TestHelpers.h"
+
+#if defined(TARGET_LINUX)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace XbmcThreads;
+
+class RoleWorker : public IRunnable
+{
+public:
+  int nice = 0;
+
+  void Run() override
+  {
+#if defined(TARGET_LINUX)
+    nice = getpriority(PRIO_PROCESS, syscall(SYS_gettid)) - getpriority(PRIO_PROCESS, getpid());
+#endif
+  }
+};
+
+TEST(TestThreadRoles, Names)
+{
+  for (int role = 0; role < static_cast<int>(ThreadRole::COUNT); role++)
+    EXPECT_EQ(static_cast<ThreadRole>(role), CThreadRoles::GetRole(CThreadRoles::GetName(static_cast<ThreadRole>(role))));
+  EXPECT_EQ(ThreadRole::NONE, CThreadRoles::GetRole("unknown"));
+  EXPECT_EQ(ThreadRoleSettings::Policy::FIFO, CThreadRoles::GetPolicy("fifo"));
+  EXPECT_EQ(ThreadRoleSettings::Policy::DEFAULT, CThreadRoles::GetPolicy("unknown"));
+}
+
+TEST(TestThreadRoles, ApplyNice)
+{
+  ThreadRoleSettings previous = CThreadRoles::GetSettings(ThreadRole::BACKGROUND_IO);
+  ThreadRoleSettings settings;
+  settings.setNice = true;
+  settings.nice = 3;
+  CThreadRoles::SetSettings(ThreadRole::BACKGROUND_IO, settings);
+
+  RoleWorker worker;
+  CThread thread(&worker, "RoleWorker");
+  thread.SetRole(ThreadRole::BACKGROUND_IO);
+  thread.Create();
+  EXPECT_TRUE(thread.WaitForThreadExit(10000));
+#if defined(TARGET_LINUX)
+  EXPECT_EQ(3, worker.nice);
+#endif
+
+  CThreadRoles::SetSettings(ThreadRole::BACKGROUND_IO, previous);
+}
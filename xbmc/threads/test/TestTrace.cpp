@@ -0,0 +1,82 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "threads/Trace.h"
+#include "threads/test/TestHelpers.h"
+
+using namespace XbmcThreads;
+
+class TraceWorker : public IRunnable
+{
+public:
+  void Run() override
+  {
+    CTraceScope scope("test", "Worker");
+    CTrace::AddCounter("test", "WorkerCounter", 42);
+  }
+};
+
+TEST(TestTrace, SystemClockNanos)
+{
+  int64_t start = SystemClockNanos();
+  unsigned int startMillis = SystemClockMillis();
+  while (SystemClockMillis() - startMillis < 2)
+    ;
+  EXPECT_GE(SystemClockNanos() - start, 1000000);
+}
+
+TEST(TestTrace, Disabled)
+{
+  CTrace::Stop();
+  {
+    CTraceScope scope("test", "NotRecorded");
+  }
+  CTrace::Start();
+  CTrace::Stop();
+  std::string json = CTrace::ExportChromeTrace((uint64_t)CThread::GetCurrentThreadId());
+  EXPECT_EQ(std::string::npos, json.find("NotRecorded"));
+}
+
+TEST(TestTrace, Export)
+{
+  CTrace::Start();
+  {
+    CTraceScope scope("test", "Main\"Scope");
+  }
+
+  TraceWorker worker;
+  thread thread(worker);
+  EXPECT_TRUE(thread.timed_join(MILLIS(10000)));
+  CTrace::Stop();
+
+  {
+    CTraceScope scope("test", "AfterStop");
+  }
+
+  std::string json = CTrace::ExportChromeTrace((uint64_t)CThread::GetCurrentThreadId());
+  EXPECT_EQ(0U, json.find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"Main\\\"Scope\",\"cat\":\"test\""));
+  EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"WorkerCounter\""));
+  EXPECT_NE(std::string::npos, json.find("\"args\":{\"value\":42}"));
+  EXPECT_NE(std::string::npos, json.find("\"tid\":2"));
+  EXPECT_NE(std::string::npos, json.find("{\"name\":\"Application\"}"));
+  EXPECT_EQ(std::string::npos, json.find("AfterStop"));
+}
@@ -22,6 +22,30 @@
 
 using namespace Actor;
 
+Message::~Message()
+{
+  delete [] heapBuffer;
+  delete event;
+}
+
+void Message::SetPayload(const void *payload, int size)
+{
+  if (size > MSG_INTERNAL_BUFFER_SIZE)
+  {
+    if (size > heapBufferSize)
+    {
+      delete [] heapBuffer;
+      heapBuffer = new uint8_t[size];
+      heapBufferSize = size;
+    }
+    data = heapBuffer;
+  }
+  else
+    data = buffer;
+  memcpy(data, payload, size);
+  payloadSize = size;
+}
+
 void Message::Release()
 {
   bool skip;
@@ -33,14 +57,7 @@ void Message::Release()
   if (skip)
     return;
 
-  // free data buffer
-  if (data != buffer)
-    delete [] data;
-
-  // delete event in case of sync message
-  if (event)
-    delete event;
-
+  // the payload buffer and the event of sync messages are kept for reuse
   origin->ReturnMessage(this);
 }
 
@@ -63,13 +80,7 @@ bool Message::Reply(int sig, void *data /* = NULL*/, int size /* = 0 */)
     msg->isOut = !isOut;
     replyMessage = msg;
     if (data)
-    {
-      if (size > MSG_INTERNAL_BUFFER_SIZE)
-        msg->data = new uint8_t[size];
-      else
-        msg->data = msg->buffer;
-      memcpy(msg->data, data, size);
-    }
+      msg->SetPayload(data, size);
   }
 
   origin->Unlock();
@@ -80,16 +91,48 @@ bool Message::Reply(int sig, void *data /* = NULL*/, int size /* = 0 */)
   return true;
 }
 
+void Protocol::MessageQueue::Push(Message *msg)
+{
+  msg->next = NULL;
+  if (m_tail)
+    m_tail->next = msg;
+  else
+    m_head = msg;
+  m_tail = msg;
+}
+
+Message *Protocol::MessageQueue::Pop()
+{
+  Message *msg = m_head;
+  if (msg)
+  {
+    m_head = msg->next;
+    if (!m_head)
+      m_tail = NULL;
+    msg->next = NULL;
+  }
+  return msg;
+}
+
+void Protocol::MessageQueue::Remove(int signal, MessageQueue &removed)
+{
+  MessageQueue kept;
+  while (Message *msg = Pop())
+  {
+    if (msg->signal == signal)
+      removed.Push(msg);
+    else
+      kept.Push(msg);
+  }
+  *this = kept;
+}
+
 Protocol::~Protocol()
 {
   Message *msg;
   Purge();
-  while (!freeMessageQueue.empty())
-  {
-    msg = freeMessageQueue.front();
-    freeMessageQueue.pop();
+  while ((msg = freeMessageQueue.Pop()))
     delete msg;
-  }
 }
 
 Message *Protocol::GetMessage()
@@ -98,18 +141,13 @@ Message *Protocol::GetMessage()
 
   CSingleLock lock(criticalSection);
 
-  if (!freeMessageQueue.empty())
-  {
-    msg = freeMessageQueue.front();
-    freeMessageQueue.pop();
-  }
-  else
+  msg = freeMessageQueue.Pop();
+  if (!msg)
     msg = new Message();
 
   msg->isSync = false;
   msg->isSyncFini = false;
   msg->isSyncTimeout = false;
-  msg->event = NULL;
   msg->data = NULL;
   msg->payloadSize = 0;
   msg->replyMessage = NULL;
@@ -122,7 +160,7 @@ void Protocol::ReturnMessage(Message *msg)
 {
   CSingleLock lock(criticalSection);
 
-  freeMessageQueue.push(msg);
+  freeMessageQueue.Push(msg);
 }
 
 bool Protocol::SendOutMessage(int signal, void *data /* = NULL */, int size /* = 0 */, Message *outMsg /* = NULL */)
@@ -137,16 +175,10 @@ bool Protocol::SendOutMessage(int signal, void *data /* = NULL */, int size /* =
   msg->isOut = true;
 
   if (data)
-  {
-    if (size > MSG_INTERNAL_BUFFER_SIZE)
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
+    msg->SetPayload(data, size);
 
   { CSingleLock lock(criticalSection);
-    outMessages.push(msg);
+    outMessages.Push(msg);
   }
   if (containerOutEvent)
     containerOutEvent->Set();
@@ -166,16 +198,10 @@ bool Protocol::SendInMessage(int signal, void *data /* = NULL */, int size /* =
   msg->isOut = false;
 
   if (data)
-  {
-    if (size > MSG_INTERNAL_BUFFER_SIZE)
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
+    msg->SetPayload(data, size);
 
   { CSingleLock lock(criticalSection);
-    inMessages.push(msg);
+    inMessages.Push(msg);
   }
   if (containerInEvent)
     containerInEvent->Set();
@@ -189,7 +215,8 @@ bool Protocol::SendOutMessageSync(int signal, Message **retMsg, int timeout, voi
   Message *msg = GetMessage();
   msg->isOut = true;
   msg->isSync = true;
-  msg->event = new CEvent;
+  if (!msg->event)
+    msg->event = new CEvent;
   msg->event->Reset();
   SendOutMessage(signal, data, size, msg);
 
@@ -220,11 +247,10 @@ bool Protocol::ReceiveOutMessage(Message **msg)
 {
   CSingleLock lock(criticalSection);
 
-  if (outMessages.empty() || outDefered)
+  if (outMessages.Empty() || outDefered)
     return false;
 
-  *msg = outMessages.front();
-  outMessages.pop();
+  *msg = outMessages.Pop();
 
   return true;
 }
@@ -233,11 +259,10 @@ bool Protocol::ReceiveInMessage(Message **msg)
 {
   CSingleLock lock(criticalSection);
 
-  if (inMessages.empty() || inDefered)
+  if (inMessages.Empty() || inDefered)
     return false;
 
-  *msg = inMessages.front();
-  inMessages.pop();
+  *msg = inMessages.Pop();
 
   return true;
 }
@@ -257,43 +282,23 @@ void Protocol::Purge()
 void Protocol::PurgeIn(int signal)
 {
   Message *msg;
-  std::queue<Message*> msgs;
+  MessageQueue msgs;
 
   CSingleLock lock(criticalSection);
 
-  while (!inMessages.empty())
-  {
-    msg = inMessages.front();
-    inMessages.pop();
-    if (msg->signal != signal)
-      msgs.push(msg);
-  }
-  while (!msgs.empty())
-  {
-    msg = msgs.front();
-    msgs.pop();
-    inMessages.push(msg);
-  }
+  inMessages.Remove(signal, msgs);
+  while ((msg = msgs.Pop()))
+    msg->Release();
 }
 
 void Protocol::PurgeOut(int signal)
 {
   Message *msg;
-  std::queue<Message*> msgs;
+  MessageQueue msgs;
 
   CSingleLock lock(criticalSection);
 
-  while (!outMessages.empty())
-  {
-    msg = outMessages.front();
-    outMessages.pop();
-    if (msg->signal != signal)
-      msgs.push(msg);
-  }
-  while (!msgs.empty())
-  {
-    msg = msgs.front();
-    msgs.pop();
-    outMessages.push(msg);
-  }
+  outMessages.Remove(signal, msgs);
+  while ((msg = msgs.Pop()))
+    msg->Release();
 }
@@ -21,7 +21,6 @@
 #pragma once
 
 #include "threads/Thread.h"
-#include <queue>
 #include "memory.h"
 
 #define MSG_INTERNAL_BUFFER_SIZE 32
@@ -51,7 +50,13 @@ public:
   bool Reply(int sig, void *data = NULL, int size = 0);
 
 private:
-  Message() {isSync = false; data = NULL; event = NULL; replyMessage = NULL;};
+  Message() : isSync(false), data(NULL), replyMessage(NULL), event(NULL), next(NULL), heapBuffer(NULL), heapBufferSize(0) {};
+  ~Message();
+  void SetPayload(const void *payload, int size);
+
+  Message *next;       ///< next message in a queue or in the free list
+  uint8_t *heapBuffer; ///< kept for payloads larger than buffer, reused with the message
+  int heapBufferSize;
 };
 
 class Protocol
@@ -79,11 +84,27 @@ public:
   std::string portName;
 
 protected:
+  /*!
+   \brief Queue of messages linked through the messages themselves, so queueing never allocates
+   */
+  class MessageQueue
+  {
+  public:
+    MessageQueue() : m_head(NULL), m_tail(NULL) {};
+    bool Empty() const { return m_head == NULL; };
+    void Push(Message *msg);
+    Message *Pop();
+    void Remove(int signal, MessageQueue &removed);
+  private:
+    Message *m_head;
+    Message *m_tail;
+  };
+
   CEvent *containerInEvent, *containerOutEvent;
   CCriticalSection criticalSection;
-  std::queue<Message*> outMessages;
-  std::queue<Message*> inMessages;
-  std::queue<Message*> freeMessageQueue;
+  MessageQueue outMessages;
+  MessageQueue inMessages;
+  MessageQueue freeMessageQueue;
   bool inDefered, outDefered;
 };
 
@@ -0,0 +1,216 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "InitGraph.h"
+
+#include <utility>
+
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+namespace
+{
+class CInitStepJob : public CJob
+{
+public:
+  explicit CInitStepJob(std::function<void()> run) : m_run(std::move(run)) {}
+
+  bool DoWork() override
+  {
+    m_run();
+    return true;
+  }
+
+  const char* GetType() const override { return "initstep"; }
+
+private:
+  std::function<void()> m_run;
+};
+}
+
+namespace KODI
+{
+namespace UTILS
+{
+CInitGraph::CInitGraph(std::string name)
+  : m_name(std::move(name))
+{
+}
+
+void CInitGraph::Add(std::string name, std::function<bool()> init, std::vector<std::string> dependencies)
+{
+  Step step;
+  step.name = std::move(name);
+  step.init = std::move(init);
+  step.state = State::WAITING;
+  step.duration = 0;
+  m_steps.push_back(std::move(step));
+  m_dependencyNames.push_back(std::move(dependencies));
+}
+
+bool CInitGraph::Resolve()
+{
+  for (size_t i = 0; i < m_steps.size(); i++)
+  {
+    for (const auto &dependency : m_dependencyNames[i])
+    {
+      size_t index = 0;
+      while (index < m_steps.size() && m_steps[index].name != dependency)
+        index++;
+
+      if (index == m_steps.size())
+      {
+        CLog::Log(LOGERROR, "CInitGraph: %s/%s depends on unknown step %s", m_name.c_str(), m_steps[i].name.c_str(), dependency.c_str());
+        return false;
+      }
+      m_steps[i].dependencies.push_back(index);
+    }
+  }
+  return true;
+}
+
+bool CInitGraph::Run()
+{
+  if (!Resolve())
+    return false;
+
+  const unsigned int start = XbmcThreads::SystemClockMillis();
+  CSingleLock lock(m_section);
+  while (true)
+  {
+    std::vector<size_t> ready;
+    bool running = false;
+    for (auto &step : m_steps)
+    {
+      if (step.state == State::RUNNING)
+        running = true;
+    }
+
+    // failures cascade to the steps depending on them, each pass resolves one level
+    bool skipped = true;
+    while (skipped)
+    {
+      skipped = false;
+      for (auto &step : m_steps)
+      {
+        if (step.state != State::WAITING)
+          continue;
+        for (size_t dependency : step.dependencies)
+        {
+          if (m_steps[dependency].state == State::FAILED)
+          {
+            CLog::Log(LOGERROR, "CInitGraph: %s/%s skipped, %s failed", m_name.c_str(), step.name.c_str(), m_steps[dependency].name.c_str());
+            step.state = State::FAILED;
+            skipped = true;
+            break;
+          }
+        }
+      }
+    }
+
+    for (size_t i = 0; i < m_steps.size(); i++)
+    {
+      if (m_steps[i].state != State::WAITING)
+        continue;
+      bool satisfied = true;
+      for (size_t dependency : m_steps[i].dependencies)
+        satisfied &= m_steps[dependency].state == State::DONE;
+      if (satisfied)
+        ready.push_back(i);
+    }
+
+    if (ready.empty())
+    {
+      if (!running)
+        break;
+
+      CSingleExit exit(m_section);
+      m_stepDone.Wait();
+      continue;
+    }
+
+    for (size_t i : ready)
+      m_steps[i].state = State::RUNNING;
+
+    // a lone step runs on the calling thread, nothing else could start meanwhile
+    std::vector<size_t> inlineSteps;
+    if (ready.size() == 1 && !running)
+      inlineSteps.push_back(ready.front());
+    else
+    {
+      for (size_t i : ready)
+      {
+        CJob *job = new CInitStepJob([this, i]() { RunStep(i); });
+        if (CJobManager::GetInstance().AddJob(job, nullptr, CJob::PRIORITY_DEDICATED) == 0)
+        {
+          // job manager isn't accepting jobs, run it ourselves
+          delete job;
+          inlineSteps.push_back(i);
+        }
+      }
+    }
+
+    CSingleExit exit(m_section);
+    for (size_t i : inlineSteps)
+      RunStep(i);
+  }
+
+  bool success = true;
+  unsigned int total = 0;
+  for (const auto &step : m_steps)
+  {
+    if (step.state == State::WAITING)
+      CLog::Log(LOGERROR, "CInitGraph: %s/%s never ran, its dependencies form a cycle", m_name.c_str(), step.name.c_str());
+    success &= step.state == State::DONE;
+    total += step.duration;
+  }
+
+  CLog::Log(LOGNOTICE, "CInitGraph: %s %s after %u ms, its steps took %u ms in total", m_name.c_str(),
+            success ? "finished" : "failed", XbmcThreads::SystemClockMillis() - start, total);
+  return success;
+}
+
+void CInitGraph::RunStep(size_t index)
+{
+  Step &step = m_steps[index];
+  const unsigned int start = XbmcThreads::SystemClockMillis();
+  bool success = false;
+  try
+  {
+    success = step.init();
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - exception in step %s/%s", __FUNCTION__, m_name.c_str(), step.name.c_str());
+  }
+  const unsigned int duration = XbmcThreads::SystemClockMillis() - start;
+
+  CLog::Log(success ? LOGNOTICE : LOGERROR, "CInitGraph: %s/%s %s after %u ms", m_name.c_str(), step.name.c_str(),
+            success ? "finished" : "failed", duration);
+
+  CSingleLock lock(m_section);
+  step.state = success ? State::DONE : State::FAILED;
+  step.duration = duration;
+  m_stepDone.Set();
+}
+}
+}
@@ -0,0 +1,93 @@
+#pragma once
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+namespace KODI
+{
+namespace UTILS
+{
+/*!
+ \brief Runs initialization steps in dependency order, independent steps in parallel.
+
+ Every step names the steps it depends on and runs once all of them
+ succeeded, on a dedicated CJobManager worker or on the calling thread if it
+ is the only one that can run. A step that fails, or depends on a failed
+ step, makes Run() fail; steps depending on it are skipped. The duration of
+ every step is logged, so slow startup can be traced to a service.
+ */
+class CInitGraph
+{
+public:
+  explicit CInitGraph(std::string name);
+
+  /*!
+   \brief Add a step, all steps must be added before Run().
+   \param name unique name of the step, used for the dependencies and the log
+   \param init initialization of the step, returns false on failure. Must not
+   touch state of steps it doesn't depend on.
+   \param dependencies names of the steps that must succeed before this one runs
+   */
+  void Add(std::string name, std::function<bool()> init, std::vector<std::string> dependencies = std::vector<std::string>());
+
+  /*!
+   \brief Run all steps and wait for them, can only be called once.
+   \return false if a step failed or could not run
+   */
+  bool Run();
+
+private:
+  CInitGraph(const CInitGraph&) = delete;
+  CInitGraph& operator=(const CInitGraph&) = delete;
+
+  enum class State
+  {
+    WAITING,
+    RUNNING,
+    DONE,
+    FAILED
+  };
+
+  struct Step
+  {
+    std::string name;
+    std::function<bool()> init;
+    std::vector<size_t> dependencies;
+    State state;
+    unsigned int duration; ///< in ms
+  };
+
+  bool Resolve();
+  void RunStep(size_t index);
+
+  std::string m_name;
+  std::vector<Step> m_steps;
+  std::vector<std::vector<std::string>> m_dependencyNames; ///< resolved to indices by Run()
+  CCriticalSection m_section;
+  CEvent m_stepDone;
+};
+}
+}
@@ -132,7 +132,7 @@ bool CJSONVariantParserHandler::StartObject()
 
 bool CJSONVariantParserHandler::Key(const char* str, rapidjson::SizeType length, bool copy)
 {
-  m_key = std::string(str, 0, length);
+  m_key.assign(str, length);
 
   return true;
 }
@@ -160,23 +160,27 @@ bool CJSONVariantParserHandler::EndArray(rapidjson::SizeType elementCount)
 
 void CJSONVariantParserHandler::PushObject(CVariant variant)
 {
+  // the variant is moved into the tree below
+  const CVariant::VariantType type = variant.type();
+
   if (m_status == PARSE_STATUS::Object)
   {
-    (*m_parse[m_parse.size() - 1])[m_key] = variant;
-    m_parse.push_back(&(*m_parse[m_parse.size() - 1])[m_key]);
+    CVariant &member = (*m_parse[m_parse.size() - 1])[m_key];
+    member = std::move(variant);
+    m_parse.push_back(&member);
   }
   else if (m_status == PARSE_STATUS::Array)
   {
     CVariant *temp = m_parse[m_parse.size() - 1];
-    temp->push_back(variant);
+    temp->push_back(std::move(variant));
     m_parse.push_back(&(*temp)[temp->size() - 1]);
   }
   else if (m_parse.empty())
-    m_parse.push_back(new CVariant(variant));
+    m_parse.push_back(new CVariant(std::move(variant)));
 
-  if (variant.isObject())
+  if (type == CVariant::VariantTypeObject)
     m_status = PARSE_STATUS::Object;
-  else if (variant.isArray())
+  else if (type == CVariant::VariantTypeArray)
     m_status = PARSE_STATUS::Array;
   else
     m_status = PARSE_STATUS::Variable;
@@ -199,7 +203,7 @@ void CJSONVariantParserHandler::PopObject()
   }
   else
   {
-    m_parsedObject = *variant;
+    m_parsedObject = std::move(*variant);
     delete variant;
 
     m_status = PARSE_STATUS::Variable;
@@ -21,11 +21,28 @@
 #include "JSONVariantWriter.h"
 
 #include <rapidjson/prettywriter.h>
-#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
 #include "utils/Variant.h"
 
+/*!
+ \brief rapidjson output stream writing straight into a std::string, so large
+ responses aren't held twice by a rapidjson::StringBuffer and its copy.
+ */
+class CJSONStringOutputStream
+{
+public:
+  typedef char Ch;
+
+  explicit CJSONStringOutputStream(std::string &output) : m_output(output) { }
+
+  void Put(Ch c) { m_output.push_back(c); }
+  void Flush() { }
+
+private:
+  std::string &m_output;
+};
+
 template<class TWriter>
 bool InternalWrite(TWriter& writer, const CVariant &value)
 {
@@ -64,7 +81,7 @@ bool InternalWrite(TWriter& writer, const CVariant &value)
 
     for (CVariant::const_iterator_map itr = value.begin_map(); itr != value.end_map(); ++itr)
     {
-      if (!writer.Key(itr->first.c_str()) ||
+      if (!writer.Key(itr->first.c_str(), itr->first.size()) ||
         !InternalWrite(writer, itr->second))
         return false;
     }
@@ -82,23 +99,24 @@ bool InternalWrite(TWriter& writer, const CVariant &value)
 
 bool CJSONVariantWriter::Write(const CVariant &value, std::string& output, bool compact)
 {
-  rapidjson::StringBuffer stringBuffer;
+  std::string json;
+  CJSONStringOutputStream stream(json);
   if (compact)
   {
-    rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+    rapidjson::Writer<CJSONStringOutputStream> writer(stream);
 
     if (!InternalWrite(writer, value) || !writer.IsComplete())
       return false;
   }
   else
   {
-    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(stringBuffer);
+    rapidjson::PrettyWriter<CJSONStringOutputStream> writer(stream);
     writer.SetIndent('\t', 1);
 
     if (!InternalWrite(writer, value) || !writer.IsComplete())
       return false;
   }
 
-  output = stringBuffer.GetString();
+  output.swap(json);
   return true;
 }
@@ -53,6 +53,12 @@ CJobWorker::~CJobWorker()
     StopThread();
 }
 
+void CJobWorker::EnterBackground()
+{
+  SetRole(XbmcThreads::ThreadRole::BACKGROUND_CPU);
+  m_background = true;
+}
+
 void CJobWorker::Process()
 {
   SetPriority( GetMinPriority() );
@@ -184,6 +190,7 @@ CJobManager::CJobManager()
   m_jobCounter = 0;
   m_running = true;
   m_pauseJobs = false;
+  m_backgroundWorkers = 0;
 }
 
 void CJobManager::Restart()
@@ -215,6 +222,7 @@ void CJobManager::CancelJobs()
   {
     lock.Leave();
     m_jobEvent.Set();
+    m_backgroundEvent.Set();
     Sleep(0); // yield after setting the event to give the workers some time to die
     lock.Enter();
   }
@@ -271,8 +279,16 @@ void CJobManager::StartWorkers(CJob::PRIORITY priority)
   if (m_processing.size() >= GetMaxWorkers(priority))
     return;
 
-  // do we have any sleeping threads?
-  if (m_processing.size() < m_workers.size())
+  // do we have any sleeping threads? queued dedicated jobs need one each,
+  // a worker that is still starting up counts as sleeping. Low priority jobs
+  // run on background workers, a regular worker becomes one when it takes one
+  const size_t needed = priority == CJob::PRIORITY_DEDICATED ? m_jobQueue[priority].size() : 1;
+  if (priority <= CJob::PRIORITY_LOW && GetSleepingWorkers(true) >= needed)
+  {
+    m_backgroundEvent.Set();
+    return;
+  }
+  if (GetSleepingWorkers(false) >= needed)
   {
     m_jobEvent.Set();
     return;
@@ -282,28 +298,61 @@ void CJobManager::StartWorkers(CJob::PRIORITY priority)
   m_workers.push_back(new CJobWorker(this));
 }
 
-CJob *CJobManager::PopJob()
+int CJobManager::GetNextPriority(bool background) const
 {
   CSingleLock lock(m_section);
-  for (int priority = CJob::PRIORITY_DEDICATED; priority >= CJob::PRIORITY_LOW_PAUSABLE; --priority)
+  const int highest = background ? CJob::PRIORITY_LOW : CJob::PRIORITY_DEDICATED;
+  for (int priority = highest; priority >= CJob::PRIORITY_LOW_PAUSABLE; --priority)
   {
     // Check whether we're pausing pausable jobs
     if (priority == CJob::PRIORITY_LOW_PAUSABLE && m_pauseJobs)
       continue;
 
     if (m_jobQueue[priority].size() && m_processing.size() < GetMaxWorkers(CJob::PRIORITY(priority)))
-    {
-      // pop the job off the queue
-      CWorkItem job = m_jobQueue[priority].front();
-      m_jobQueue[priority].pop_front();
-
-      // add to the processing vector
-      m_processing.push_back(job);
-      job.m_job->m_callback = this;
-      return job.m_job;
-    }
+      return priority;
   }
-  return NULL;
+  return -1;
+}
+
+size_t CJobManager::GetSleepingWorkers(bool background) const
+{
+  CSingleLock lock(m_section);
+  const size_t low = std::count_if(m_processing.begin(), m_processing.end(),
+                                   [](const CWorkItem &item) { return item.m_priority <= CJob::PRIORITY_LOW; });
+  const size_t workers = background ? m_backgroundWorkers : m_workers.size() - m_backgroundWorkers;
+  const size_t processing = background ? low : m_processing.size() - low;
+  return workers > processing ? workers - processing : 0;
+}
+
+CJob *CJobManager::PopJob(CJobWorker *worker)
+{
+  CSingleLock lock(m_section);
+  const int priority = GetNextPriority(worker->IsBackground());
+  if (priority < 0)
+    return NULL;
+
+  // scans and other low priority jobs must not take the cores from playback,
+  // the GUI and the startup wait on the others
+  if (priority <= CJob::PRIORITY_LOW && !worker->IsBackground())
+  {
+    worker->EnterBackground();
+    m_backgroundWorkers++;
+  }
+
+  // pop the job off the queue
+  CWorkItem job = m_jobQueue[priority].front();
+  m_jobQueue[priority].pop_front();
+
+  int64_t wait = CurrentHostCounter() - job.m_queuedTime;
+  WaitStats &stats = m_waitStats[priority];
+  stats.started++;
+  stats.totalWait += wait;
+  stats.maxWait = std::max(stats.maxWait, wait);
+
+  // add to the processing vector
+  m_processing.push_back(job);
+  job.m_job->m_callback = this;
+  return job.m_job;
 }
 
 void CJobManager::PauseJobs()
@@ -333,6 +382,29 @@ bool CJobManager::IsProcessing(const CJob::PRIORITY &priority) const
   return false;
 }
 
+CJobManager::QueueStats CJobManager::GetQueueStats(CJob::PRIORITY priority) const
+{
+  CSingleLock lock(m_section);
+
+  QueueStats stats;
+  stats.queued = m_jobQueue[priority].size();
+  stats.processing = std::count_if(m_processing.begin(), m_processing.end(),
+                                   [priority](const CWorkItem &item) { return item.m_priority == priority; });
+
+  const WaitStats &waitStats = m_waitStats[priority];
+  const double scale = 1000.0 / CurrentHostFrequency();
+  stats.started = waitStats.started;
+  stats.totalWaitMs = waitStats.totalWait * scale;
+  stats.maxWaitMs = waitStats.maxWait * scale;
+  return stats;
+}
+
+unsigned int CJobManager::GetWorkerCount() const
+{
+  CSingleLock lock(m_section);
+  return m_workers.size();
+}
+
 int CJobManager::IsProcessing(const std::string &type) const
 {
   int jobsMatched = 0;
@@ -349,25 +421,27 @@ int CJobManager::IsProcessing(const std::string &type) const
   return jobsMatched;
 }
 
-CJob *CJobManager::GetNextJob(const CJobWorker *worker)
+CJob *CJobManager::GetNextJob(CJobWorker *worker)
 {
   CSingleLock lock(m_section);
   while (m_running)
   {
     // grab a job off the queue if we have one
-    CJob *job = PopJob();
+    CJob *job = PopJob(worker);
     if (job)
       return job;
     // no jobs are left - sleep for 30 seconds to allow new jobs to come in
     lock.Leave();
-    bool newJob = m_jobEvent.WaitMSec(30000);
+    bool newJob = (worker->IsBackground() ? m_backgroundEvent : m_jobEvent).WaitMSec(30000);
     lock.Enter();
-    if (!newJob)
+    // keep enough workers waiting for the regular priorities rather than recreating them,
+    // the extra ones started for dedicated jobs and the background ones stop once idle
+    if (!newJob && (worker->IsBackground() || m_workers.size() > GetMaxWorkers(CJob::PRIORITY_HIGH)))
       break;
   }
   // ensure no jobs have come in during the period after
   // timeout and before we held the lock
-  CJob *job = PopJob();
+  CJob *job = PopJob(worker);
   if (job)
     return job;
   // have no jobs
@@ -416,6 +490,10 @@ void CJobManager::OnJobComplete(bool success, CJob *job)
     Processing::iterator j = find(m_processing.begin(), m_processing.end(), job);
     if (j != m_processing.end())
       m_processing.erase(j);
+    // the background worker can't take a job of a higher priority that waited for the slot
+    const int priority = GetNextPriority(false);
+    if (item.m_priority <= CJob::PRIORITY_LOW && priority > CJob::PRIORITY_LOW)
+      StartWorkers(CJob::PRIORITY(priority));
     lock.Leave();
     item.FreeJob();
   }
@@ -427,7 +505,11 @@ void CJobManager::RemoveWorker(const CJobWorker *worker)
   // remove our worker
   Workers::iterator i = find(m_workers.begin(), m_workers.end(), worker);
   if (i != m_workers.end())
+  {
+    if (worker->IsBackground())
+      m_backgroundWorkers--;
     m_workers.erase(i); // workers auto-delete
+  }
 }
 
 unsigned int CJobManager::GetMaxWorkers(CJob::PRIORITY priority)
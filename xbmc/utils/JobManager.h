@@ -24,6 +24,7 @@
 #include <string>
 #include "threads/CriticalSection.h"
 #include "threads/Thread.h"
+#include "utils/TimeUtils.h"
 #include "Job.h"
 
 class CJobManager;
@@ -35,8 +36,17 @@ public:
   ~CJobWorker() override;
 
   void Process() override;
+
+  /*!
+   \brief Put the worker in the background thread role, from then on it only runs low
+   priority jobs as the role can't be left without privileges. Only to be called by
+   the worker itself.
+   */
+  void EnterBackground();
+  bool IsBackground() const { return m_background; }
 private:
   CJobManager  *m_jobManager;
+  bool          m_background = false;
 };
 
 /*!
@@ -183,6 +193,7 @@ class CJobManager
       m_id = id;
       m_callback = callback;
       m_priority = priority;
+      m_queuedTime = CurrentHostCounter();
     }
     bool operator==(unsigned int jobID) const
     {
@@ -205,6 +216,7 @@ class CJobManager
     unsigned int  m_id;
     IJobCallback *m_callback;
     CJob::PRIORITY m_priority;
+    int64_t       m_queuedTime;
   };
 
   template<typename F>
@@ -222,6 +234,18 @@ class CJobManager
   };
 
 public:
+  /*!
+   \brief Load of the queue of one priority, used to diagnose slow background work.
+   */
+  struct QueueStats
+  {
+    unsigned int queued = 0;      ///< jobs waiting to be processed
+    unsigned int processing = 0;  ///< jobs being processed
+    uint64_t started = 0;         ///< jobs taken off the queue since startup
+    double totalWaitMs = 0.0;     ///< time the started jobs spent in the queue
+    double maxWaitMs = 0.0;       ///< longest time a job spent in the queue
+  };
+
   /*!
    \brief The only way through which the global instance of the CJobManager should be accessed.
    \return the global instance.
@@ -306,6 +330,18 @@ public:
    */
   bool IsProcessing(const CJob::PRIORITY &priority) const;
 
+  /*!
+   \brief Get the queue depth and wait times of the jobs with the given priority
+   \param priority the priority to get the statistics of
+   \return the statistics of the queue
+   */
+  QueueStats GetQueueStats(CJob::PRIORITY priority) const;
+
+  /*!
+   \brief Get the number of worker threads, busy or waiting for jobs
+   */
+  unsigned int GetWorkerCount() const;
+
 protected:
   friend class CJobWorker;
   friend class CJob;
@@ -315,7 +351,7 @@ protected:
    \param worker a pointer to the current CJobWorker instance requesting a job.
    \sa CJob
    */
-  CJob *GetNextJob(const CJobWorker *worker);
+  CJob *GetNextJob(CJobWorker *worker);
 
   /*!
    \brief Callback from CJobWorker after a job has completed.
@@ -345,9 +381,20 @@ private:
   virtual ~CJobManager();
 
   /*! \brief Pop a job off the job queue and add to the processing queue ready to process
+   \param worker the worker to process the job, takes the background role for a low priority job
    \return the job to process, NULL if no jobs are available
    */
-  CJob *PopJob();
+  CJob *PopJob(CJobWorker *worker);
+
+  /*! \brief The priority of the job PopJob() returns next
+   \param background only look at the low priority jobs background workers run
+   \return the priority, -1 if no jobs are available
+   */
+  int GetNextPriority(bool background) const;
+
+  /*! \brief Number of idle background or regular workers
+   */
+  size_t GetSleepingWorkers(bool background) const;
 
   void StartWorkers(CJob::PRIORITY priority);
   void RemoveWorker(const CJobWorker *worker);
@@ -360,11 +407,20 @@ private:
   typedef std::vector<CJobWorker*> Workers;
 
   JobQueue   m_jobQueue[CJob::PRIORITY_DEDICATED + 1];
+  struct WaitStats
+  {
+    uint64_t started = 0;
+    int64_t totalWait = 0;
+    int64_t maxWait = 0;
+  };
+  WaitStats  m_waitStats[CJob::PRIORITY_DEDICATED + 1];
   bool       m_pauseJobs;
   Processing m_processing;
   Workers    m_workers;
+  unsigned int m_backgroundWorkers;
 
   CCriticalSection m_section;
   CEvent           m_jobEvent;
+  CEvent           m_backgroundEvent; ///< wakes the background workers
   bool             m_running;
 };
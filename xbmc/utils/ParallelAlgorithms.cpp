@@ -0,0 +1,167 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ParallelAlgorithms.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+
+namespace
+{
+// upper bound of helpers, CJobManager won't run more high priority jobs anyway
+const size_t MAX_PARALLELISM = 8;
+
+class CParallelForState
+{
+public:
+  CParallelForState(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body)
+    : m_count(count),
+      m_grainSize(grainSize),
+      m_chunks((count + grainSize - 1) / grainSize),
+      m_body(body),
+      m_next(0),
+      m_completed(0),
+      m_done(true)
+  {
+  }
+
+  /*!
+   \brief Process chunks until none are left to claim.
+   The body is only touched after a chunk has been claimed, so helpers that
+   start after the caller has finished never access it.
+   */
+  void Run()
+  {
+    size_t chunk;
+    while ((chunk = m_next++) < m_chunks)
+    {
+      const size_t begin = chunk * m_grainSize;
+      try
+      {
+        m_body(begin, std::min(begin + m_grainSize, m_count));
+      }
+      catch (...)
+      {
+        // keep the first exception for the calling thread, see Wait()
+        CSingleLock lock(m_section);
+        if (!m_exception)
+          m_exception = std::current_exception();
+      }
+      if (++m_completed == m_chunks)
+        m_done.Set();
+    }
+  }
+
+  /*!
+   \brief Wait for all chunks, rethrows the first exception thrown by the body.
+   */
+  void Wait()
+  {
+    if (m_completed < m_chunks)
+      m_done.Wait();
+
+    CSingleLock lock(m_section);
+    if (m_exception)
+      std::rethrow_exception(m_exception);
+  }
+
+private:
+  const size_t m_count;
+  const size_t m_grainSize;
+  const size_t m_chunks;
+  const std::function<void(size_t, size_t)>& m_body;
+  std::atomic<size_t> m_next;
+  std::atomic<size_t> m_completed;
+  CEvent m_done;
+  CCriticalSection m_section;
+  std::exception_ptr m_exception;
+};
+
+class CParallelForJob : public CJob
+{
+public:
+  explicit CParallelForJob(std::shared_ptr<CParallelForState> state) : m_state(std::move(state)) {}
+
+  bool DoWork() override
+  {
+    m_state->Run();
+    return true;
+  }
+
+  const char* GetType() const override { return "parallelfor"; }
+
+private:
+  std::shared_ptr<CParallelForState> m_state;
+};
+}
+
+namespace KODI
+{
+namespace UTILS
+{
+size_t GetParallelism()
+{
+  const int cpus = g_cpuInfo.getCPUCount();
+  if (cpus <= 1)
+    return 1;
+  return std::min(static_cast<size_t>(cpus), MAX_PARALLELISM);
+}
+
+void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body,
+                 size_t threshold /* = PARALLEL_THRESHOLD */)
+{
+  if (count == 0)
+    return;
+
+  if (grainSize == 0)
+    grainSize = 1;
+
+  const size_t chunks = (count + grainSize - 1) / grainSize;
+  const size_t helpers = std::min(chunks, GetParallelism()) - 1;
+  if (helpers == 0 || count < threshold)
+  {
+    body(0, count);
+    return;
+  }
+
+  auto state = std::make_shared<CParallelForState>(count, grainSize, body);
+  for (size_t i = 0; i < helpers; i++)
+  {
+    CJob* job = new CParallelForJob(state);
+    if (CJobManager::GetInstance().AddJob(job, nullptr, CJob::PRIORITY_HIGH) == 0)
+    {
+      // job manager isn't accepting jobs, the calling thread does all the work
+      delete job;
+      break;
+    }
+  }
+
+  state->Run();
+  state->Wait();
+}
+}
+}
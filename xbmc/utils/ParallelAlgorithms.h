@@ -0,0 +1,152 @@
+#pragma once
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stddef.h>
+#include <vector>
+
+namespace KODI
+{
+namespace UTILS
+{
+/*!
+ \brief Default number of elements below which the parallel algorithms fall
+ back to their sequential counterparts. Spawning work on the job manager is
+ not free, so small lists are always handled on the calling thread.
+ */
+const size_t PARALLEL_THRESHOLD = 2048;
+
+/*!
+ \brief Number of chunks the parallel algorithms split their work into.
+ Depends on the number of available cores only, so the way a range is split
+ (and therefore the result of the algorithms below) never depends on timing.
+ */
+size_t GetParallelism();
+
+/*!
+ \brief Run body over [0, count) split into chunks of at most grainSize elements.
+
+ Chunks are handed out to helper jobs on the shared CJobManager pool. The
+ calling thread processes chunks as well, so the call never waits on a job
+ that has not started yet and is safe to use from within a job. Returns once
+ every chunk has been processed. If the body throws, the first exception is
+ rethrown on the calling thread after all chunks are done.
+
+ \param count number of elements to process
+ \param grainSize maximum number of elements per chunk
+ \param body function called with the [begin, end) range of each chunk. Must
+ be safe to call concurrently for disjoint ranges.
+ \param threshold ranges smaller than this are processed sequentially on the
+ calling thread, without posting any jobs
+ */
+void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body,
+                 size_t threshold = PARALLEL_THRESHOLD);
+
+/*!
+ \brief Stable sort of [first, last) using a parallel merge sort.
+
+ The range is split into a fixed, power of two number of runs that are sorted
+ with std::stable_sort concurrently and merged pairwise (left run first), so
+ the resulting order is identical to a sequential std::stable_sort.
+
+ \param comp comparator, must be safe to call concurrently
+ \param threshold ranges smaller than this are sorted sequentially
+ */
+template<class TIterator, class TCompare>
+void ParallelStableSort(TIterator first, TIterator last, TCompare comp, size_t threshold = PARALLEL_THRESHOLD)
+{
+  const size_t count = std::distance(first, last);
+  size_t runs = 1;
+  while (runs * 2 <= GetParallelism() && count / (runs * 2) >= threshold / 2)
+    runs *= 2;
+
+  if (count < threshold || runs < 2)
+  {
+    std::stable_sort(first, last, comp);
+    return;
+  }
+
+  std::vector<size_t> bounds(runs + 1);
+  for (size_t i = 0; i <= runs; i++)
+    bounds[i] = count * i / runs;
+
+  ParallelFor(runs, 1, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; i++)
+      std::stable_sort(first + bounds[i], first + bounds[i + 1], comp);
+  }, 0);
+
+  for (size_t width = 1; width < runs; width *= 2)
+  {
+    ParallelFor(runs / (2 * width), 1, [&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; i++)
+      {
+        const size_t left = 2 * width * i;
+        std::inplace_merge(first + bounds[left], first + bounds[left + width], first + bounds[left + 2 * width], comp);
+      }
+    }, 0);
+  }
+}
+
+/*!
+ \brief Remove all elements matching pred from items, keeping the order of the remaining ones.
+
+ The predicate is evaluated concurrently, the compaction of the vector is
+ done on the calling thread.
+
+ \param pred predicate, must be safe to call concurrently
+ \param threshold vectors smaller than this are filtered sequentially
+ \return the number of removed elements
+ */
+template<class T, class TPredicate>
+size_t ParallelRemoveIf(std::vector<T>& items, TPredicate pred, size_t threshold = PARALLEL_THRESHOLD)
+{
+  const size_t count = items.size();
+  if (count < threshold)
+  {
+    items.erase(std::remove_if(items.begin(), items.end(), pred), items.end());
+    return count - items.size();
+  }
+
+  std::vector<char> remove(count, 0);
+  ParallelFor(count, std::max<size_t>(threshold / 4, 1), [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; i++)
+      remove[i] = pred(items[i]) ? 1 : 0;
+  }, threshold);
+
+  size_t kept = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (remove[i])
+      continue;
+    if (kept != i)
+      items[kept] = std::move(items[i]);
+    kept++;
+  }
+  items.erase(items.begin() + kept, items.end());
+  return count - kept;
+}
+}
+}
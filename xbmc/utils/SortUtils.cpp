@@ -24,6 +24,7 @@
 #include "Util.h"
 #include "XBDateTime.h"
 #include "utils/CharsetConverter.h"
+#include "utils/ParallelAlgorithms.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -706,6 +707,34 @@ std::map<SortBy, Fields> fillSortingFields()
   return sortingFields;
 }
 
+// number of items each job prepares the sort label for at once
+static const size_t PREPARE_GRAIN_SIZE = 512;
+
+static void prepareItem(SortUtils::SortPreparator preparator, SortAttribute attributes, const Fields &sortingFields, SortItem &item)
+{
+  // add all fields to the item that are required for sorting if they are currently missing
+  for (Fields::const_iterator field = sortingFields.begin(); field != sortingFields.end(); ++field)
+  {
+    if (item.find(*field) == item.end())
+      item.insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
+  }
+
+  std::wstring sortLabel;
+#ifdef TARGET_ANDROID
+  // Android does not support locale; Translate to ASCII
+  std::string dest;
+  g_charsetConverter.utf8ToASCII(preparator(attributes, item), dest);
+  for (char c : dest)
+  {
+    if (::isalnum(c) || c == ' ')
+      sortLabel.push_back(c);
+  }
+#else
+  g_charsetConverter.utf8ToW(preparator(attributes, item), sortLabel, false);
+#endif
+  item.insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+}
+
 std::map<SortBy, SortUtils::SortPreparator> SortUtils::m_preparators = fillPreparators();
 std::map<SortBy, Fields> SortUtils::m_sortingFields = fillSortingFields();
 
@@ -720,33 +749,14 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
       Fields sortingFields = GetFieldsForSorting(sortBy);
 
       // Prepare the string used for sorting and store it under FieldSort
-      for (DatabaseResults::iterator item = items.begin(); item != items.end(); ++item)
+      KODI::UTILS::ParallelFor(items.size(), PREPARE_GRAIN_SIZE, [&](size_t begin, size_t end)
       {
-        // add all fields to the item that are required for sorting if they are currently missing
-        for (Fields::const_iterator field = sortingFields.begin(); field != sortingFields.end(); ++field)
-        {
-          if (item->find(*field) == item->end())
-            item->insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
-        }
-
-        std::wstring sortLabel;
-#ifdef TARGET_ANDROID
-        // Android does not support locale; Translate to ASCII
-        std::string dest;
-        g_charsetConverter.utf8ToASCII(preparator(attributes, *item), dest);
-        for (char c : dest)
-        {
-          if (::isalnum(c) || c == ' ')
-            sortLabel.push_back(c);
-        }
-#else
-        g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
-#endif
-        item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
-      }
+        for (size_t i = begin; i < end; i++)
+          prepareItem(preparator, attributes, sortingFields, items[i]);
+      });
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorter(sortOrder, attributes));
+      KODI::UTILS::ParallelStableSort(items.begin(), items.end(), getSorter(sortOrder, attributes));
     }
   }
 
@@ -770,33 +780,14 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
       Fields sortingFields = GetFieldsForSorting(sortBy);
 
       // Prepare the string used for sorting and store it under FieldSort
-      for (SortItems::iterator item = items.begin(); item != items.end(); ++item)
+      KODI::UTILS::ParallelFor(items.size(), PREPARE_GRAIN_SIZE, [&](size_t begin, size_t end)
       {
-        // add all fields to the item that are required for sorting if they are currently missing
-        for (Fields::const_iterator field = sortingFields.begin(); field != sortingFields.end(); ++field)
-        {
-          if ((*item)->find(*field) == (*item)->end())
-            (*item)->insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
-        }
-
-        std::wstring sortLabel;
-#ifdef TARGET_ANDROID
-        // Android does not support locale; Translate to ASCII
-        std::string dest;
-        g_charsetConverter.utf8ToASCII(preparator(attributes, **item), dest);
-        for (char c : dest)
-        {
-          if (::isalnum(c) || c == ' ')
-            sortLabel.push_back(c);
-        }
-#else
-        g_charsetConverter.utf8ToW(preparator(attributes, **item), sortLabel, false);
-#endif
-        (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
-      }
+        for (size_t i = begin; i < end; i++)
+          prepareItem(preparator, attributes, sortingFields, *items[i]);
+      });
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
+      KODI::UTILS::ParallelStableSort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
     }
   }
 
@@ -20,6 +20,7 @@
 
 #include "Variant.h"
 
+#include <new>
 #include <stdlib.h>
 #include <string.h>
 #include <sstream>
@@ -157,10 +158,10 @@ CVariant::CVariant(VariantType type)
       m_data.dvalue = 0.0;
       break;
     case VariantTypeString:
-      m_data.string = new std::string();
+      new (&m_data.string) std::string();
       break;
     case VariantTypeWideString:
-      m_data.wstring = new std::wstring();
+      new (&m_data.wstring) std::wstring();
       break;
     case VariantTypeArray:
       m_data.array = new VariantArray();
@@ -169,7 +170,7 @@ CVariant::CVariant(VariantType type)
       m_data.map = new VariantMap();
       break;
     default:
-      memset(&m_data, 0, sizeof(m_data));
+      m_data.integer = 0;
       break;
   }
 }
@@ -219,49 +220,49 @@ CVariant::CVariant(bool boolean)
 CVariant::CVariant(const char *str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  new (&m_data.string) std::string(str);
 }
 
 CVariant::CVariant(const char *str, unsigned int length)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str, length);
+  new (&m_data.string) std::string(str, length);
 }
 
 CVariant::CVariant(const std::string &str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  new (&m_data.string) std::string(str);
 }
 
 CVariant::CVariant(std::string &&str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(std::move(str));
+  new (&m_data.string) std::string(std::move(str));
 }
 
 CVariant::CVariant(const wchar_t *str)
 {
   m_type = VariantTypeWideString;
-  m_data.wstring = new std::wstring(str);
+  new (&m_data.wstring) std::wstring(str);
 }
 
 CVariant::CVariant(const wchar_t *str, unsigned int length)
 {
   m_type = VariantTypeWideString;
-  m_data.wstring = new std::wstring(str, length);
+  new (&m_data.wstring) std::wstring(str, length);
 }
 
 CVariant::CVariant(const std::wstring &str)
 {
   m_type = VariantTypeWideString;
-  m_data.wstring = new std::wstring(str);
+  new (&m_data.wstring) std::wstring(str);
 }
 
 CVariant::CVariant(std::wstring &&str)
 {
   m_type = VariantTypeWideString;
-  m_data.wstring = new std::wstring(std::move(str));
+  new (&m_data.wstring) std::wstring(std::move(str));
 }
 
 CVariant::CVariant(const std::vector<std::string> &strArray)
@@ -278,7 +279,7 @@ CVariant::CVariant(const std::map<std::string, std::string> &strMap)
   m_type = VariantTypeObject;
   m_data.map = new VariantMap;
   for (std::map<std::string, std::string>::const_iterator it = strMap.begin(); it != strMap.end(); ++it)
-    m_data.map->insert(make_pair(it->first, CVariant(it->second)));
+    m_data.map->emplace_hint(m_data.map->end(), it->first, CVariant(it->second));
 }
 
 CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
@@ -289,17 +290,12 @@ CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
 
 CVariant::CVariant(const CVariant &variant)
 {
-  m_type = VariantTypeNull;
-  *this = variant;
+  copyFrom(variant);
 }
 
 CVariant::CVariant(CVariant&& rhs)
 {
-  //Set this so that operator= don't try and run cleanup
-  //when we're not initialized.
-  m_type = VariantTypeNull;
-
-  *this = std::move(rhs);
+  moveFrom(rhs);
 }
 
 CVariant::~CVariant()
@@ -312,13 +308,11 @@ void CVariant::cleanup()
   switch (m_type)
   {
   case VariantTypeString:
-    delete m_data.string;
-    m_data.string = nullptr;
+    m_data.string.~basic_string();
     break;
 
   case VariantTypeWideString:
-    delete m_data.wstring;
-    m_data.wstring = nullptr;
+    m_data.wstring.~basic_string();
     break;
 
   case VariantTypeArray:
@@ -336,6 +330,85 @@ void CVariant::cleanup()
   m_type = VariantTypeNull;
 }
 
+void CVariant::moveFrom(CVariant &rhs)
+{
+  m_type = rhs.m_type;
+
+  switch (m_type)
+  {
+  case VariantTypeInteger:
+    m_data.integer = rhs.m_data.integer;
+    break;
+  case VariantTypeUnsignedInteger:
+    m_data.unsignedinteger = rhs.m_data.unsignedinteger;
+    break;
+  case VariantTypeBoolean:
+    m_data.boolean = rhs.m_data.boolean;
+    break;
+  case VariantTypeDouble:
+    m_data.dvalue = rhs.m_data.dvalue;
+    break;
+  case VariantTypeString:
+    new (&m_data.string) std::string(std::move(rhs.m_data.string));
+    break;
+  case VariantTypeWideString:
+    new (&m_data.wstring) std::wstring(std::move(rhs.m_data.wstring));
+    break;
+  case VariantTypeArray:
+    m_data.array = rhs.m_data.array;
+    rhs.m_data.array = nullptr;
+    break;
+  case VariantTypeObject:
+    m_data.map = rhs.m_data.map;
+    rhs.m_data.map = nullptr;
+    break;
+  case VariantTypeConstNull:
+    // never turn ConstNullVariant into an assignable null
+    return;
+  default:
+    m_data.integer = 0;
+    break;
+  }
+
+  rhs.cleanup();
+}
+
+void CVariant::copyFrom(const CVariant &rhs)
+{
+  m_type = rhs.m_type;
+
+  switch (m_type)
+  {
+  case VariantTypeInteger:
+    m_data.integer = rhs.m_data.integer;
+    break;
+  case VariantTypeUnsignedInteger:
+    m_data.unsignedinteger = rhs.m_data.unsignedinteger;
+    break;
+  case VariantTypeBoolean:
+    m_data.boolean = rhs.m_data.boolean;
+    break;
+  case VariantTypeDouble:
+    m_data.dvalue = rhs.m_data.dvalue;
+    break;
+  case VariantTypeString:
+    new (&m_data.string) std::string(rhs.m_data.string);
+    break;
+  case VariantTypeWideString:
+    new (&m_data.wstring) std::wstring(rhs.m_data.wstring);
+    break;
+  case VariantTypeArray:
+    m_data.array = new VariantArray(*rhs.m_data.array);
+    break;
+  case VariantTypeObject:
+    m_data.map = new VariantMap(*rhs.m_data.map);
+    break;
+  default:
+    m_data.integer = 0;
+    break;
+  }
+}
+
 bool CVariant::isInteger() const
 {
   return isSignedInteger() || isUnsignedInteger();
@@ -402,9 +475,9 @@ int64_t CVariant::asInteger(int64_t fallback) const
     case VariantTypeDouble:
       return (int64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2int64(*m_data.string, fallback);
+      return str2int64(m_data.string, fallback);
     case VariantTypeWideString:
-      return str2int64(*m_data.wstring, fallback);
+      return str2int64(m_data.wstring, fallback);
     default:
       return fallback;
   }
@@ -423,9 +496,9 @@ uint64_t CVariant::asUnsignedInteger(uint64_t fallback) const
     case VariantTypeDouble:
       return (uint64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2uint64(*m_data.string, fallback);
+      return str2uint64(m_data.string, fallback);
     case VariantTypeWideString:
-      return str2uint64(*m_data.wstring, fallback);
+      return str2uint64(m_data.wstring, fallback);
     default:
       return fallback;
   }
@@ -444,9 +517,9 @@ double CVariant::asDouble(double fallback) const
     case VariantTypeUnsignedInteger:
       return (double)m_data.unsignedinteger;
     case VariantTypeString:
-      return str2double(*m_data.string, fallback);
+      return str2double(m_data.string, fallback);
     case VariantTypeWideString:
-      return str2double(*m_data.wstring, fallback);
+      return str2double(m_data.wstring, fallback);
     default:
       return fallback;
   }
@@ -465,9 +538,9 @@ float CVariant::asFloat(float fallback) const
     case VariantTypeUnsignedInteger:
       return (float)m_data.unsignedinteger;
     case VariantTypeString:
-      return (float)str2double(*m_data.string, fallback);
+      return (float)str2double(m_data.string, fallback);
     case VariantTypeWideString:
-      return (float)str2double(*m_data.wstring, fallback);
+      return (float)str2double(m_data.wstring, fallback);
     default:
       return fallback;
   }
@@ -488,11 +561,11 @@ bool CVariant::asBoolean(bool fallback) const
     case VariantTypeDouble:
       return (m_data.dvalue != 0);
     case VariantTypeString:
-      if (m_data.string->empty() || m_data.string->compare("0") == 0 || m_data.string->compare("false") == 0)
+      if (m_data.string.empty() || m_data.string.compare("0") == 0 || m_data.string.compare("false") == 0)
         return false;
       return true;
     case VariantTypeWideString:
-      if (m_data.wstring->empty() || m_data.wstring->compare(L"0") == 0 || m_data.wstring->compare(L"false") == 0)
+      if (m_data.wstring.empty() || m_data.wstring.compare(L"0") == 0 || m_data.wstring.compare(L"false") == 0)
         return false;
       return true;
     default:
@@ -507,7 +580,7 @@ std::string CVariant::asString(const std::string &fallback /* = "" */) const
   switch (m_type)
   {
     case VariantTypeString:
-      return *m_data.string;
+      return m_data.string;
     case VariantTypeBoolean:
       return m_data.boolean ? "true" : "false";
     case VariantTypeInteger:
@@ -535,7 +608,7 @@ std::wstring CVariant::asWideString(const std::wstring &fallback /* = L"" */) co
   switch (m_type)
   {
     case VariantTypeWideString:
-      return *m_data.wstring;
+      return m_data.wstring;
     case VariantTypeBoolean:
       return m_data.boolean ? L"true" : L"false";
     case VariantTypeInteger:
@@ -572,6 +645,20 @@ CVariant &CVariant::operator[](const std::string &key)
     return ConstNullVariant;
 }
 
+CVariant &CVariant::operator[](std::string &&key)
+{
+  if (m_type == VariantTypeNull)
+  {
+    m_type = VariantTypeObject;
+    m_data.map = new VariantMap;
+  }
+
+  if (m_type == VariantTypeObject)
+    return (*m_data.map)[std::move(key)];
+  else
+    return ConstNullVariant;
+}
+
 const CVariant &CVariant::operator[](const std::string &key) const
 {
   VariantMap::const_iterator it;
@@ -602,38 +689,22 @@ CVariant &CVariant::operator=(const CVariant &rhs)
   if (m_type == VariantTypeConstNull || this == &rhs)
     return *this;
 
-  cleanup();
-
-  m_type = rhs.m_type;
-
-  switch (m_type)
+  // reuse the buffer of the string we already hold
+  if (m_type == rhs.m_type && m_type == VariantTypeString)
+    m_data.string = rhs.m_data.string;
+  else if (m_type == rhs.m_type && m_type == VariantTypeWideString)
+    m_data.wstring = rhs.m_data.wstring;
+  else if (m_type == VariantTypeArray || m_type == VariantTypeObject)
   {
-  case VariantTypeInteger:
-    m_data.integer = rhs.m_data.integer;
-    break;
-  case VariantTypeUnsignedInteger:
-    m_data.unsignedinteger = rhs.m_data.unsignedinteger;
-    break;
-  case VariantTypeBoolean:
-    m_data.boolean = rhs.m_data.boolean;
-    break;
-  case VariantTypeDouble:
-    m_data.dvalue = rhs.m_data.dvalue;
-    break;
-  case VariantTypeString:
-    m_data.string = new std::string(*rhs.m_data.string);
-    break;
-  case VariantTypeWideString:
-    m_data.wstring = new std::wstring(*rhs.m_data.wstring);
-    break;
-  case VariantTypeArray:
-    m_data.array = new VariantArray(rhs.m_data.array->begin(), rhs.m_data.array->end());
-    break;
-  case VariantTypeObject:
-    m_data.map = new VariantMap(rhs.m_data.map->begin(), rhs.m_data.map->end());
-    break;
-  default:
-    break;
+    // rhs may be one of our own children, copy it before cleaning up
+    CVariant temp(rhs);
+    cleanup();
+    moveFrom(temp);
+  }
+  else
+  {
+    cleanup();
+    copyFrom(rhs);
   }
 
   return *this;
@@ -644,25 +715,18 @@ CVariant& CVariant::operator=(CVariant&& rhs)
   if (m_type == VariantTypeConstNull || this == &rhs)
     return *this;
 
-  //Make sure that if we're moved into we don't leak any pointers
-  if (m_type != VariantTypeNull)
+  if (m_type == VariantTypeArray || m_type == VariantTypeObject)
+  {
+    // rhs may be one of our own children, take it over before cleaning up
+    CVariant temp(std::move(rhs));
     cleanup();
-
-  m_type = rhs.m_type;
-  m_data = std::move(rhs.m_data);
-
-  //Should be enough to just set m_type here
-  //but better safe than sorry, could probably lead to coverity warnings
-  if (rhs.m_type == VariantTypeString)
-    rhs.m_data.string = nullptr;
-  else if (rhs.m_type == VariantTypeWideString)
-    rhs.m_data.wstring = nullptr;
-  else if (rhs.m_type == VariantTypeArray)
-    rhs.m_data.array = nullptr;
-  else if (rhs.m_type == VariantTypeObject)
-    rhs.m_data.map = nullptr;
-
-  rhs.m_type = VariantTypeNull;
+    moveFrom(temp);
+  }
+  else
+  {
+    cleanup();
+    moveFrom(rhs);
+  }
 
   return *this;
 }
@@ -682,9 +746,9 @@ bool CVariant::operator==(const CVariant &rhs) const
     case VariantTypeDouble:
       return m_data.dvalue == rhs.m_data.dvalue;
     case VariantTypeString:
-      return *m_data.string == *rhs.m_data.string;
+      return m_data.string == rhs.m_data.string;
     case VariantTypeWideString:
-      return *m_data.wstring == *rhs.m_data.wstring;
+      return m_data.wstring == rhs.m_data.wstring;
     case VariantTypeArray:
       return *m_data.array == *rhs.m_data.array;
     case VariantTypeObject:
@@ -734,21 +798,20 @@ void CVariant::append(CVariant&& variant)
 const char *CVariant::c_str() const
 {
   if (m_type == VariantTypeString)
-    return m_data.string->c_str();
+    return m_data.string.c_str();
   else
     return NULL;
 }
 
 void CVariant::swap(CVariant &rhs)
 {
-  VariantType  temp_type = m_type;
-  VariantUnion temp_data = m_data;
-
-  m_type = rhs.m_type;
-  m_data = rhs.m_data;
+  if (this == &rhs)
+    return;
 
-  rhs.m_type = temp_type;
-  rhs.m_data = temp_data;
+  CVariant temp;
+  temp.moveFrom(rhs);
+  rhs.moveFrom(*this);
+  moveFrom(temp);
 }
 
 CVariant::iterator_array CVariant::begin_array()
@@ -822,9 +885,9 @@ unsigned int CVariant::size() const
   else if (m_type == VariantTypeArray)
     return m_data.array->size();
   else if (m_type == VariantTypeString)
-    return m_data.string->size();
+    return m_data.string.size();
   else if (m_type == VariantTypeWideString)
-    return m_data.wstring->size();
+    return m_data.wstring.size();
   else
     return 0;
 }
@@ -836,9 +899,9 @@ bool CVariant::empty() const
   else if (m_type == VariantTypeArray)
     return m_data.array->empty();
   else if (m_type == VariantTypeString)
-    return m_data.string->empty();
+    return m_data.string.empty();
   else if (m_type == VariantTypeWideString)
-    return m_data.wstring->empty();
+    return m_data.wstring.empty();
   else if (m_type == VariantTypeNull)
     return true;
 
@@ -852,9 +915,9 @@ void CVariant::clear()
   else if (m_type == VariantTypeArray)
     m_data.array->clear();
   else if (m_type == VariantTypeString)
-    m_data.string->clear();
+    m_data.string.clear();
   else if (m_type == VariantTypeWideString)
-    m_data.wstring->clear();
+    m_data.wstring.clear();
 }
 
 void CVariant::erase(const std::string &key)
@@ -96,6 +96,7 @@ public:
   float asFloat(float fallback = 0.0f) const;
 
   CVariant &operator[](const std::string &key);
+  CVariant &operator[](std::string &&key);
   const CVariant &operator[](const std::string &key) const;
   CVariant &operator[](unsigned int position);
   const CVariant &operator[](unsigned int position) const;
@@ -147,14 +148,25 @@ public:
 
 private:
   void cleanup();
+  /*! \brief Take over the value of rhs, which is left null. This variant must not hold a value yet. */
+  void moveFrom(CVariant &rhs);
+  /*! \brief Copy the value of rhs. This variant must not hold a value yet. */
+  void copyFrom(const CVariant &rhs);
+
+  /*! Strings are stored inline rather than on the heap, short strings (most
+   object keys and values) fit in the small string buffer of std::string and
+   don't allocate at all. The active member is tracked by m_type. */
   union VariantUnion
   {
+    VariantUnion() : integer(0) {}
+    ~VariantUnion() {}
+
     int64_t integer;
     uint64_t unsignedinteger;
     bool boolean;
     double dvalue;
-    std::string *string;
-    std::wstring *wstring;
+    std::string string;
+    std::wstring wstring;
     VariantArray *array;
     VariantMap *map;
   };
@@ -36,12 +36,84 @@ static const char* const logLevelNames[] =
 // s_globals is used as static global with CLog global variables
 #define s_globals XBMC_GLOBAL_USE(CLog).m_globalInstance
 
+// interval the writer thread drains the queue at if not woken up before
+#define WRITER_INTERVAL_MS 100
+
+CLog::CLogQueue::CLogQueue() :
+  m_slots(new Slot[CAPACITY]),
+  m_pushPos(0),
+  m_popPos(0)
+{
+  for (size_t i = 0; i < CAPACITY; i++)
+    m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool CLog::CLogQueue::Push(LogEntry& entry)
+{
+  // a slot is free for position pos while its sequence is pos, and holds a line once it is pos + 1
+  size_t pos = m_pushPos.load(std::memory_order_relaxed);
+  Slot* slot;
+  for (;;)
+  {
+    slot = &m_slots[pos & (CAPACITY - 1)];
+    intptr_t diff = static_cast<intptr_t>(slot->sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(pos);
+    if (diff == 0)
+    {
+      if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0)
+      return false; // full
+    else
+      pos = m_pushPos.load(std::memory_order_relaxed);
+  }
+
+  slot->entry.time = entry.time;
+  slot->entry.threadId = entry.threadId;
+  slot->entry.logLevel = entry.logLevel;
+  slot->entry.message = std::move(entry.message);
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool CLog::CLogQueue::Pop(LogEntry& entry)
+{
+  size_t pos = m_popPos.load(std::memory_order_relaxed);
+  Slot& slot = m_slots[pos & (CAPACITY - 1)];
+  if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+    return false; // empty, or the line is still being written
+
+  entry.time = slot.entry.time;
+  entry.threadId = slot.entry.threadId;
+  entry.logLevel = slot.entry.logLevel;
+  entry.message = std::move(slot.entry.message);
+  slot.entry.message.clear();
+  slot.sequence.store(pos + CAPACITY, std::memory_order_release);
+  m_popPos.store(pos + 1, std::memory_order_relaxed);
+  return true;
+}
+
+size_t CLog::CLogQueue::Size() const
+{
+  size_t popPos = m_popPos.load(std::memory_order_relaxed);
+  size_t pushPos = m_pushPos.load(std::memory_order_relaxed);
+  return pushPos > popPos ? pushPos - popPos : 0;
+}
+
+CLog::CLogGlobals::~CLogGlobals()
+{
+  StopWriter(*this);
+}
+
 CLog::CLog() = default;
 
 CLog::~CLog() = default;
 
 void CLog::Close()
 {
+  // the writer takes the lock to write
+  StopWriter(s_globals);
+
   CSingleLock waitLock(s_globals.critSec);
   s_globals.m_platform.CloseLogFile();
   s_globals.m_repeatLine.clear();
@@ -101,34 +173,120 @@ void CLog::LogFunction(int loglevel, const char* functionName, int component, co
   }
 }
 
-void CLog::LogString(int logLevel, const std::string& logString)
+void CLog::LogString(int logLevel, std::string logString)
 {
-  CSingleLock waitLock(s_globals.critSec);
-  std::string strData(logString);
-  StringUtils::TrimRight(strData);
-  if (!strData.empty())
+  // only the time and thread are taken here, the line is completed by the writer
+  LogEntry entry;
+  entry.time = std::chrono::system_clock::now();
+  entry.threadId = (uint64_t)CThread::GetCurrentThreadId();
+  entry.logLevel = logLevel;
+  entry.message = std::move(logString);
+
+  // severe errors often precede a crash, write them right away
+  const bool severe = (logLevel & LOGMASK) >= LOGSEVERE;
+
+  if (!s_globals.m_queue.Push(entry))
   {
-    if (s_globals.m_repeatLogLevel == logLevel && s_globals.m_repeatLine == strData)
+    if (!severe || !s_globals.m_writerRunning)
     {
-      s_globals.m_repeatCount++;
+      s_globals.m_droppedLines++;
       return;
     }
-    else if (s_globals.m_repeatCount)
+    Flush(s_globals);
+    if (!s_globals.m_queue.Push(entry))
     {
-      std::string strData2 = StringUtils::Format("Previous line repeats %d times.",
-                                                s_globals.m_repeatCount);
-      PrintDebugString(strData2);
-      WriteLogString(s_globals.m_repeatLogLevel, strData2);
-      s_globals.m_repeatCount = 0;
+      s_globals.m_droppedLines++;
+      return;
     }
+  }
 
-    s_globals.m_repeatLine = strData;
-    s_globals.m_repeatLogLevel = logLevel;
+  if (!s_globals.m_writerRunning)
+    return; // kept until the log file is opened
 
-    PrintDebugString(strData);
+  if (severe)
+    Flush(s_globals);
+  else if (s_globals.m_queue.Size() >= CLogQueue::CAPACITY / 4)
+    s_globals.m_wakeWriter.Set();
+}
 
-    WriteLogString(logLevel, strData);
+void CLog::Flush(CLogGlobals& globals)
+{
+  CSingleLock waitLock(globals.critSec);
+
+  LogEntry entry;
+  while (globals.m_queue.Pop(entry))
+  {
+    StringUtils::TrimRight(entry.message);
+    if (entry.message.empty())
+      continue;
+
+    if (globals.m_repeatLogLevel == entry.logLevel && globals.m_repeatLine == entry.message)
+    {
+      globals.m_repeatCount++;
+      continue;
+    }
+    else if (globals.m_repeatCount)
+    {
+      LogEntry repeat = entry;
+      repeat.logLevel = globals.m_repeatLogLevel;
+      repeat.message = StringUtils::Format("Previous line repeats %d times.", globals.m_repeatCount);
+#if defined(_DEBUG) || defined(PROFILE)
+      globals.m_platform.PrintDebugString(repeat.message);
+#endif
+      WriteLogString(globals, repeat);
+      globals.m_repeatCount = 0;
+    }
+
+    globals.m_repeatLine = entry.message;
+    globals.m_repeatLogLevel = entry.logLevel;
+
+#if defined(_DEBUG) || defined(PROFILE)
+    globals.m_platform.PrintDebugString(entry.message);
+#endif
+
+    WriteLogString(globals, entry);
+  }
+
+  unsigned int dropped = globals.m_droppedLines.exchange(0);
+  if (dropped)
+  {
+    entry.time = std::chrono::system_clock::now();
+    entry.threadId = (uint64_t)CThread::GetCurrentThreadId();
+    entry.logLevel = LOGWARNING;
+    entry.message = StringUtils::Format("%u log lines were dropped, the log queue was full.", dropped);
+    WriteLogString(globals, entry);
   }
+
+  globals.m_platform.FlushLogFile();
+}
+
+void CLog::StartWriter(CLogGlobals& globals)
+{
+  if (globals.m_writer.joinable())
+    return;
+
+  globals.m_writerRunning = true;
+  globals.m_writer = std::thread([&globals]()
+  {
+    while (globals.m_writerRunning)
+    {
+      globals.m_wakeWriter.WaitMSec(WRITER_INTERVAL_MS);
+      Flush(globals);
+    }
+  });
+}
+
+void CLog::StopWriter(CLogGlobals& globals)
+{
+  if (!globals.m_writer.joinable())
+    return;
+
+  globals.m_writerRunning = false;
+  globals.m_wakeWriter.Set();
+  globals.m_writer.join();
+
+  // whatever was logged while the writer stopped
+  Flush(globals);
 }
 
 bool CLog::Init(const std::string& path)
@@ -140,7 +298,9 @@ bool CLog::Init(const std::string& path)
 
   std::string appName = CCompileInfo::GetAppName();
   StringUtils::ToLower(appName);
-  return s_globals.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log");
+  bool ret = s_globals.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log");
+  StartWriter(s_globals);
+  return ret;
 }
 
 void CLog::MemDump(char *pData, int length)
@@ -220,25 +380,25 @@ void CLog::PrintDebugString(const std::string& line)
 #endif // defined(_DEBUG) || defined(PROFILE)
 }
 
-bool CLog::WriteLogString(int logLevel, const std::string& logString)
+bool CLog::WriteLogString(CLogGlobals& globals, const LogEntry& entry)
 {
   static const char* prefixFormat = "%02d:%02d:%02d.%03d T:%" PRIu64" %7s: ";
 
-  std::string strData(logString);
+  std::string strData(entry.message);
   /* fixup newline alignment, number of spaces should equal prefix length */
   StringUtils::Replace(strData, "\n", "\n                                            ");
 
   int hour, minute, second;
   double millisecond;
-  s_globals.m_platform.GetCurrentLocalTime(hour, minute, second, millisecond);
+  globals.m_platform.GetLocalTime(entry.time, hour, minute, second, millisecond);
 
   strData = StringUtils::Format(prefixFormat,
                                   hour,
                                   minute,
                                   second,
                                   static_cast<int>(millisecond),
-                                  (uint64_t)CThread::GetCurrentThreadId(),
-                                  levelNames[logLevel]) + strData;
+                                  entry.threadId,
+                                  levelNames[entry.logLevel]) + strData;
 
-  return s_globals.m_platform.WriteStringToLog(strData);
+  return globals.m_platform.WriteStringToLog(strData);
 }
@@ -20,7 +20,12 @@
  *
  */
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdint.h>
 #include <string>
+#include <thread>
 
 #if defined(TARGET_POSIX)
 #include "posix/PosixInterfaceForCLog.h"
@@ -32,6 +37,7 @@ typedef class CWin32InterfaceForCLog PlatformInterfaceForCLog;
 
 #include "commons/ilog.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "utils/GlobalsHandling.h"
 
 #include "utils/params_check_macros.h"
@@ -56,22 +62,63 @@ public:
   static bool IsLogLevelLogged(int loglevel);
 
 protected:
+  struct LogEntry
+  {
+    std::chrono::system_clock::time_point time;
+    uint64_t threadId;
+    int logLevel;
+    std::string message;
+  };
+
+  /*!
+   \brief Bounded queue of log lines, lock free for the threads adding lines.
+   Only one thread at a time may take lines out of it.
+   */
+  class CLogQueue
+  {
+  public:
+    CLogQueue();
+    bool Push(LogEntry& entry);
+    bool Pop(LogEntry& entry);
+    size_t Size() const;
+
+    static const size_t CAPACITY = 8192; // power of 2
+
+  private:
+    struct Slot
+    {
+      std::atomic<size_t> sequence;
+      LogEntry entry;
+    };
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<size_t> m_pushPos;
+    std::atomic<size_t> m_popPos;
+  };
+
   class CLogGlobals
   {
   public:
-    CLogGlobals(void) : m_repeatCount(0), m_repeatLogLevel(-1), m_logLevel(LOG_LEVEL_DEBUG), m_extraLogLevels(0) {}
-    ~CLogGlobals() = default;
+    CLogGlobals(void) : m_repeatCount(0), m_repeatLogLevel(-1), m_logLevel(LOG_LEVEL_DEBUG), m_extraLogLevels(0), m_droppedLines(0), m_writerRunning(false) {}
+    ~CLogGlobals();
     PlatformInterfaceForCLog m_platform;
     int         m_repeatCount;
     int         m_repeatLogLevel;
     std::string m_repeatLine;
     int         m_logLevel;
     int         m_extraLogLevels;
-    CCriticalSection critSec;
+    CCriticalSection critSec;   // settings, repeat detection and the log file
+    CLogQueue   m_queue;
+    std::atomic<unsigned int> m_droppedLines;
+    std::thread m_writer;       // plain thread, as CThread logs itself
+    std::atomic<bool> m_writerRunning;
+    CEvent      m_wakeWriter;
   };
   class CLogGlobals m_globalInstance; // used as static global variable
-  static void LogString(int logLevel, const std::string& logString);
-  static bool WriteLogString(int logLevel, const std::string& logString);
+  static void LogString(int logLevel, std::string logString);
+  static void Flush(CLogGlobals& globals);
+  static void StartWriter(CLogGlobals& globals);
+  static void StopWriter(CLogGlobals& globals);
+  static bool WriteLogString(CLogGlobals& globals, const LogEntry& entry);
 };
 
 
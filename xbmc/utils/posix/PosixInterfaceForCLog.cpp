@@ -21,7 +21,6 @@
 #include "PosixInterfaceForCLog.h"
 #include <stdio.h>
 #include <time.h>
-#include <sys/time.h>
 
 #if defined(TARGET_DARWIN)
 #include "platform/darwin/DarwinUtils.h"
@@ -78,11 +77,16 @@ bool CPosixInterfaceForCLog::WriteStringToLog(const std::string &logString)
 
   const bool ret = (fwrite(logString.data(), logString.size(), 1, m_file) == 1) &&
                    (fwrite("\n", 1, 1, m_file) == 1);
-  (void)fflush(m_file);
 
   return ret;
 }
 
+void CPosixInterfaceForCLog::FlushLogFile()
+{
+  if (m_file)
+    (void)fflush(m_file);
+}
+
 void CPosixInterfaceForCLog::PrintDebugString(const std::string &debugString)
 {
 #ifdef _DEBUG
@@ -95,17 +99,18 @@ void CPosixInterfaceForCLog::PrintDebugString(const std::string &debugString)
 #endif // _DEBUG
 }
 
-void CPosixInterfaceForCLog::GetCurrentLocalTime(int &hour, int &minute, int &second, double &milliseconds)
+void CPosixInterfaceForCLog::GetLocalTime(const std::chrono::system_clock::time_point& time, int &hour, int &minute, int &second, double &milliseconds)
 {
   struct tm localTime;
-  struct timeval tv;
+  const time_t seconds = std::chrono::system_clock::to_time_t(time);
 
-  if (gettimeofday(&tv, nullptr) != -1 && localtime_r(&tv.tv_sec, &localTime) != NULL)
+  if (localtime_r(&seconds, &localTime) != NULL)
   {
+    const auto sinceEpoch = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch());
     hour   = localTime.tm_hour;
     minute = localTime.tm_min;
     second = localTime.tm_sec;
-    milliseconds = static_cast<double>(tv.tv_usec) / 1000;
+    milliseconds = static_cast<double>(sinceEpoch.count() % 1000000) / 1000;
   }
   else
   {
@@ -19,6 +19,7 @@
  *
  */
 
+#include <chrono>
 #include <string>
 
 struct FILEWRAP; // forward declaration, wrapper for FILE
@@ -31,8 +32,9 @@ public:
   bool OpenLogFile(const std::string& logFilename, const std::string& backupOldLogToFilename);
   void CloseLogFile(void);
   bool WriteStringToLog(const std::string& logString);
+  void FlushLogFile(void);
   void PrintDebugString(const std::string& debugString);
-  static void GetCurrentLocalTime(int& hour, int& minute, int& second, double& millisecond);
+  static void GetLocalTime(const std::chrono::system_clock::time_point& time, int& hour, int& minute, int& second, double& millisecond);
 private:
   FILEWRAP* m_file;
 };
@@ -0,0 +1,103 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils/InitGraph.h"
+
+#include <atomic>
+
+#include "threads/Event.h"
+#include "utils/JobManager.h"
+
+#include "gtest/gtest.h"
+
+using namespace KODI::UTILS;
+
+class TestInitGraph : public testing::Test
+{
+protected:
+  ~TestInitGraph() override
+  {
+    /* stop the dedicated workers the steps ran on */
+    CJobManager::GetInstance().CancelJobs();
+    CJobManager::GetInstance().Restart();
+  }
+};
+
+TEST_F(TestInitGraph, DependencyOrder)
+{
+  std::atomic<int> order(0);
+  int first = -1, second = -1, third = -1;
+
+  CInitGraph graph("test");
+  graph.Add("third", [&]() { third = order++; return true; }, { "first", "second" });
+  graph.Add("second", [&]() { second = order++; return true; }, { "first" });
+  graph.Add("first", [&]() { first = order++; return true; });
+
+  EXPECT_TRUE(graph.Run());
+  EXPECT_EQ(0, first);
+  EXPECT_EQ(1, second);
+  EXPECT_EQ(2, third);
+}
+
+TEST_F(TestInitGraph, IndependentStepsRunInParallel)
+{
+  // each step waits for the other, so they can only finish if run concurrently
+  CEvent left, right;
+  bool leftDone = false, rightDone = false;
+
+  CInitGraph graph("test");
+  graph.Add("left", [&]() { right.Set(); leftDone = left.WaitMSec(10000); return leftDone; });
+  graph.Add("right", [&]() { left.Set(); rightDone = right.WaitMSec(10000); return rightDone; });
+
+  EXPECT_TRUE(graph.Run());
+  EXPECT_TRUE(leftDone);
+  EXPECT_TRUE(rightDone);
+}
+
+TEST_F(TestInitGraph, FailureSkipsDependents)
+{
+  bool independent = false, dependent = false;
+
+  CInitGraph graph("test");
+  graph.Add("failing", []() { return false; });
+  graph.Add("dependent", [&]() { dependent = true; return true; }, { "failing" });
+  graph.Add("indirect", []() { return true; }, { "dependent" });
+  graph.Add("independent", [&]() { independent = true; return true; });
+
+  EXPECT_FALSE(graph.Run());
+  EXPECT_FALSE(dependent);
+  EXPECT_TRUE(independent);
+}
+
+TEST_F(TestInitGraph, InvalidDependencies)
+{
+  bool ran = false;
+
+  CInitGraph unknown("test");
+  unknown.Add("step", [&]() { ran = true; return true; }, { "missing" });
+  EXPECT_FALSE(unknown.Run());
+  EXPECT_FALSE(ran);
+
+  CInitGraph cycle("test");
+  cycle.Add("a", [&]() { ran = true; return true; }, { "b" });
+  cycle.Add("b", [&]() { ran = true; return true; }, { "a" });
+  EXPECT_FALSE(cycle.Run());
+  EXPECT_FALSE(ran);
+}
@@ -25,6 +25,14 @@
 
 #include "gtest/gtest.h"
 
+#include <memory>
+
+#if defined(TARGET_LINUX)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 /* CSysInfoJob::GetInternetState() will test for network connectivity. */
 class TestJobManager : public testing::Test
 {
@@ -154,6 +162,30 @@ WaitForJobToStartProcessing(CJob::PRIORITY priority, JobControlPackage &package)
 
   return job;
 }
+
+struct NiceState
+{
+  int nice = 0;
+  CEvent done;
+};
+
+class NiceJob : public CJob
+{
+public:
+  explicit NiceJob(const std::shared_ptr<NiceState> &state) : m_state(state) {}
+
+  bool DoWork() override
+  {
+#if defined(TARGET_LINUX)
+    m_state->nice = getpriority(PRIO_PROCESS, syscall(SYS_gettid)) - getpriority(PRIO_PROCESS, getpid());
+#endif
+    m_state->done.Set();
+    return true;
+  }
+
+private:
+  std::shared_ptr<NiceState> m_state;
+};
 }
   
 TEST_F(TestJobManager, PauseLowPriorityJob)
@@ -179,3 +211,39 @@ TEST_F(TestJobManager, IsProcessing)
 
   job->FinishAndStopBlocking();
 }
+
+TEST_F(TestJobManager, QueueStats)
+{
+  JobControlPackage package;
+  BroadcastingJob *job (WaitForJobToStartProcessing(CJob::PRIORITY_NORMAL, package));
+
+  CJobManager::QueueStats stats = CJobManager::GetInstance().GetQueueStats(CJob::PRIORITY_NORMAL);
+  EXPECT_EQ(0U, stats.queued);
+  EXPECT_EQ(1U, stats.processing);
+  EXPECT_LE(1U, stats.started);
+  EXPECT_LE(0.0, stats.maxWaitMs);
+  EXPECT_LE(1U, CJobManager::GetInstance().GetWorkerCount());
+
+  CJobManager::GetInstance().PauseJobs();
+  CJobManager::GetInstance().AddJob(new CSysInfoJob(), NULL, CJob::PRIORITY_LOW_PAUSABLE);
+  EXPECT_EQ(1U, CJobManager::GetInstance().GetQueueStats(CJob::PRIORITY_LOW_PAUSABLE).queued);
+  CJobManager::GetInstance().UnPauseJobs();
+
+  job->FinishAndStopBlocking();
+}
+
+TEST_F(TestJobManager, BackgroundRoleOnlyForLowPriority)
+{
+  // a worker that ran a low priority job must not run a high priority one at its level
+  std::shared_ptr<NiceState> low = std::make_shared<NiceState>();
+  CJobManager::GetInstance().AddJob(new NiceJob(low), NULL, CJob::PRIORITY_LOW);
+  ASSERT_TRUE(low->done.WaitMSec(10000));
+
+  std::shared_ptr<NiceState> high = std::make_shared<NiceState>();
+  CJobManager::GetInstance().AddJob(new NiceJob(high), NULL, CJob::PRIORITY_HIGH);
+  ASSERT_TRUE(high->done.WaitMSec(10000));
+#if defined(TARGET_LINUX)
+  EXPECT_LT(high->nice, low->nice);
+#endif
+  EXPECT_EQ(2U, CJobManager::GetInstance().GetWorkerCount());
+}
@@ -0,0 +1,147 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils/ParallelAlgorithms.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+#include "utils/JobManager.h"
+
+#include "gtest/gtest.h"
+
+using namespace KODI::UTILS;
+
+namespace
+{
+typedef std::pair<int, int> KeyValue;
+
+std::vector<KeyValue> GenerateItems(size_t count)
+{
+  // few distinct keys, so stability of the sort matters
+  std::vector<KeyValue> items;
+  items.reserve(count);
+  unsigned int seed = 42;
+  for (size_t i = 0; i < count; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    items.push_back(KeyValue((seed >> 16) % 97, static_cast<int>(i)));
+  }
+  return items;
+}
+
+bool CompareKey(const KeyValue& left, const KeyValue& right)
+{
+  return left.first < right.first;
+}
+}
+
+class TestParallelAlgorithms : public testing::Test
+{
+protected:
+  ~TestParallelAlgorithms() override
+  {
+    /* stop the workers the helper jobs ran on */
+    CJobManager::GetInstance().CancelJobs();
+    CJobManager::GetInstance().Restart();
+  }
+};
+
+TEST_F(TestParallelAlgorithms, ParallelForVisitsEveryElementOnce)
+{
+  std::vector<std::atomic<int>> visits(10007);
+  for (auto& visit : visits)
+    visit = 0;
+
+  ParallelFor(visits.size(), 64, [&visits](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; i++)
+      visits[i]++;
+  });
+
+  for (const auto& visit : visits)
+    EXPECT_EQ(1, visit);
+}
+
+TEST_F(TestParallelAlgorithms, ParallelForEmpty)
+{
+  bool called = false;
+  ParallelFor(0, 16, [&called](size_t begin, size_t end) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST_F(TestParallelAlgorithms, ParallelForBelowThreshold)
+{
+  // small ranges are handed to the body in one go, on the calling thread
+  std::vector<std::pair<size_t, size_t>> calls;
+  ParallelFor(100, 1, [&calls](size_t begin, size_t end) { calls.push_back(std::make_pair(begin, end)); }, 101);
+  ASSERT_EQ(1u, calls.size());
+  EXPECT_EQ(0u, calls[0].first);
+  EXPECT_EQ(100u, calls[0].second);
+}
+
+TEST_F(TestParallelAlgorithms, ParallelForRethrows)
+{
+  std::atomic<size_t> visited(0);
+  EXPECT_THROW(ParallelFor(10000, 16, [&visited](size_t begin, size_t end)
+  {
+    visited += end - begin;
+    if (begin == 160)
+      throw std::runtime_error("failed");
+  }), std::runtime_error);
+  // the other chunks are still processed
+  EXPECT_EQ(10000u, visited);
+}
+
+TEST_F(TestParallelAlgorithms, ParallelStableSortMatchesStableSort)
+{
+  std::vector<KeyValue> expected = GenerateItems(50000);
+  std::vector<KeyValue> items = expected;
+
+  std::stable_sort(expected.begin(), expected.end(), CompareKey);
+  ParallelStableSort(items.begin(), items.end(), CompareKey, 256);
+
+  EXPECT_EQ(expected, items);
+}
+
+TEST_F(TestParallelAlgorithms, ParallelStableSortBelowThreshold)
+{
+  std::vector<KeyValue> expected = GenerateItems(100);
+  std::vector<KeyValue> items = expected;
+
+  std::stable_sort(expected.begin(), expected.end(), CompareKey);
+  ParallelStableSort(items.begin(), items.end(), CompareKey);
+
+  EXPECT_EQ(expected, items);
+}
+
+TEST_F(TestParallelAlgorithms, ParallelRemoveIfKeepsOrder)
+{
+  std::vector<KeyValue> expected = GenerateItems(20000);
+  std::vector<KeyValue> items = expected;
+
+  auto isOdd = [](const KeyValue& item) { return (item.first % 2) != 0; };
+  expected.erase(std::remove_if(expected.begin(), expected.end(), isOdd), expected.end());
+  size_t removed = ParallelRemoveIf(items, isOdd, 256);
+
+  EXPECT_EQ(20000 - expected.size(), removed);
+  EXPECT_EQ(expected, items);
+}
@@ -236,6 +236,33 @@ TEST(TestVariant, swap)
   EXPECT_TRUE(a.isString());
 }
 
+TEST(TestVariant, move)
+{
+  CVariant a("a string too long for the small string buffer");
+  CVariant b(std::move(a));
+
+  EXPECT_TRUE(a.isNull());
+  EXPECT_STREQ("a string too long for the small string buffer", b.c_str());
+
+  a = std::move(b);
+  EXPECT_TRUE(b.isNull());
+  EXPECT_STREQ("a string too long for the small string buffer", a.c_str());
+}
+
+TEST(TestVariant, assignChild)
+{
+  CVariant a;
+  a["key1"]["key2"] = "string";
+  a = a["key1"];
+  EXPECT_STREQ("string", a["key2"].c_str());
+
+  CVariant b;
+  b.push_back(CVariant("string1"));
+  b.push_back(CVariant("string2"));
+  b = std::move(b[1]);
+  EXPECT_STREQ("string2", b.c_str());
+}
+
 TEST(TestVariant, iterator_array)
 {
   std::vector<std::string> strarray;
@@ -0,0 +1,205 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "test/LibraryBenchmark.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+namespace
+{
+// payload sizes at --set-benchmark-scale 1.0
+const unsigned int FULL_MOVIES = 5000;
+const unsigned int FULL_VALUES = 1000000;
+
+const unsigned int ITERATIONS = 10;
+
+// shaped like the response of VideoLibrary.GetMovies with the usual skin properties
+CVariant BuildMovies(unsigned int movies)
+{
+  CVariant result(CVariant::VariantTypeObject);
+  CVariant &list = result["movies"] = CVariant(CVariant::VariantTypeArray);
+  for (unsigned int i = 0; i < movies; i++)
+  {
+    CVariant movie(CVariant::VariantTypeObject);
+    movie["movieid"] = i + 1;
+    movie["label"] = StringUtils::Format("Movie %u", i + 1);
+    movie["title"] = StringUtils::Format("Movie %u", i + 1);
+    movie["year"] = 1950 + i % 68;
+    movie["rating"] = (i % 100) / 10.0;
+    movie["playcount"] = i % 3;
+    movie["file"] = StringUtils::Format("/media/movies/%u/Movie %u.mkv", i / 1000, i + 1);
+    movie["plot"] = "A synthetic movie to benchmark the variant with.";
+    CVariant &genres = movie["genre"] = CVariant(CVariant::VariantTypeArray);
+    genres.push_back(StringUtils::Format("Genre %u", i % 40));
+    genres.push_back(StringUtils::Format("Genre %u", (i + 7) % 40));
+    CVariant &art = movie["art"] = CVariant(CVariant::VariantTypeObject);
+    art["poster"] = StringUtils::Format("image://%%2fmedia%%2fmovies%%2f%u%%2fposter.jpg/", i + 1);
+    art["fanart"] = StringUtils::Format("image://%%2fmedia%%2fmovies%%2f%u%%2ffanart.jpg/", i + 1);
+    list.push_back(std::move(movie));
+  }
+  result["limits"]["start"] = 0;
+  result["limits"]["end"] = movies;
+  result["limits"]["total"] = movies;
+  return result;
+}
+
+// reads every member the way a JSON-RPC client handler or skin would
+int ReadMovies(const CVariant &result)
+{
+  int fields = 0;
+  const CVariant &list = result["movies"];
+  for (CVariant::const_iterator_array movie = list.begin_array(); movie != list.end_array(); ++movie)
+  {
+    for (CVariant::const_iterator_map field = movie->begin_map(); field != movie->end_map(); ++field)
+    {
+      if (!field->second.isNull())
+        fields++;
+    }
+  }
+  return fields;
+}
+}
+
+class TestVariantBenchmark : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    m_benchmark.reset(new CLibraryBenchmark("variant"));
+    // every CVariant in an array or object costs this much, whatever it holds
+    m_benchmark->SetInfo("sizeof_variant", static_cast<uint64_t>(sizeof(CVariant)));
+    m_benchmark->SetInfo("sizeof_string", static_cast<uint64_t>(sizeof(std::string)));
+  }
+
+  static void TearDownTestCase()
+  {
+    EXPECT_TRUE(m_benchmark->Write());
+    m_benchmark.reset();
+  }
+
+  static std::unique_ptr<CLibraryBenchmark> m_benchmark;
+};
+
+std::unique_ptr<CLibraryBenchmark> TestVariantBenchmark::m_benchmark;
+
+TEST_F(TestVariantBenchmark, DISABLED_JsonRpcRoundTrip)
+{
+  const unsigned int movies = CLibraryBenchmark::Scaled(FULL_MOVIES);
+  m_benchmark->SetInfo("movies", movies);
+
+  CVariant result;
+  EXPECT_TRUE(m_benchmark->Measure("Build", ITERATIONS, [&]()
+  {
+    result = BuildMovies(movies);
+    return static_cast<int>(result["movies"].size());
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("Copy", ITERATIONS, [&]()
+  {
+    CVariant copy(result);
+    return static_cast<int>(copy["movies"].size());
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("Read", ITERATIONS, [&]()
+  {
+    return ReadMovies(result);
+  }));
+
+  std::string json;
+  EXPECT_TRUE(m_benchmark->Measure("Write", ITERATIONS, [&]()
+  {
+    json.clear();
+    if (!CJSONVariantWriter::Write(result, json, true))
+      return -1;
+    return static_cast<int>(json.size());
+  }));
+  m_benchmark->SetInfo("json_bytes", static_cast<uint64_t>(json.size()));
+
+  EXPECT_TRUE(m_benchmark->Measure("Parse", ITERATIONS, [&]()
+  {
+    CVariant parsed;
+    if (!CJSONVariantParser::Parse(json, parsed))
+      return -1;
+    return static_cast<int>(parsed["movies"].size());
+  }));
+}
+
+TEST_F(TestVariantBenchmark, DISABLED_ScalarArray)
+{
+  // arrays of plain numbers pay for the size of the largest member of the
+  // variant, see sizeof_variant
+  const unsigned int values = CLibraryBenchmark::Scaled(FULL_VALUES);
+  m_benchmark->SetInfo("scalar_values", values);
+  m_benchmark->SetInfo("scalar_array_bytes", static_cast<uint64_t>(values) * sizeof(CVariant));
+
+  CVariant array(CVariant::VariantTypeArray);
+  EXPECT_TRUE(m_benchmark->Measure("ScalarArray/Build", ITERATIONS, [&]()
+  {
+    array = CVariant(CVariant::VariantTypeArray);
+    for (unsigned int i = 0; i < values; i++)
+      array.push_back(static_cast<int64_t>(i));
+    return static_cast<int>(array.size());
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("ScalarArray/Copy", ITERATIONS, [&]()
+  {
+    CVariant copy(array);
+    return static_cast<int>(copy.size());
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("ScalarArray/Sum", ITERATIONS, [&]()
+  {
+    int64_t sum = 0;
+    for (CVariant::const_iterator_array value = array.begin_array(); value != array.end_array(); ++value)
+      sum += value->asInteger();
+    return sum >= 0 ? static_cast<int>(array.size()) : -1;
+  }));
+}
+
+TEST_F(TestVariantBenchmark, DISABLED_StringArray)
+{
+  // short strings stay within the variant, long ones still allocate
+  const unsigned int values = CLibraryBenchmark::Scaled(FULL_VALUES);
+  for (const auto &length : { 8u, 64u })
+  {
+    const std::string name = StringUtils::Format("StringArray/%u", length);
+    CVariant array(CVariant::VariantTypeArray);
+    EXPECT_TRUE(m_benchmark->Measure(name + "/Build", ITERATIONS, [&]()
+    {
+      array = CVariant(CVariant::VariantTypeArray);
+      for (unsigned int i = 0; i < values; i++)
+        array.push_back(std::string(length, static_cast<char>('a' + i % 26)));
+      return static_cast<int>(array.size());
+    }));
+
+    EXPECT_TRUE(m_benchmark->Measure(name + "/Copy", ITERATIONS, [&]()
+    {
+      CVariant copy(array);
+      return static_cast<int>(copy.size());
+    }));
+  }
+}
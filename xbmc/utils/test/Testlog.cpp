@@ -30,6 +30,9 @@
 
 #include "gtest/gtest.h"
 
+#include <thread>
+#include <vector>
+
 class Testlog : public testing::Test
 {
 protected:
@@ -134,6 +137,54 @@ TEST_F(Testlog, MemDump)
   EXPECT_TRUE(XFILE::CFile::Delete(logfile));
 }
 
+TEST_F(Testlog, ConcurrentLog)
+{
+  std::string logfile, logstring;
+  char buf[100];
+  unsigned int bytesread;
+  XFILE::CFile file;
+
+  std::string appName = CCompileInfo::GetAppName();
+  StringUtils::ToLower(appName);
+  logfile = CSpecialProtocol::TranslatePath("special://temp/") + appName + ".log";
+  EXPECT_TRUE(CLog::Init(CSpecialProtocol::TranslatePath("special://temp/").c_str()));
+  EXPECT_TRUE(XFILE::CFile::Exists(logfile));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++)
+  {
+    threads.emplace_back([i]()
+    {
+      for (int line = 0; line < 100; line++)
+        CLog::Log(LOGDEBUG, "thread %d line %d", i, line);
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  CLog::Close();
+
+  EXPECT_TRUE(file.Open(logfile));
+  while ((bytesread = file.Read(buf, sizeof(buf) - 1)) > 0)
+  {
+    buf[bytesread] = '\0';
+    logstring.append(buf);
+  }
+  file.Close();
+
+  // every line is written by Close, in the order of each thread
+  for (int i = 0; i < 4; i++)
+  {
+    size_t pos = 0;
+    for (int line = 0; line < 100; line++)
+    {
+      pos = logstring.find(StringUtils::Format("DEBUG: thread %d line %d\n", i, line), pos);
+      ASSERT_NE(std::string::npos, pos);
+    }
+  }
+
+  EXPECT_TRUE(XFILE::CFile::Delete(logfile));
+}
+
 TEST_F(Testlog, SetLogLevel)
 {
   std::string logfile;
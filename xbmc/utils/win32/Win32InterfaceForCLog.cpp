@@ -31,6 +31,7 @@
 #define WIN32_LEAN_AND_MEAN 1
 #endif // WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#include <time.h>
 
 CWin32InterfaceForCLog::CWin32InterfaceForCLog() :
   m_hFile(INVALID_HANDLE_VALUE)
@@ -96,6 +97,11 @@ bool CWin32InterfaceForCLog::WriteStringToLog(const std::string& logString)
   return ret;
 }
 
+void CWin32InterfaceForCLog::FlushLogFile()
+{
+  // WriteFile isn't buffered by us, nothing to do
+}
+
 void CWin32InterfaceForCLog::PrintDebugString(const std::string& debugString)
 {
 #ifdef _DEBUG
@@ -110,12 +116,22 @@ void CWin32InterfaceForCLog::PrintDebugString(const std::string& debugString)
 #endif // _DEBUG
 }
 
-void CWin32InterfaceForCLog::GetCurrentLocalTime(int& hour, int& minute, int& second, double& millisecond)
+void CWin32InterfaceForCLog::GetLocalTime(const std::chrono::system_clock::time_point& time, int& hour, int& minute, int& second, double& millisecond)
 {
-  SYSTEMTIME time;
-  GetLocalTime(&time);
-  hour = time.wHour;
-  minute = time.wMinute;
-  second = time.wSecond;
-  millisecond = static_cast<double>(time.wMilliseconds);
+  struct tm localTime;
+  const time_t seconds = std::chrono::system_clock::to_time_t(time);
+
+  if (localtime_s(&localTime, &seconds) == 0)
+  {
+    const auto sinceEpoch = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch());
+    hour = localTime.tm_hour;
+    minute = localTime.tm_min;
+    second = localTime.tm_sec;
+    millisecond = static_cast<double>(sinceEpoch.count() % 1000000) / 1000;
+  }
+  else
+  {
+    hour = minute = second = 0;
+    millisecond = 0.0;
+  }
 }
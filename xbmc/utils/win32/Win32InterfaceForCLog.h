@@ -19,6 +19,7 @@
 *
 */
 
+#include <chrono>
 #include <string>
 
 typedef void* HANDLE; // forward declaration, to avoid inclusion of whole Windows.h
@@ -31,8 +32,9 @@ public:
   bool OpenLogFile(const std::string& logFilename, const std::string& backupOldLogToFilename);
   void CloseLogFile(void);
   bool WriteStringToLog(const std::string& logString);
+  void FlushLogFile(void);
   void PrintDebugString(const std::string& debugString);
-  static void GetCurrentLocalTime(int& hour, int& minute, int& second, double& millisecond);
+  static void GetLocalTime(const std::chrono::system_clock::time_point& time, int& hour, int& minute, int& second, double& millisecond);
 private:
   HANDLE m_hFile;
 };
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -77,6 +78,65 @@ using namespace VIDEO;
 using namespace ADDON;
 using namespace KODI::MESSAGING;
 
+namespace
+{
+struct LinkCountTable
+{
+  const char *table;      // the link table is <table>_link
+  const char *foreignkey; // its id column is <foreignkey>_id
+};
+
+// link tables whose number of linked items is kept in the linkcounts table
+const LinkCountTable LinkCountTables[] = {
+  { "genre", "genre" },
+  { "country", "country" },
+  { "studio", "studio" },
+  { "tag", "tag" },
+  { "actor", "actor" },
+  { "director", "actor" },
+  { "writer", "actor" },
+};
+
+// 1 if the file of the movie, music video or episode a link row points to is watched, else 0
+std::string GetLinkWatchedSQL(const char *row)
+{
+  return StringUtils::Format("(SELECT COUNT(files.playCount) FROM files WHERE files.idFile=CASE %s.media_type "
+                             "WHEN 'movie' THEN (SELECT idFile FROM movie WHERE idMovie=%s.media_id) "
+                             "WHEN 'musicvideo' THEN (SELECT idFile FROM musicvideo WHERE idMVideo=%s.media_id) "
+                             "WHEN 'episode' THEN (SELECT idFile FROM episode WHERE idEpisode=%s.media_id) END)",
+                             row, row, row, row);
+}
+
+// adds delta to the watched count of the values linked to the items of a file
+std::string GetFileWatchedSQL(const LinkCountTable &link, const std::string &delta, const std::string &condition, const char *idFile)
+{
+  return StringUtils::Format("UPDATE linkcounts SET watched=watched+(%s) "
+                             "WHERE %s AND link_type='%s' AND ("
+                             "(media_type='movie' AND link_id IN (SELECT %s_id FROM %s_link WHERE media_type='movie' AND media_id IN (SELECT idMovie FROM movie WHERE idFile=%s))) OR "
+                             "(media_type='musicvideo' AND link_id IN (SELECT %s_id FROM %s_link WHERE media_type='musicvideo' AND media_id IN (SELECT idMVideo FROM musicvideo WHERE idFile=%s))) OR "
+                             "(media_type='episode' AND link_id IN (SELECT %s_id FROM %s_link WHERE media_type='episode' AND media_id IN (SELECT idEpisode FROM episode WHERE idFile=%s)))); ",
+                             delta.c_str(), condition.c_str(), link.table,
+                             link.foreignkey, link.table, idFile,
+                             link.foreignkey, link.table, idFile,
+                             link.foreignkey, link.table, idFile);
+}
+
+// removes a deleted movie, music video or episode from the watched counts of its links,
+// the links are deleted after it and can't find its file anymore
+std::string GetMediaWatchedSQL(const char *mediaType, const char *idColumn)
+{
+  std::string sql;
+  for (const auto &link : LinkCountTables)
+    sql += StringUtils::Format("UPDATE linkcounts SET watched=watched-1 "
+                               "WHERE link_type='%s' AND media_type='%s' AND "
+                               "link_id IN (SELECT %s_id FROM %s_link WHERE media_type='%s' AND media_id=old.%s) AND "
+                               "EXISTS (SELECT 1 FROM files WHERE files.idFile=old.idFile AND files.playCount IS NOT NULL); ",
+                               link.table, mediaType,
+                               link.foreignkey, link.table, mediaType, idColumn);
+  return sql;
+}
+}
+
 //********************************************************************************************************************************
 CVideoDatabase::CVideoDatabase(void) = default;
 
@@ -200,6 +260,12 @@ void CVideoDatabase::CreateTables()
 
   CLog::Log(LOGINFO, "create uniqueid table");
   m_pDS->exec("CREATE TABLE uniqueid (uniqueid_id INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, value TEXT, type TEXT)");
+
+  CLog::Log(LOGINFO, "create tvshowcounts table");
+  m_pDS->exec("CREATE TABLE tvshowcounts (idShow INTEGER PRIMARY KEY, lastPlayed TEXT, totalCount INTEGER, watchedcount INTEGER, totalSeasons INTEGER, dateAdded TEXT)");
+
+  CLog::Log(LOGINFO, "create linkcounts table");
+  m_pDS->exec("CREATE TABLE linkcounts (link_type TEXT, link_id INTEGER, media_type TEXT, total INTEGER, watched INTEGER)");
 }
 
 void CVideoDatabase::CreateLinkIndex(const char *table)
@@ -271,6 +337,8 @@ void CVideoDatabase::CreateAnalytics()
   m_pDS->exec("CREATE INDEX ix_uniqueid1 ON uniqueid(media_id, media_type(20), type(20))");
   m_pDS->exec("CREATE INDEX ix_uniqueid2 ON uniqueid(media_type(20), value(20))");
 
+  m_pDS->exec("CREATE UNIQUE INDEX ix_linkcounts ON linkcounts (link_type(20), media_type(20), link_id)");
+
   CreateLinkIndex("tag");
   CreateLinkIndex("actor");
   CreateForeignLinkIndex("director", "actor");
@@ -280,7 +348,8 @@ void CVideoDatabase::CreateAnalytics()
   CreateLinkIndex("country");
 
   CLog::Log(LOGINFO, "%s - creating triggers", __FUNCTION__);
-  m_pDS->exec("CREATE TRIGGER delete_movie AFTER DELETE ON movie FOR EACH ROW BEGIN "
+  m_pDS->exec("CREATE TRIGGER delete_movie AFTER DELETE ON movie FOR EACH ROW BEGIN " +
+              GetMediaWatchedSQL("movie", "idMovie") +
               "DELETE FROM genre_link WHERE media_id=old.idMovie AND media_type='movie'; "
               "DELETE FROM actor_link WHERE media_id=old.idMovie AND media_type='movie'; "
               "DELETE FROM director_link WHERE media_id=old.idMovie AND media_type='movie'; "
@@ -305,8 +374,10 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM tag_link WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM rating WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM uniqueid WHERE media_id=old.idShow AND media_type='tvshow'; "
+              "DELETE FROM tvshowcounts WHERE idShow=old.idShow; "
               "END");
-  m_pDS->exec("CREATE TRIGGER delete_musicvideo AFTER DELETE ON musicvideo FOR EACH ROW BEGIN "
+  m_pDS->exec("CREATE TRIGGER delete_musicvideo AFTER DELETE ON musicvideo FOR EACH ROW BEGIN " +
+              GetMediaWatchedSQL("musicvideo", "idMVideo") +
               "DELETE FROM actor_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM director_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM genre_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
@@ -314,13 +385,15 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM art WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM tag_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "END");
-  m_pDS->exec("CREATE TRIGGER delete_episode AFTER DELETE ON episode FOR EACH ROW BEGIN "
+  m_pDS->exec("CREATE TRIGGER delete_episode AFTER DELETE ON episode FOR EACH ROW BEGIN " +
+              GetMediaWatchedSQL("episode", "idEpisode") +
               "DELETE FROM actor_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM director_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM writer_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM art WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM rating WHERE media_id=old.idEpisode AND media_type='episode'; "
-              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; "
+              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; " +
+              GetShowCountsSQL("tvshow.idShow=old.idShow") + "; "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_season AFTER DELETE ON seasons FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idSeason AND media_type='season'; "
@@ -331,19 +404,99 @@ void CVideoDatabase::CreateAnalytics()
   m_pDS->exec("CREATE TRIGGER delete_person AFTER DELETE ON actor FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.actor_id AND media_type IN ('actor','artist','writer','director'); "
               "END");
-  m_pDS->exec("CREATE TRIGGER delete_tag AFTER DELETE ON tag_link FOR EACH ROW BEGIN "
-              "DELETE FROM tag WHERE tag_id=old.tag_id AND tag_id NOT IN (SELECT DISTINCT tag_id FROM tag_link); "
+
+  // keep the episode and watched counts of tvshows up to date
+  m_pDS->exec("CREATE TRIGGER insert_tvshow AFTER INSERT ON tvshow FOR EACH ROW BEGIN " +
+              GetShowCountsSQL("tvshow.idShow=new.idShow") + "; "
+              "END");
+  m_pDS->exec("CREATE TRIGGER insert_episode AFTER INSERT ON episode FOR EACH ROW BEGIN " +
+              GetShowCountsSQL("tvshow.idShow=new.idShow") + "; "
               "END");
+  m_pDS->exec("CREATE TRIGGER update_episode AFTER UPDATE ON episode FOR EACH ROW BEGIN " +
+              GetShowCountsSQL(StringUtils::Format("tvshow.idShow IN (new.idShow, old.idShow) AND "
+                                                   "(new.idShow<>old.idShow OR new.idFile<>old.idFile OR "
+                                                   "COALESCE(new.c%02d, '')<>COALESCE(old.c%02d, ''))",
+                                                   VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_EPISODE_SEASON)) + "; "
+              "END");
+
+  // keep the number of items linked to genres, actors etc. up to date, a row at a time
+  // as a recount gets slower with every item added to a common genre or studio
+  std::string updateFileCounts;
+  std::string deleteFileCounts;
+  for (const auto &link : LinkCountTables)
+  {
+    std::string insertCounts = StringUtils::Format("%s INTO linkcounts (link_type, link_id, media_type, total, watched) "
+                                                   "VALUES ('%s', new.%s_id, new.media_type, 0, 0); ",
+                                                   m_sqlite ? "INSERT OR IGNORE" : "INSERT IGNORE",
+                                                   link.table, link.foreignkey);
+    insertCounts += StringUtils::Format("UPDATE linkcounts SET total=total+1, watched=watched+%s "
+                                        "WHERE link_type='%s' AND link_id=new.%s_id AND media_type=new.media_type; ",
+                                        GetLinkWatchedSQL("new").c_str(), link.table, link.foreignkey);
+    m_pDS->exec(StringUtils::Format("CREATE TRIGGER insert_%s_link AFTER INSERT ON %s_link FOR EACH ROW BEGIN ", link.table, link.table) +
+                insertCounts +
+                "END");
+
+    std::string deleteCounts = StringUtils::Format("UPDATE linkcounts SET total=total-1, watched=watched-%s "
+                                                   "WHERE link_type='%s' AND link_id=old.%s_id AND media_type=old.media_type; ",
+                                                   GetLinkWatchedSQL("old").c_str(), link.table, link.foreignkey);
+    deleteCounts += StringUtils::Format("DELETE FROM linkcounts WHERE link_type='%s' AND link_id=old.%s_id AND media_type=old.media_type AND total<=0; ",
+                                        link.table, link.foreignkey);
+    if (std::string(link.table) == "tag")
+      deleteCounts += "DELETE FROM tag WHERE tag_id=old.tag_id AND tag_id NOT IN (SELECT DISTINCT tag_id FROM tag_link); ";
+    m_pDS->exec(StringUtils::Format("CREATE TRIGGER delete_%s_link AFTER DELETE ON %s_link FOR EACH ROW BEGIN ", link.table, link.table) +
+                deleteCounts +
+                "END");
+
+    // only the watched count changes with the playcount, and only if it changes from or to unwatched
+    updateFileCounts += GetFileWatchedSQL(link, "(new.playCount IS NOT NULL)-(old.playCount IS NOT NULL)",
+                                          "(new.playCount IS NULL)<>(old.playCount IS NULL)", "new.idFile");
+    // the items of a deleted file may still be linked, they count as unwatched from now on
+    deleteFileCounts += GetFileWatchedSQL(link, "-1", "old.playCount IS NOT NULL", "old.idFile");
+  }
   m_pDS->exec("CREATE TRIGGER delete_file AFTER DELETE ON files FOR EACH ROW BEGIN "
               "DELETE FROM bookmark WHERE idFile=old.idFile; "
               "DELETE FROM settings WHERE idFile=old.idFile; "
               "DELETE FROM stacktimes WHERE idFile=old.idFile; "
-              "DELETE FROM streamdetails WHERE idFile=old.idFile; "
+              "DELETE FROM streamdetails WHERE idFile=old.idFile; " +
+              deleteFileCounts +
+              "END");
+  // the resume point and the path of a file don't change the tvshow counts
+  m_pDS->exec("CREATE TRIGGER update_file AFTER UPDATE ON files FOR EACH ROW BEGIN " +
+              GetShowCountsSQL("tvshow.idShow IN (SELECT idShow FROM episode WHERE idFile=new.idFile) AND "
+                               "(COALESCE(new.playCount, -1)<>COALESCE(old.playCount, -1) OR "
+                               "COALESCE(new.lastPlayed, '')<>COALESCE(old.lastPlayed, '') OR "
+                               "COALESCE(new.dateAdded, '')<>COALESCE(old.dateAdded, ''))") + "; " +
+              updateFileCounts +
               "END");
 
   CreateViews();
 }
 
+std::string CVideoDatabase::GetShowCountsSQL(const std::string &condition) const
+{
+  return StringUtils::Format("REPLACE INTO tvshowcounts (idShow, lastPlayed, totalCount, watchedcount, totalSeasons, dateAdded) "
+                             "SELECT tvshow.idShow, MAX(files.lastPlayed), NULLIF(COUNT(episode.c%02d), 0), COUNT(files.playCount), "
+                             "NULLIF(COUNT(DISTINCT(episode.c%02d)), 0), MAX(files.dateAdded) "
+                             "FROM tvshow "
+                             "LEFT JOIN episode ON episode.idShow=tvshow.idShow "
+                             "LEFT JOIN files ON files.idFile=episode.idFile "
+                             "WHERE %s GROUP BY tvshow.idShow",
+                             VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_EPISODE_SEASON, condition.c_str());
+}
+
+std::string CVideoDatabase::GetLinkCountsSQL(const char *table, const char *foreignkey, const std::string &condition) const
+{
+  return StringUtils::Format("REPLACE INTO linkcounts (link_type, link_id, media_type, total, watched) "
+                             "SELECT '%s', lnk.%s_id, lnk.media_type, COUNT(1), COUNT(files.playCount) "
+                             "FROM %s_link AS lnk "
+                             "LEFT JOIN movie ON lnk.media_type='movie' AND movie.idMovie=lnk.media_id "
+                             "LEFT JOIN musicvideo ON lnk.media_type='musicvideo' AND musicvideo.idMVideo=lnk.media_id "
+                             "LEFT JOIN episode ON lnk.media_type='episode' AND episode.idEpisode=lnk.media_id "
+                             "LEFT JOIN files ON files.idFile=COALESCE(movie.idFile, musicvideo.idFile, episode.idFile) "
+                             "WHERE %s GROUP BY lnk.%s_id, lnk.media_type",
+                             table, foreignkey, table, condition.c_str(), foreignkey);
+}
+
 void CVideoDatabase::CreateViews()
 {
   CLog::Log(LOGINFO, "create episode_view");
@@ -388,22 +541,6 @@ void CVideoDatabase::CreateViews()
                                       VIDEODB_ID_EPISODE_IDENT_ID);
   m_pDS->exec(episodeview);
 
-  CLog::Log(LOGINFO, "create tvshowcounts");
-  std::string tvshowcounts = PrepareSQL("CREATE VIEW tvshowcounts AS SELECT "
-                                       "      tvshow.idShow AS idShow,"
-                                       "      MAX(files.lastPlayed) AS lastPlayed,"
-                                       "      NULLIF(COUNT(episode.c12), 0) AS totalCount,"
-                                       "      COUNT(files.playCount) AS watchedcount,"
-                                       "      NULLIF(COUNT(DISTINCT(episode.c12)), 0) AS totalSeasons, "
-                                       "      MAX(files.dateAdded) as dateAdded "
-                                       "    FROM tvshow"
-                                       "      LEFT JOIN episode ON"
-                                       "        episode.idShow=tvshow.idShow"
-                                       "      LEFT JOIN files ON"
-                                       "        files.idFile=episode.idFile "
-                                       "    GROUP BY tvshow.idShow");
-  m_pDS->exec(tvshowcounts);
-
   CLog::Log(LOGINFO, "create tvshow_view");
   std::string tvshowview = PrepareSQL("CREATE VIEW tvshow_view AS SELECT "
                                      "  tvshow.*,"
@@ -1644,26 +1781,50 @@ int CVideoDatabase::AddActor(const std::string& name, const std::string& thumbUR
 
 
 
-void CVideoDatabase::AddLinkToActor(int mediaId, const char *mediaType, int actorId, const std::string &role, int order)
+void CVideoDatabase::AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, int valueId, const char *foreignKey)
 {
-  std::string sql=PrepareSQL("SELECT 1 FROM actor_link WHERE actor_id=%i AND media_id=%i AND media_type='%s'", actorId, mediaId, mediaType);
+  const char *key = foreignKey ? foreignKey : table.c_str();
+  std::string sql = PrepareSQL("SELECT 1 FROM %s_link WHERE %s_id=%i AND media_id=%i AND media_type='%s'", table.c_str(), key, valueId, mediaId, mediaType.c_str());
 
   if (GetSingleValue(sql).empty())
   { // doesnt exists, add it
-    sql = PrepareSQL("INSERT INTO actor_link (actor_id, media_id, media_type, role, cast_order) VALUES(%i,%i,'%s','%s',%i)", actorId, mediaId, mediaType, role.c_str(), order);
+    sql = PrepareSQL("INSERT INTO %s_link (%s_id,media_id,media_type) VALUES(%i,%i,'%s')", table.c_str(), key, valueId, mediaId, mediaType.c_str());
     ExecuteQuery(sql);
   }
 }
 
-void CVideoDatabase::AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, int valueId, const char *foreignKey)
+void CVideoDatabase::AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, const std::vector<int>& valueIds, const char *foreignKey)
 {
+  if (valueIds.empty())
+    return;
+
   const char *key = foreignKey ? foreignKey : table.c_str();
-  std::string sql = PrepareSQL("SELECT 1 FROM %s_link WHERE %s_id=%i AND media_id=%i AND media_type='%s'", table.c_str(), key, valueId, mediaId, mediaType.c_str());
+  try
+  {
+    // fetch the values that are already linked, so we only need a single insert
+    std::set<int> linked;
+    std::string sql = PrepareSQL("SELECT %s_id FROM %s_link WHERE media_id=%i AND media_type='%s'", key, table.c_str(), mediaId, mediaType.c_str());
+    if (m_pDS->query(sql))
+    {
+      while (!m_pDS->eof())
+      {
+        linked.insert(m_pDS->fv(0).get_asInt());
+        m_pDS->next();
+      }
+      m_pDS->close();
+    }
 
-  if (GetSingleValue(sql).empty())
-  { // doesnt exists, add it
-    sql = PrepareSQL("INSERT INTO %s_link (%s_id,media_id,media_type) VALUES(%i,%i,'%s')", table.c_str(), key, valueId, mediaId, mediaType.c_str());
-    ExecuteQuery(sql);
+    std::vector<std::string> rows;
+    for (const auto &valueId : valueIds)
+    {
+      if (linked.insert(valueId).second)
+        rows.push_back(PrepareSQL("(%i,%i,'%s')", valueId, mediaId, mediaType.c_str()));
+    }
+    ExecuteBulkInsert(PrepareSQL("INSERT INTO %s_link (%s_id,media_id,media_type) VALUES ", table.c_str(), key), rows);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s, %i) failed", __FUNCTION__, table.c_str(), mediaId);
   }
 }
 
@@ -1677,15 +1838,17 @@ void CVideoDatabase::RemoveFromLinkTable(int mediaId, const std::string& mediaTy
 
 void CVideoDatabase::AddLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values)
 {
+  std::vector<int> valueIds;
   for (const auto &i : values)
   {
     if (!i.empty())
     {
       int idValue = AddToTable(field, field + "_id", "name", i);
       if (idValue > -1)
-        AddToLinkTable(mediaId, mediaType, field, idValue);
+        valueIds.push_back(idValue);
     }
   }
+  AddToLinkTable(mediaId, mediaType, field, valueIds);
 }
 
 void CVideoDatabase::UpdateLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values)
@@ -1698,15 +1861,17 @@ void CVideoDatabase::UpdateLinksToItem(int mediaId, const std::string& mediaType
 
 void CVideoDatabase::AddActorLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values)
 {
+  std::vector<int> actorIds;
   for (const auto &i : values)
   {
     if (!i.empty())
     {
       int idValue = AddActor(i, "");
       if (idValue > -1)
-        AddToLinkTable(mediaId, mediaType, field, idValue, "actor");
+        actorIds.push_back(idValue);
     }
   }
+  AddToLinkTable(mediaId, mediaType, field, actorIds, "actor");
 }
 
 void CVideoDatabase::UpdateActorLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values)
@@ -1748,11 +1913,35 @@ void CVideoDatabase::AddCast(int mediaId, const char *mediaType, const std::vect
   if (cast.empty())
     return;
 
-  int order = std::max_element(cast.begin(), cast.end())->order;
-  for (const auto &i : cast)
+  try
+  {
+    // fetch the actors that are already linked, so we only need a single insert
+    std::set<int> linked;
+    std::string sql = PrepareSQL("SELECT actor_id FROM actor_link WHERE media_id=%i AND media_type='%s'", mediaId, mediaType);
+    if (m_pDS->query(sql))
+    {
+      while (!m_pDS->eof())
+      {
+        linked.insert(m_pDS->fv(0).get_asInt());
+        m_pDS->next();
+      }
+      m_pDS->close();
+    }
+
+    std::vector<std::string> rows;
+    int order = std::max_element(cast.begin(), cast.end())->order;
+    for (const auto &i : cast)
+    {
+      int idActor = AddActor(i.strName, i.thumbUrl.m_xml, i.thumb);
+      int castOrder = i.order >= 0 ? i.order : ++order;
+      if (idActor > -1 && linked.insert(idActor).second)
+        rows.push_back(PrepareSQL("(%i,%i,'%s','%s',%i)", idActor, mediaId, mediaType, i.strRole.c_str(), castOrder));
+    }
+    ExecuteBulkInsert("INSERT INTO actor_link (actor_id, media_id, media_type, role, cast_order) VALUES ", rows);
+  }
+  catch (...)
   {
-    int idActor = AddActor(i.strName, i.thumbUrl.m_xml, i.thumb);
-    AddLinkToActor(mediaId, mediaType, idActor, i.strRole, i.order >= 0 ? i.order : ++order);
+    CLog::Log(LOGERROR, "%s (%i, %s) failed", __FUNCTION__, mediaId, mediaType);
   }
 }
 
@@ -4351,8 +4540,41 @@ void CVideoDatabase::SetVideoSettings(const std::string& strFilenameAndPath, con
 
 void CVideoDatabase::SetArtForItem(int mediaId, const MediaType &mediaType, const std::map<std::string, std::string> &art)
 {
-  for (const auto &i : art)
-    SetArtForItem(mediaId, mediaType, i.first, i.second);
+  try
+  {
+    if (NULL == m_pDB.get()) return;
+    if (NULL == m_pDS.get()) return;
+
+    // fetch the existing art in one go, update what changed and insert the rest at once
+    std::map<std::string, std::pair<int, std::string>> existing;
+    std::string sql = PrepareSQL("SELECT type,art_id,url FROM art WHERE media_id=%i AND media_type='%s'", mediaId, mediaType.c_str());
+    m_pDS->query(sql);
+    while (!m_pDS->eof())
+    {
+      existing[m_pDS->fv(0).get_asString()] = std::make_pair(m_pDS->fv(1).get_asInt(), m_pDS->fv(2).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    std::vector<std::string> rows;
+    for (const auto &i : art)
+    {
+      // don't set <foo>.<bar> art types - these are derivative types from parent items
+      if (i.first.find('.') != std::string::npos)
+        continue;
+
+      const auto it = existing.find(i.first);
+      if (it == existing.end())
+        rows.push_back(PrepareSQL("(%d, '%s', '%s', '%s')", mediaId, mediaType.c_str(), i.first.c_str(), i.second.c_str()));
+      else if (it->second.second != i.second)
+        m_pDS->exec(PrepareSQL("UPDATE art SET url='%s' where art_id=%d", i.second.c_str(), it->second.first));
+    }
+    ExecuteBulkInsert("INSERT INTO art(media_id, media_type, type, url) VALUES ", rows);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s(%d, '%s') failed", __FUNCTION__, mediaId, mediaType.c_str());
+  }
 }
 
 void CVideoDatabase::SetArtForItem(int mediaId, const MediaType &mediaType, const std::string &artType, const std::string &url)
@@ -5240,11 +5462,22 @@ void CVideoDatabase::UpdateTables(int iVersion)
       pDS->close();
     }
   }
+
+  if (iVersion < 109)
+  {
+    // counts are kept up to date by triggers instead of being computed on every query
+    m_pDS->exec("CREATE TABLE tvshowcounts (idShow INTEGER PRIMARY KEY, lastPlayed TEXT, totalCount INTEGER, watchedcount INTEGER, totalSeasons INTEGER, dateAdded TEXT)");
+    m_pDS->exec(GetShowCountsSQL("1=1"));
+
+    m_pDS->exec("CREATE TABLE linkcounts (link_type TEXT, link_id INTEGER, media_type TEXT, total INTEGER, watched INTEGER)");
+    for (const auto &link : LinkCountTables)
+      m_pDS->exec(GetLinkCountsSQL(link.table, link.foreignkey, "1=1"));
+  }
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 108;
+  return 109;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -5575,6 +5808,21 @@ bool CVideoDatabase::GetStudiosNav(const std::string& strBaseDir, CFileItemList&
   return GetNavCommon(strBaseDir, items, "studio", idContent, filter, countOnly);
 }
 
+bool CVideoDatabase::IsUnfilteredNav(const std::string &strBaseDir, const Filter &filter)
+{
+  if (!filter.where.empty() || !filter.join.empty() || !filter.group.empty())
+    return false;
+
+  // check for any conditions on the items given by the path (e.g. a year or an xsp)
+  CVideoDbUrl videoUrl;
+  Filter urlFilter;
+  SortDescription sorting;
+  if (!videoUrl.FromString(strBaseDir) || !GetFilter(videoUrl, urlFilter, sorting))
+    return false;
+
+  return urlFilter.where.empty() && urlFilter.join.empty();
+}
+
 bool CVideoDatabase::GetNavCommon(const std::string& strBaseDir, CFileItemList& items, const char *type, int idContent /* = -1 */, const Filter &filter /* = Filter() */, bool countOnly /* = false */)
 {
   try
@@ -5652,12 +5900,23 @@ bool CVideoDatabase::GetNavCommon(const std::string& strBaseDir, CFileItemList&
 
       strSQL = "SELECT %s " + PrepareSQL("FROM %s ", type);
       extFilter.fields = PrepareSQL("%s.%s_id, %s.name", type, type, type);
-      extFilter.AppendField(extraField);
-      extFilter.AppendJoin(PrepareSQL("JOIN %s_link ON %s.%s_id = %s_link.%s_id", type, type, type, type, type));
-      extFilter.AppendJoin(PrepareSQL("JOIN %s_view ON %s_link.media_id = %s_view.%s AND %s_link.media_type='%s'",
-                                      view.c_str(), type, view.c_str(), view_id.c_str(), type, media_type.c_str()));
-      extFilter.AppendJoin(extraJoin);
-      extFilter.AppendGroup(PrepareSQL("%s.%s_id", type, type));
+      if (IsUnfilteredNav(strBaseDir, filter))
+      {
+        // the number of linked items is kept up to date in linkcounts
+        if (!extraField.empty())
+          extFilter.AppendField("linkcounts.total, linkcounts.watched");
+        extFilter.AppendJoin(PrepareSQL("JOIN linkcounts ON linkcounts.link_type='%s' AND linkcounts.media_type='%s' AND linkcounts.link_id = %s.%s_id AND linkcounts.total > 0",
+                                        type, media_type.c_str(), type, type));
+      }
+      else
+      {
+        extFilter.AppendField(extraField);
+        extFilter.AppendJoin(PrepareSQL("JOIN %s_link ON %s.%s_id = %s_link.%s_id", type, type, type, type, type));
+        extFilter.AppendJoin(PrepareSQL("JOIN %s_view ON %s_link.media_id = %s_view.%s AND %s_link.media_type='%s'",
+                                        view.c_str(), type, view.c_str(), view_id.c_str(), type, media_type.c_str()));
+        extFilter.AppendJoin(extraJoin);
+        extFilter.AppendGroup(PrepareSQL("%s.%s_id", type, type));
+      }
     }
 
     if (countOnly)
@@ -6073,11 +6332,21 @@ bool CVideoDatabase::GetPeopleNav(const std::string& strBaseDir, CFileItemList&
 
       strSQL ="SELECT %s FROM actor ";
       extFilter.fields = "actor.actor_id, actor.name, actor.art_urls";
-      extFilter.AppendField(extraField);
-      extFilter.AppendJoin(PrepareSQL("JOIN %s_link on actor.actor_id = %s_link.actor_id", type, type));
-      extFilter.AppendJoin(PrepareSQL("JOIN %s_view on %s_link.media_id = %s_view.%s AND %s_link.media_type='%s'", view.c_str(), type, view.c_str(), view_id.c_str(), type, media_type.c_str()));
-      extFilter.AppendJoin(extraJoin);
-      extFilter.AppendGroup("actor.actor_id");
+      if (!countOnly && IsUnfilteredNav(strBaseDir, filter))
+      {
+        // the number of linked items is kept up to date in linkcounts
+        extFilter.AppendField(idContent == VIDEODB_CONTENT_TVSHOWS ? "linkcounts.total" : "linkcounts.total, linkcounts.watched");
+        extFilter.AppendJoin(PrepareSQL("JOIN linkcounts ON linkcounts.link_type='%s' AND linkcounts.media_type='%s' AND linkcounts.link_id = actor.actor_id AND linkcounts.total > 0",
+                                        type, media_type.c_str()));
+      }
+      else
+      {
+        extFilter.AppendField(extraField);
+        extFilter.AppendJoin(PrepareSQL("JOIN %s_link on actor.actor_id = %s_link.actor_id", type, type));
+        extFilter.AppendJoin(PrepareSQL("JOIN %s_view on %s_link.media_id = %s_view.%s AND %s_link.media_type='%s'", view.c_str(), type, view.c_str(), view_id.c_str(), type, media_type.c_str()));
+        extFilter.AppendJoin(extraJoin);
+        extFilter.AppendGroup("actor.actor_id");
+      }
     }
 
     if (countOnly)
@@ -9589,9 +9858,13 @@ bool CVideoDatabase::CommitTransaction()
 {
   if (CDatabase::CommitTransaction())
   { // number of items in the db has likely changed, so recalculate
-    g_infoManager.SetLibraryBool(LIBRARY_HAS_MOVIES, HasContent(VIDEODB_CONTENT_MOVIES));
-    g_infoManager.SetLibraryBool(LIBRARY_HAS_TVSHOWS, HasContent(VIDEODB_CONTENT_TVSHOWS));
-    g_infoManager.SetLibraryBool(LIBRARY_HAS_MUSICVIDEOS, HasContent(VIDEODB_CONTENT_MUSICVIDEOS));
+    // (unless this only finished an item within a batch transaction)
+    if (!InTransaction())
+    {
+      g_infoManager.SetLibraryBool(LIBRARY_HAS_MOVIES, HasContent(VIDEODB_CONTENT_MOVIES));
+      g_infoManager.SetLibraryBool(LIBRARY_HAS_TVSHOWS, HasContent(VIDEODB_CONTENT_TVSHOWS));
+      g_infoManager.SetLibraryBool(LIBRARY_HAS_MUSICVIDEOS, HasContent(VIDEODB_CONTENT_MUSICVIDEOS));
+    }
     return true;
   }
   return false;
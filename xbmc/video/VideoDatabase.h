@@ -895,9 +895,9 @@ protected:
    */
   int GetMatchingTvShow(const CVideoInfoTag &show);
 
-  // link functions - these two do all the work
-  void AddLinkToActor(int mediaId, const char *mediaType, int actorId, const std::string &role, int order);
+  // link functions - these do all the work
   void AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, int valueId, const char *foreignKey = NULL);
+  void AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, const std::vector<int>& valueIds, const char *foreignKey = NULL);
   void RemoveFromLinkTable(int mediaId, const std::string& mediaType, const std::string& table, int valueId, const char *foreignKey = NULL);
 
   void AddLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values);
@@ -934,6 +934,26 @@ private:
   void CreateLinkIndex(const char *table);
   void CreateForeignLinkIndex(const char *table, const char *foreignkey);
 
+  /*! \brief Get the SQL recomputing the rows of the tvshowcounts table
+   \param condition restricts the tvshows to recompute, e.g. "tvshow.idShow=new.idShow"
+   */
+  std::string GetShowCountsSQL(const std::string &condition) const;
+
+  /*! \brief Get the SQL recomputing the rows of the linkcounts table for a link table, the
+     triggers update the rows incrementally
+   \param table the link table is <table>_link
+   \param foreignkey the id column of the link table is <foreignkey>_id
+   \param condition restricts the links to recompute, the link table is aliased as lnk
+   */
+  std::string GetLinkCountsSQL(const char *table, const char *foreignkey, const std::string &condition) const;
+
+  /*! \brief Whether a navigation listing needs the counts of all items, so it can use
+     the linkcounts table instead of counting the linked items of every entry.
+   \param strBaseDir the videodb:// path of the listing
+   \param filter additional filter of the listing
+   */
+  bool IsUnfilteredNav(const std::string &strBaseDir, const Filter &filter);
+
   /*! \brief (Re)Create the generic database views for movies, tvshows,
      episodes and music videos
    */
@@ -23,6 +23,7 @@
 #include <utility>
 
 #include "ServiceBroker.h"
+#include "DatabaseManager.h"
 #include "dialogs/GUIDialogExtendedProgressBar.h"
 #include "dialogs/GUIDialogProgress.h"
 #include "events/EventLog.h"
@@ -113,8 +114,13 @@ namespace VIDEO
       }
 
       unsigned int tick = XbmcThreads::SystemClockMillis();
+      unsigned int lockWaits, lockWaitTime, maxLockWait;
+      CDatabaseManager::GetInstance().GetLockWaits(lockWaits, lockWaitTime, maxLockWait);
 
       m_database.Open();
+      // group the writes of the scanned items into larger transactions, they
+      // are committed before every online lookup
+      m_database.BeginBatch(g_advancedSettings.m_iVideoLibraryScanBatchSize);
 
       m_bCanInterrupt = true;
 
@@ -158,6 +164,9 @@ namespace VIDEO
           bCancelled = true;
       }
 
+      // cleaning and compressing need the scanned items committed
+      m_database.EndBatch();
+
       if (!bCancelled)
       {
         if (m_bClean)
@@ -170,15 +179,24 @@ namespace VIDEO
         }
       }
 
+      // keep the write-ahead log from growing with every scan
+      m_database.Checkpoint(true);
+
       g_infoManager.ResetLibraryBools();
       m_database.Close();
 
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGNOTICE, "VideoInfoScanner: Finished scan. Scanning for video info took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
+
+      unsigned int waits, waitTime;
+      CDatabaseManager::GetInstance().GetLockWaits(waits, waitTime, maxLockWait);
+      CLog::Log(LOGDEBUG, "VideoInfoScanner: %u database lock waits taking %u ms during scan, longest wait since startup %u ms",
+                waits - lockWaits, waitTime - lockWaitTime, maxLockWait);
     }
     catch (...)
     {
       CLog::Log(LOGERROR, "VideoInfoScanner: Exception while scanning.");
+      m_database.EndBatch();
     }
     
     m_bRunning = false;
@@ -732,6 +750,7 @@ namespace VIDEO
 
       if (updateSeasonArt)
       {
+        m_database.FlushBatch();
         CVideoInfoDownloader loader(scraper);
         loader.GetArtwork(showInfo);
         GetSeasonThumbs(showInfo, seasonArt, CVideoThumbLoader::GetArtTypes(MediaTypeSeason), useLocal);
@@ -1290,6 +1309,7 @@ namespace VIDEO
         movieDetails.GetResumePoint().IsSet())
       m_database.AddBookMarkToFile(pItem->GetPath(), movieDetails.GetResumePoint(), CBookmark::RESUME);
 
+    m_database.BatchItemDone();
     m_database.Close();
 
     CFileItemPtr itemCopy = CFileItemPtr(new CFileItem(*pItem));
@@ -1522,6 +1542,7 @@ namespace VIDEO
             pDlgProgress->Progress();
           }
 
+          m_database.FlushBatch();
           CVideoInfoDownloader imdb(scraper);
           if (!imdb.GetEpisodeList(url, episodes))
             return INFO_NOT_FOUND;
@@ -1620,6 +1641,7 @@ namespace VIDEO
 
       if (bFound)
       {
+        m_database.FlushBatch();
         CVideoInfoDownloader imdb(scraper);
         CFileItem item;
         item.SetPath(file->strPath);
@@ -1762,6 +1784,8 @@ namespace VIDEO
     if (m_handle && !url.strTitle.empty())
       m_handle->SetText(url.strTitle);
 
+    // the batched writes must not hold the database locked during online lookups
+    m_database.FlushBatch();
     CVideoInfoDownloader imdb(scraper);
     bool ret = imdb.GetDetails(url, movieDetails, pDialog);
 
@@ -2101,6 +2125,7 @@ namespace VIDEO
   int CVideoInfoScanner::FindVideo(const std::string &videoName, const ScraperPtr &scraper, CScraperUrl &url, CGUIDialogProgress *progress)
   {
     MOVIELIST movielist;
+    m_database.FlushBatch();
     CVideoInfoDownloader imdb(scraper);
     int returncode = imdb.FindMovie(videoName, movielist, progress);
     if (returncode < 0 || (returncode == 0 && (m_bStop || !DownloadFailed(progress))))
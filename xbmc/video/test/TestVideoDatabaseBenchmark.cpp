@@ -0,0 +1,310 @@
+/*
+ *      Copyright (C) 2018 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FileItem.h"
+#include "settings/AdvancedSettings.h"
+#include "test/LibraryBenchmark.h"
+#include "utils/StringUtils.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoDbUrl.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+// library size at --set-benchmark-scale 1.0
+const unsigned int FULL_MOVIES = 100000;
+const unsigned int FULL_TVSHOWS = 2000;
+const unsigned int FULL_ACTORS = 50000;
+const unsigned int FULL_DIRECTORS = 10000;
+
+const unsigned int SEASONS_PER_SHOW = 5;
+const unsigned int EPISODES_PER_SEASON = 10;
+const unsigned int CAST_PER_ITEM = 10;
+const unsigned int GENRES = 40;
+const unsigned int COUNTRIES = 30;
+const unsigned int STUDIOS = 500;
+const unsigned int TAGS = 100;
+
+class CRandom
+{
+public:
+  explicit CRandom(unsigned int seed) : m_seed(seed) {}
+  unsigned int Next(unsigned int range)
+  {
+    m_seed = m_seed * 1103515245 + 12345;
+    return (m_seed >> 16) % range;
+  }
+
+private:
+  unsigned int m_seed;
+};
+
+std::vector<std::string> Pick(CRandom &random, const char *format, unsigned int range, unsigned int count)
+{
+  std::vector<std::string> values;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    std::string value = StringUtils::Format(format, random.Next(range) + 1);
+    if (std::find(values.begin(), values.end(), value) == values.end())
+      values.push_back(value);
+  }
+  return values;
+}
+
+std::vector<SActorInfo> PickCast(CRandom &random, unsigned int actors)
+{
+  std::vector<SActorInfo> cast;
+  std::vector<std::string> names = Pick(random, "Actor %u", actors, CAST_PER_ITEM);
+  for (const auto &name : names)
+  {
+    SActorInfo actor;
+    actor.strName = name;
+    actor.strRole = "Role " + name;
+    actor.order = static_cast<int>(cast.size());
+    cast.push_back(actor);
+  }
+  return cast;
+}
+
+std::string GetMoviesUrl(const std::string &option, const std::string &value)
+{
+  CVideoDbUrl url;
+  url.FromString("videodb://movies/titles/");
+  url.AddOption(option, value);
+  return url.ToString();
+}
+}
+
+class TestVideoDatabaseBenchmark : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    m_benchmark.reset(new CLibraryBenchmark("videodatabase"));
+    m_database.reset(new CVideoDatabase());
+    if (!CLibraryBenchmark::CreateDatabase(*m_database, "MyVideosBenchmark"))
+    {
+      m_database.reset();
+      return;
+    }
+
+    const unsigned int movies = CLibraryBenchmark::Scaled(FULL_MOVIES);
+    const unsigned int tvshows = CLibraryBenchmark::Scaled(FULL_TVSHOWS);
+    const unsigned int actors = CLibraryBenchmark::Scaled(FULL_ACTORS);
+    const unsigned int directors = CLibraryBenchmark::Scaled(FULL_DIRECTORS);
+    m_benchmark->SetInfo("version", m_database->GetSingleValue("version", "idVersion"));
+    m_benchmark->SetInfo("movies", movies);
+    m_benchmark->SetInfo("tvshows", tvshows);
+    m_benchmark->SetInfo("episodes", tvshows * SEASONS_PER_SHOW * EPISODES_PER_SEASON);
+
+    // the scan-time insert paths, batched the same way the scanner does
+    CRandom random(42);
+    m_benchmark->Measure("SetDetailsForMovie", 1, [&]()
+    {
+      m_database->BeginBatch(g_advancedSettings.m_iVideoLibraryScanBatchSize);
+      for (unsigned int i = 0; i < movies; i++)
+      {
+        CVideoInfoTag details;
+        details.SetTitle(StringUtils::Format("Movie %u", i + 1));
+        details.SetPlot("A synthetic movie to benchmark the video library with.");
+        details.SetYear(1950 + random.Next(68));
+        details.SetRating(random.Next(100) / 10.0f, random.Next(10000), "themoviedb", true);
+        details.SetGenre(Pick(random, "Genre %u", GENRES, 2));
+        details.SetCountry(Pick(random, "Country %u", COUNTRIES, 1));
+        details.SetStudio(Pick(random, "Studio %u", STUDIOS, 1));
+        details.SetTags(Pick(random, "Tag %u", TAGS, 1));
+        details.SetDirector(Pick(random, "Director %u", directors, 1));
+        details.SetWritingCredits(Pick(random, "Director %u", directors, 2));
+        details.m_cast = PickCast(random, actors);
+        if (random.Next(20) == 0)
+          details.SetSet(StringUtils::Format("Collection %u", random.Next(movies / 20 + 1) + 1));
+
+        std::string path = StringUtils::Format("/media/movies/%u/Movie %u.mkv", i / 1000, i + 1);
+        if (m_database->SetDetailsForMovie(path, details, std::map<std::string, std::string>()) < 0)
+          return -1;
+        m_database->BatchItemDone();
+      }
+      return m_database->EndBatch() ? static_cast<int>(movies) : -1;
+    });
+
+    m_benchmark->Measure("SetDetailsForEpisode", 1, [&]()
+    {
+      int episodes = 0;
+      m_database->BeginBatch(g_advancedSettings.m_iVideoLibraryScanBatchSize);
+      for (unsigned int i = 0; i < tvshows; i++)
+      {
+        std::string path = StringUtils::Format("/media/tvshows/Show %u/", i + 1);
+        CVideoInfoTag show;
+        show.SetTitle(StringUtils::Format("Show %u", i + 1));
+        show.SetPath(path);
+        show.SetYear(1960 + random.Next(58));
+        show.SetGenre(Pick(random, "Genre %u", GENRES, 2));
+        show.SetStudio(Pick(random, "Studio %u", STUDIOS, 1));
+        show.m_cast = PickCast(random, actors);
+
+        std::map<int, std::map<std::string, std::string>> seasons;
+        for (unsigned int season = 1; season <= SEASONS_PER_SHOW; season++)
+          seasons[season] = std::map<std::string, std::string>();
+
+        std::vector<std::pair<std::string, std::string>> paths;
+        paths.push_back(std::make_pair(path, "/media/tvshows/"));
+        int idShow = m_database->SetDetailsForTvShow(paths, show, std::map<std::string, std::string>(), seasons);
+        if (idShow < 0)
+          return -1;
+
+        for (unsigned int season = 1; season <= SEASONS_PER_SHOW; season++)
+        {
+          for (unsigned int episode = 1; episode <= EPISODES_PER_SEASON; episode++)
+          {
+            CVideoInfoTag details;
+            details.SetTitle(StringUtils::Format("Episode %u", episode));
+            details.SetShowTitle(show.m_strTitle);
+            details.m_iSeason = season;
+            details.m_iEpisode = episode;
+            details.SetDirector(Pick(random, "Director %u", directors, 1));
+            details.m_cast = PickCast(random, actors);
+
+            std::string file = StringUtils::Format("%sS%02uE%02u.mkv", path.c_str(), season, episode);
+            if (m_database->SetDetailsForEpisode(file, details, std::map<std::string, std::string>(), idShow) < 0)
+              return -1;
+            episodes++;
+          }
+        }
+        m_database->BatchItemDone();
+      }
+      return m_database->EndBatch() ? episodes : -1;
+    });
+
+    // roughly a third of the library has been watched
+    m_database->ExecuteQuery("UPDATE files SET playCount = 1, lastPlayed = '2018-01-01 20:00:00' WHERE idFile % 3 = 0");
+    m_database->Checkpoint(true);
+  }
+
+  static void TearDownTestCase()
+  {
+    if (m_database)
+      m_database->Close();
+    m_database.reset();
+
+    EXPECT_TRUE(m_benchmark->Write());
+    m_benchmark.reset();
+  }
+
+  static std::unique_ptr<CVideoDatabase> m_database;
+  static std::unique_ptr<CLibraryBenchmark> m_benchmark;
+};
+
+std::unique_ptr<CVideoDatabase> TestVideoDatabaseBenchmark::m_database;
+std::unique_ptr<CLibraryBenchmark> TestVideoDatabaseBenchmark::m_benchmark;
+
+TEST_F(TestVideoDatabaseBenchmark, DISABLED_GetMoviesByWhere)
+{
+  ASSERT_TRUE(m_database != nullptr);
+
+  const struct
+  {
+    const char *name;
+    std::string url;
+  } queries[] = {
+    { "GetMoviesByWhere", "videodb://movies/titles/" },
+    { "GetMoviesByWhere/genre", GetMoviesUrl("genre", "Genre 3") },
+    { "GetMoviesByWhere/year", GetMoviesUrl("year", "1990") },
+    { "GetMoviesByWhere/actor", GetMoviesUrl("actor", "Actor 7") },
+    { "GetMoviesByWhere/tag", GetMoviesUrl("tag", "Tag 5") },
+  };
+
+  for (const auto &query : queries)
+  {
+    EXPECT_TRUE(m_benchmark->Measure(query.name, 5, [&]()
+    {
+      CFileItemList items;
+      return m_database->GetMoviesByWhere(query.url, CDatabase::Filter(), items) ? items.Size() : -1;
+    }));
+  }
+
+  // the way JSON-RPC and the web interfaces page through the library
+  EXPECT_TRUE(m_benchmark->Measure("GetMoviesByWhere/paged", 5, [&]()
+  {
+    SortDescription sorting;
+    sorting.sortBy = SortByRating;
+    sorting.sortOrder = SortOrderDescending;
+    sorting.limitStart = CLibraryBenchmark::Scaled(FULL_MOVIES) / 2;
+    sorting.limitEnd = sorting.limitStart + 50;
+
+    CFileItemList items;
+    return m_database->GetMoviesByWhere("videodb://movies/titles/", CDatabase::Filter(), items, sorting, VideoDbDetailsAll) ? items.Size() : -1;
+  }));
+}
+
+TEST_F(TestVideoDatabaseBenchmark, DISABLED_SmartPlaylist)
+{
+  ASSERT_TRUE(m_database != nullptr);
+
+  std::string url = GetMoviesUrl("xsp",
+    "{\"type\":\"movies\",\"rules\":{\"and\":["
+    "{\"field\":\"genre\",\"operator\":\"is\",\"value\":[\"Genre 3\",\"Genre 4\"]},"
+    "{\"field\":\"year\",\"operator\":\"greaterthan\",\"value\":[\"1990\"]},"
+    "{\"field\":\"playcount\",\"operator\":\"is\",\"value\":[\"0\"]}]}}");
+
+  EXPECT_TRUE(m_benchmark->Measure("SmartPlaylist/movies", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetMoviesByWhere(url, CDatabase::Filter(), items) ? items.Size() : -1;
+  }));
+}
+
+TEST_F(TestVideoDatabaseBenchmark, DISABLED_Navigation)
+{
+  ASSERT_TRUE(m_database != nullptr);
+
+  EXPECT_TRUE(m_benchmark->Measure("GetTvShowsNav", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetTvShowsNav("videodb://tvshows/titles/", items) ? items.Size() : -1;
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("GetSeasonsNav", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetSeasonsNav("videodb://tvshows/titles/1/", items, -1, -1, -1, -1, 1) ? items.Size() : -1;
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("GetEpisodesByWhere", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetEpisodesByWhere("videodb://tvshows/titles/1/-1/", CDatabase::Filter(), items) ? items.Size() : -1;
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("GetGenresNav/movies", 5, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetGenresNav("videodb://movies/genres/", items, VIDEODB_CONTENT_MOVIES) ? items.Size() : -1;
+  }));
+
+  EXPECT_TRUE(m_benchmark->Measure("GetActorsNav/movies", 3, [&]()
+  {
+    CFileItemList items;
+    return m_database->GetActorsNav("videodb://movies/actors/", items, VIDEODB_CONTENT_MOVIES) ? items.Size() : -1;
+  }));
+}
@@ -22,6 +22,7 @@
 #include "settings/AdvancedSettings.h"
 #include "addons/Skin.h"
 #include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 #include "CompileInfo.h"
 #include "filesystem/SpecialProtocol.h"
@@ -32,6 +33,7 @@
 #include "guilib/GUIWindowManager.h"
 #include "guilib/GUIControlProfiler.h"
 #include "GUIInfoManager.h"
+#include "windowing/WindowingFactory.h"
 #include "utils/Variant.h"
 #include "utils/StringUtils.h"
 
@@ -120,6 +122,25 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
                                 stat.ullAvailPhys/1024, stat.ullTotalPhys/1024, g_infoManager.GetFPS(),
                                 strCores.c_str(), ucAppName.c_str(), dCPU, profiling.c_str());
 #endif
+
+    unsigned int drawCalls, quads, stateChanges;
+    g_Windowing.GetDrawStats(drawCalls, quads, stateChanges);
+    if (drawCalls)
+      info += StringUtils::Format("\nGPU: %u draw calls, %u quads, %u state changes", drawCalls, quads, stateChanges);
+
+    CJobManager &jobManager = CJobManager::GetInstance();
+    CJobManager::QueueStats jobs;
+    for (int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; priority++)
+    {
+      CJobManager::QueueStats stats = jobManager.GetQueueStats(static_cast<CJob::PRIORITY>(priority));
+      jobs.queued += stats.queued;
+      jobs.processing += stats.processing;
+      jobs.started += stats.started;
+      jobs.totalWaitMs += stats.totalWaitMs;
+    }
+    info += StringUtils::Format("\nJOBS: %u workers, %u running, %u queued, %.1f ms average wait",
+                                jobManager.GetWorkerCount(), jobs.processing, jobs.queued,
+                                jobs.started ? jobs.totalWaitMs / jobs.started : 0.0);
   }
 
   // render the skin debug info